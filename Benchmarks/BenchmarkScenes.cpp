@@ -0,0 +1,141 @@
+#include "BenchmarkScenes.hpp"
+
+#include <cstdlib>
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+namespace RoboPioneers::Prometheus::Benchmarks
+{
+	namespace
+	{
+		/// 按照控制器的格式读取参数
+		SceneParameters LoadParameters(const boost::filesystem::path& path)
+		{
+			SceneParameters parameters;
+			if (!boost::filesystem::exists(path)) return parameters;
+
+			boost::property_tree::ptree json_node;
+			boost::property_tree::read_json(path.string(), json_node);
+
+			const auto* color_name = std::getenv("PROMETHEUS_BENCHMARK_COLOR");
+			const std::string mask = std::string("Mask.") + (color_name ? color_name : "Blue");
+
+			parameters.MinHue = json_node.get<int>(mask + ".Hue.Min");
+			parameters.MaxHue = json_node.get<int>(mask + ".Hue.Max");
+			parameters.MinSaturation = json_node.get<int>(mask + ".Saturation.Min");
+			parameters.MaxSaturation = json_node.get<int>(mask + ".Saturation.Max");
+			parameters.MinValue = json_node.get<int>(mask + ".Value.Min");
+			parameters.MaxValue = json_node.get<int>(mask + ".Value.Max");
+
+			parameters.MinArea = json_node.get<int>("LightBar.MinArea");
+			parameters.MinFillingRatio = json_node.get<int>("LightBar.MinFillingRatio");
+
+			return parameters;
+		}
+	}
+
+	/// 加载录制的场景
+	std::vector<BenchmarkScene> LoadRecordedScenes()
+	{
+		std::vector<BenchmarkScene> scenes;
+
+		const auto* corpus_path = std::getenv("PROMETHEUS_BENCHMARK_CORPUS");
+		if (!corpus_path || !boost::filesystem::is_directory(corpus_path)) return scenes;
+
+		const auto parameters = LoadParameters(boost::filesystem::path(corpus_path) / "Settings.json");
+
+		std::vector<boost::filesystem::path> paths;
+		for (const auto& entry : boost::filesystem::directory_iterator(corpus_path))
+		{
+			auto extension = entry.path().extension().string();
+			if (extension == ".png" || extension == ".bmp" || extension == ".jpg" || extension == ".tiff")
+			{
+				paths.push_back(entry.path());
+			}
+		}
+		// 按照文件名排序，使测试名称在多次运行之间保持稳定
+		std::sort(paths.begin(), paths.end());
+
+		for (const auto& path : paths)
+		{
+			auto picture = cv::imread(path.string(), cv::IMREAD_UNCHANGED);
+			if (picture.empty()) continue;
+
+			BenchmarkScene scene;
+			scene.Name = "Recorded:" + path.stem().string();
+			scene.Parameters = parameters;
+			if (picture.channels() == 1)
+			{
+				cv::cvtColor(picture, scene.Picture, cv::COLOR_BayerBG2BGR);
+			}
+			else
+			{
+				scene.Picture = picture;
+			}
+			scenes.push_back(std::move(scene));
+		}
+
+		return scenes;
+	}
+
+	/// 生成合成场景
+	BenchmarkScene MakeSyntheticScene(const cv::Size& size, int armor_count, int distractor_count,
+								   int noise_speck_count, int motion_blur_length, unsigned int seed)
+	{
+		using Simulation::SceneGenerator;
+
+		BenchmarkScene scene;
+		scene.Name = "Synthetic:" + std::to_string(armor_count) + "A" + std::to_string(distractor_count) + "D" +
+			std::to_string(noise_speck_count) + "N" + std::to_string(motion_blur_length) + "B";
+
+		auto description = SceneGenerator::MakeRandomDescription(size, armor_count, 0.25, distractor_count,
+															noise_speck_count, seed);
+		description.MotionBlurLength = motion_blur_length;
+
+		SceneGenerator generator;
+		Simulation::GroundTruth truth;
+		cv::Mat bayer_picture;
+		generator.RenderBayer(description, truth, bayer_picture);
+
+		// 经过与相机数据相同的Bayer转换，使颜色边缘与实际图像一致
+		cv::cvtColor(bayer_picture, scene.Picture, cv::COLOR_BayerBG2BGR);
+
+		return scene;
+	}
+
+	/// 构造并配置各阶段
+	StageSet::StageSet(const BenchmarkScene& scene)
+	{
+		const auto& parameters = scene.Parameters;
+
+		ColorStage.MinHue = parameters.MinHue;
+		ColorStage.MaxHue = parameters.MaxHue;
+		ColorStage.MinSaturation = parameters.MinSaturation;
+		ColorStage.MaxSaturation = parameters.MaxSaturation;
+		ColorStage.MinValue = parameters.MinValue;
+		ColorStage.MaxValue = parameters.MaxValue;
+		ColorStage.Reserve(scene.Picture.size());
+
+		LightBarStage.MinArea = parameters.MinArea;
+		LightBarStage.MinFillingRatio = parameters.MinFillingRatio;
+
+		RecommendStage.ScreenWidth = scene.Picture.cols;
+		RecommendStage.ScreenHeight = scene.Picture.rows;
+	}
+
+	/// 准备帧
+	void StageSet::Prepare(Core::Frame& frame, const BenchmarkScene& scene, int until_stage)
+	{
+		frame.Reserve(scene.Picture.size(), false);
+		scene.Picture.copyTo(frame.OriginalPicture);
+		frame.CuttingPicture = frame.OriginalPicture;
+		frame.PositionOffset = cv::Point(0, 0);
+
+		if (until_stage >= 1) ColorStage.Execute(frame);
+		if (until_stage >= 2) LightBarStage.Execute(frame);
+		if (until_stage >= 3) ArmorStage.Execute(frame);
+		if (until_stage >= 4) RecommendStage.Execute(frame);
+	}
+}
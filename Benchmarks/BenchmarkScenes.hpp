@@ -0,0 +1,112 @@
+#pragma once
+
+#include <Core/PrometheusCoreCPU.hpp>
+#include <System/Stages/CuttingChooser.hpp>
+#include <Simulation/PrometheusSimulation.hpp>
+
+#include <string>
+#include <vector>
+#include <opencv4/opencv2/opencv.hpp>
+
+namespace RoboPioneers::Prometheus::Benchmarks
+{
+	/**
+	 * @brief 场景参数
+	 * @details
+	 *  ~ 与Settings.json中的同名项含义一致，默认值与合成场景的颜色相匹配。
+	 */
+	struct SceneParameters
+	{
+		/// 色调下界
+		int MinHue {90};
+		/// 色调上界
+		int MaxHue {130};
+		/// 饱和度下界
+		int MinSaturation {80};
+		/// 饱和度上界
+		int MaxSaturation {255};
+		/// 亮度下界
+		int MinValue {120};
+		/// 亮度上界
+		int MaxValue {255};
+
+		/// 灯条最小面积
+		int MinArea {20};
+		/// 灯条最小填充率
+		int MinFillingRatio {50};
+	};
+
+	/**
+	 * @brief 测试场景
+	 * @details
+	 *  ~ 场景图像为BGR格式，尺寸即为全屏尺寸。
+	 */
+	struct BenchmarkScene
+	{
+		/// 场景名称，用于性能测试的命名
+		std::string Name;
+		/// 场景图像
+		cv::Mat Picture;
+		/// 场景参数
+		SceneParameters Parameters;
+	};
+
+	/**
+	 * @brief 加载录制的场景
+	 * @return 场景列表，未设置录制目录时为空
+	 * @details
+	 *  ~ 录制目录由环境变量PROMETHEUS_BENCHMARK_CORPUS指定，目录下的所有图像文件均被视为一帧；
+	 *    单通道图像被视为BayerBG格式的原始图像。
+	 *  ~ 若目录下存在Settings.json，则以与控制器相同的格式读取其中的参数，
+	 *    敌方颜色由环境变量PROMETHEUS_BENCHMARK_COLOR指定，取值为Red或Blue，默认为Blue。
+	 */
+	std::vector<BenchmarkScene> LoadRecordedScenes();
+
+	/**
+	 * @brief 生成合成场景
+	 * @param size 图像尺寸
+	 * @param armor_count 装甲板数量，其中约四分之一为大装甲板
+	 * @param distractor_count 干扰灯条数量
+	 * @param noise_speck_count 噪点数量
+	 * @param motion_blur_length 运动模糊长度，单位为像素
+	 * @param seed 随机数种子
+	 * @return 场景，由场景生成器生成BayerBG原始图像后再转换为BGR图像
+	 */
+	BenchmarkScene MakeSyntheticScene(const cv::Size& size, int armor_count, int distractor_count,
+								   int noise_speck_count, int motion_blur_length, unsigned int seed);
+
+	/**
+	 * @brief 阶段集合
+	 * @author Vincent
+	 * @details
+	 *  ~ 持有按照场景参数配置好的各处理阶段，并负责为性能测试准备帧。
+	 */
+	class StageSet
+	{
+	public:
+		/// 颜色过滤阶段
+		Core::CPUColorFilter ColorStage;
+		/// 灯条检测阶段
+		Core::LightBarDetector LightBarStage;
+		/// 装甲板匹配阶段
+		Core::ArmorMatcher ArmorStage;
+		/// 装甲板选择阶段
+		Core::ArmorSelector RecommendStage;
+		/// 裁剪选择阶段
+		CuttingChooser CuttingStage;
+
+		/**
+		 * @brief 按照场景构造并配置各阶段
+		 * @param scene 场景
+		 */
+		explicit StageSet(const BenchmarkScene& scene);
+
+		/**
+		 * @brief 准备帧
+		 * @param frame 帧
+		 * @param scene 场景
+		 * @param until_stage 执行到的阶段数：0为仅拷贝图像，1至4依次为颜色过滤、灯条检测、装甲板匹配、装甲板选择
+		 */
+		void Prepare(Core::Frame& frame, const BenchmarkScene& scene, int until_stage);
+	};
+}
@@ -0,0 +1,125 @@
+#include "CRCBenchmarks.hpp"
+
+#include <SerialPortUtilities/CRCTool.hpp>
+#include <SerialPortUtilities/CRCGenerator.hpp>
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace RoboPioneers::Prometheus::Benchmarks
+{
+	using SerialPort::Utilities::CRCTool;
+	using SerialPort::Utilities::CRC8Model;
+	using SerialPort::Utilities::CRC16Model;
+	using SerialPort::Utilities::CRC32CModel;
+
+	/// 生成随机测试数据
+	std::vector<unsigned char> MakeCRCData(std::size_t size)
+	{
+		std::vector<unsigned char> data(size);
+		std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+		std::uniform_int_distribution<int> distribution(0, 255);
+		for (auto& byte : data)
+		{
+			byte = static_cast<unsigned char>(distribution(generator));
+		}
+		return data;
+	}
+
+	/// 测试一种实现在指定数据大小上的吞吐量
+	template<typename Function>
+	void BenchmarkCRC(benchmark::State& state, Function function)
+	{
+		auto data = MakeCRCData(static_cast<std::size_t>(state.range(0)));
+
+		for (auto _ : state)
+		{
+			auto result = function(data.data(), data.size());
+			benchmark::DoNotOptimize(result);
+		}
+		state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(data.size()));
+	}
+
+	/// 核对一种校验模型的各个实现
+	template<typename Model>
+	void CrossCheckModel(const char* name, const std::vector<unsigned char>& data, std::size_t length)
+	{
+		auto expected = Model::UpdateBytewise(Model::InitialValue, data.data(), length);
+		if (Model::template UpdateSliced<4>(Model::InitialValue, data.data(), length) != expected ||
+		    Model::template UpdateSliced<8>(Model::InitialValue, data.data(), length) != expected)
+		{
+			throw std::runtime_error(std::string("[RegisterCRCBenchmarks] Sliced ") + name +
+			                         " Does Not Match Bytewise Result.");
+		}
+	}
+
+	/// 在不同长度与分段方式下核对各实现的结果
+	void CrossCheckCRC()
+	{
+		auto data = MakeCRCData(4096);
+		for (std::size_t length : {0, 1, 7, 8, 15, 16, 17, 63, 64, 1000, 4096})
+		{
+			CrossCheckModel<CRC8Model>("CRC8", data, length);
+			CrossCheckModel<CRC16Model>("CRC16", data, length);
+			CrossCheckModel<CRC32CModel>("CRC32C", data, length);
+
+			auto expected = CRC32CModel::Calculate(data.data(), length);
+			auto half = length / 2;
+			auto chained = CRCTool::GetCRC32CCheckSum(data.data() + half, length - half,
+			                                          CRCTool::GetCRC32CCheckSum(data.data(), half));
+			if (CRCTool::GetCRC32CCheckSum(data.data(), length) != expected || chained != expected)
+			{
+				throw std::runtime_error("[RegisterCRCBenchmarks] CRC32C Does Not Match Software Result.");
+			}
+		}
+	}
+
+	/// 注册一种实现在各数据大小上的测试
+	template<typename Function>
+	void RegisterCRCBenchmark(const std::string& name, Function function)
+	{
+		benchmark::RegisterBenchmark(name.c_str(), [function](benchmark::State& state){
+			BenchmarkCRC(state, function);
+		})->RangeMultiplier(16)->Range(64, 1 << 20);
+	}
+
+	/// 注册CRC校验的性能测试
+	void RegisterCRCBenchmarks()
+	{
+		CrossCheckCRC();
+
+		RegisterCRCBenchmark("CRC8/Bytewise", [](const unsigned char* data, std::size_t size){
+			return CRC8Model::UpdateBytewise(CRC8Model::InitialValue, data, size);
+		});
+		RegisterCRCBenchmark("CRC8/Slicing4", [](const unsigned char* data, std::size_t size){
+			return CRC8Model::UpdateSliced<4>(CRC8Model::InitialValue, data, size);
+		});
+		RegisterCRCBenchmark("CRC8/Slicing8", [](const unsigned char* data, std::size_t size){
+			return CRC8Model::UpdateSliced<8>(CRC8Model::InitialValue, data, size);
+		});
+		RegisterCRCBenchmark("CRC16/Bytewise", [](const unsigned char* data, std::size_t size){
+			return CRC16Model::UpdateBytewise(CRC16Model::InitialValue, data, size);
+		});
+		RegisterCRCBenchmark("CRC16/Slicing8", [](const unsigned char* data, std::size_t size){
+			return CRC16Model::UpdateSliced<8>(CRC16Model::InitialValue, data, size);
+		});
+		RegisterCRCBenchmark("CRC32C/Bytewise", [](const unsigned char* data, std::size_t size){
+			return CRC32CModel::UpdateBytewise(CRC32CModel::InitialValue, data, size);
+		});
+		RegisterCRCBenchmark("CRC32C/Slicing4", [](const unsigned char* data, std::size_t size){
+			return CRC32CModel::UpdateSliced<4>(CRC32CModel::InitialValue, data, size);
+		});
+		RegisterCRCBenchmark("CRC32C/Slicing8", [](const unsigned char* data, std::size_t size){
+			return CRC32CModel::UpdateSliced<8>(CRC32CModel::InitialValue, data, size);
+		});
+		if (CRCTool::IsCRC32CHardwareAvailable())
+		{
+			RegisterCRCBenchmark("CRC32C/Hardware", [](const unsigned char* data, std::size_t size){
+				return CRCTool::GetCRC32CCheckSum(data, size);
+			});
+		}
+	}
+}
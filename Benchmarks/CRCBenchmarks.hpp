@@ -0,0 +1,14 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+namespace RoboPioneers::Prometheus::Benchmarks
+{
+	/**
+	 * @brief 注册CRC校验的性能测试
+	 * @details
+	 *  ~ 测试名称的格式为"校验算法/实现/数据大小"，比较逐字节、按切片查表以及硬件指令的吞吐量。
+	 *  ~ 注册前在随机数据上核对各实现的结果，结果不一致时抛出异常。
+	 */
+	void RegisterCRCBenchmarks();
+}
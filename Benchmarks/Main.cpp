@@ -0,0 +1,71 @@
+#include "StageBenchmarks.hpp"
+#include "CRCBenchmarks.hpp"
+#include "RecordingBenchmarks.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace RoboPioneers::Prometheus::Benchmarks;
+
+/**
+ * @brief 性能测试入口
+ * @details
+ *  ~ 未指定--benchmark_out时，结果将以JSON格式额外写入PrometheusCoreBenchmarks.json，
+ *    可使用Google Benchmark附带的compare.py比较两次运行的结果。
+ */
+int main(int argc, char** argv)
+{
+	std::vector<char*> arguments(argv, argv + argc);
+
+	bool output_specified = false;
+	for (int index = 1; index < argc; ++index)
+	{
+		if (std::strncmp(argv[index], "--benchmark_out=", 16) == 0)
+		{
+			output_specified = true;
+		}
+	}
+
+	std::string output_argument = "--benchmark_out=PrometheusCoreBenchmarks.json";
+	std::string format_argument = "--benchmark_out_format=json";
+	if (!output_specified)
+	{
+		arguments.push_back(output_argument.data());
+		arguments.push_back(format_argument.data());
+	}
+
+	int argument_count = static_cast<int>(arguments.size());
+	benchmark::Initialize(&argument_count, arguments.data());
+	if (benchmark::ReportUnrecognizedArguments(argument_count, arguments.data()))
+	{
+		return 1;
+	}
+
+	// 合成场景覆盖从单个目标到大量干扰的情形，录制场景由环境变量指定
+	const cv::Size screen_size(1280, 1024);
+	std::vector<BenchmarkScene> scenes {
+		MakeSyntheticScene(screen_size, 1, 0, 0, 0, 1),
+		MakeSyntheticScene(screen_size, 4, 8, 64, 0, 2),
+		MakeSyntheticScene(screen_size, 4, 8, 64, 9, 3),
+		MakeSyntheticScene(screen_size, 16, 32, 256, 0, 4)
+	};
+
+	// 灯条数量的伸缩曲线，用于观察装甲板匹配的组合开销
+	for (int light_bar_count : {5, 50, 500})
+	{
+		scenes.push_back(MakeSyntheticScene(screen_size, 0, light_bar_count, 0, 0, 5));
+	}
+	for (auto& scene : LoadRecordedScenes())
+	{
+		scenes.push_back(std::move(scene));
+	}
+
+	RegisterStageBenchmarks(scenes);
+	RegisterCRCBenchmarks();
+	RegisterRecordingBenchmarks(scenes);
+
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
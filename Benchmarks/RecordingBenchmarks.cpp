@@ -0,0 +1,104 @@
+#include "RecordingBenchmarks.hpp"
+
+#include <Recording/PrometheusRecording.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+namespace RoboPioneers::Prometheus::Benchmarks
+{
+	using Recording::BayerCodec;
+
+	/// 默认的相机帧率，即1280x1024下的最高帧率
+	static constexpr double DefaultCameraFrameRate = 210.0;
+
+	/// 获取相机帧率，可由环境变量PROMETHEUS_BENCHMARK_CAMERA_FPS覆盖
+	double GetCameraFrameRate()
+	{
+		const auto* frame_rate = std::getenv("PROMETHEUS_BENCHMARK_CAMERA_FPS");
+		if (frame_rate && std::atof(frame_rate) > 0.0)
+		{
+			return std::atof(frame_rate);
+		}
+		return DefaultCameraFrameRate;
+	}
+
+	/// 将场景图像采样为Bayer原始图像
+	cv::Mat MakeBayerPicture(const BenchmarkScene& scene)
+	{
+		cv::Mat bayer_picture;
+		Simulation::SceneGenerator::Mosaic(scene.Picture, bayer_picture);
+		return bayer_picture;
+	}
+
+	/// 核对编码后再解码的结果与原始图像一致
+	void CrossCheckBayerCodec(const BenchmarkScene& scene, const cv::Mat& bayer_picture)
+	{
+		BayerCodec codec;
+		std::vector<unsigned char> encoded, decoded;
+		std::uint32_t width = 0, height = 0;
+		codec.Encode(bayer_picture.data, bayer_picture.cols, bayer_picture.rows, bayer_picture.step[0], encoded);
+		codec.Decode(encoded.data(), encoded.size(), decoded, width, height);
+
+		if (width != static_cast<std::uint32_t>(bayer_picture.cols) ||
+		    height != static_cast<std::uint32_t>(bayer_picture.rows) ||
+		    cv::norm(bayer_picture, cv::Mat(bayer_picture.size(), CV_8UC1, decoded.data()), cv::NORM_INF) != 0)
+		{
+			throw std::runtime_error("[RegisterRecordingBenchmarks] Bayer Codec is not Lossless on " + scene.Name + ".");
+		}
+	}
+
+	/// 测试编码吞吐量，线程数由参数给出
+	void BenchmarkBayerEncode(benchmark::State& state, const cv::Mat& bayer_picture)
+	{
+		BayerCodec codec(static_cast<int>(state.range(0)));
+		std::vector<unsigned char> encoded;
+
+		for (auto _ : state)
+		{
+			codec.Encode(bayer_picture.data, bayer_picture.cols, bayer_picture.rows, bayer_picture.step[0], encoded);
+			benchmark::DoNotOptimize(encoded.data());
+		}
+		state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(bayer_picture.total()));
+		state.counters["Ratio"] = static_cast<double>(bayer_picture.total()) / static_cast<double>(encoded.size());
+		// 编码帧率与相机帧率之比，不低于1才能跟上相机
+		state.counters["CameraRatio"] = benchmark::Counter(
+				static_cast<double>(state.iterations()) / GetCameraFrameRate(), benchmark::Counter::kIsRate);
+	}
+
+	/// 测试解码吞吐量，线程数由参数给出
+	void BenchmarkBayerDecode(benchmark::State& state, const cv::Mat& bayer_picture)
+	{
+		BayerCodec codec(static_cast<int>(state.range(0)));
+		std::vector<unsigned char> encoded, decoded;
+		std::uint32_t width = 0, height = 0;
+		codec.Encode(bayer_picture.data, bayer_picture.cols, bayer_picture.rows, bayer_picture.step[0], encoded);
+
+		for (auto _ : state)
+		{
+			codec.Decode(encoded.data(), encoded.size(), decoded, width, height);
+			benchmark::DoNotOptimize(decoded.data());
+		}
+		state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(bayer_picture.total()));
+	}
+
+	/// 注册Bayer编解码器的性能测试
+	void RegisterRecordingBenchmarks(const std::vector<BenchmarkScene>& scenes)
+	{
+		for (const auto& scene : scenes)
+		{
+			auto bayer_picture = MakeBayerPicture(scene);
+			CrossCheckBayerCodec(scene, bayer_picture);
+
+			// 录制预计占用两个核心，单线程用于观察并行的伸缩
+			benchmark::RegisterBenchmark(("BayerCodec/Encode/" + scene.Name).c_str(),
+			                             &BenchmarkBayerEncode, bayer_picture)
+					->Arg(1)->Arg(2)->Unit(benchmark::kMicrosecond)->UseRealTime();
+			benchmark::RegisterBenchmark(("BayerCodec/Decode/" + scene.Name).c_str(),
+			                             &BenchmarkBayerDecode, bayer_picture)
+					->Arg(1)->Arg(2)->Unit(benchmark::kMicrosecond)->UseRealTime();
+		}
+	}
+}
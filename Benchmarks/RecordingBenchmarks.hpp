@@ -0,0 +1,21 @@
+#pragma once
+
+#include "BenchmarkScenes.hpp"
+
+#include <vector>
+#include <benchmark/benchmark.h>
+
+namespace RoboPioneers::Prometheus::Benchmarks
+{
+	/**
+	 * @brief 注册Bayer编解码器的性能测试
+	 * @param scenes 测试场景，其图像将被重新采样为BayerBG原始图像
+	 * @details
+	 *  ~ 测试名称的格式为"BayerCodec/编码或解码/场景名称/线程数"，
+	 *    吞吐量以原始图像的字节数计，压缩比记录在Ratio计数器中。
+	 *  ~ 编码测试的CameraRatio计数器为编码帧率与相机帧率之比，录制要求两线程时不低于1；
+	 *    相机帧率默认为1280x1024下的210帧每秒，约275MB/s，可由环境变量PROMETHEUS_BENCHMARK_CAMERA_FPS覆盖。
+	 *  ~ 注册前在每个场景上核对解码结果与原始图像一致，不一致时抛出异常。
+	 */
+	void RegisterRecordingBenchmarks(const std::vector<BenchmarkScene>& scenes);
+}
@@ -0,0 +1,134 @@
+#include "StageBenchmarks.hpp"
+
+#include <Core/Modules/GeometryFeatureModule.hpp>
+
+#include <array>
+#include <string>
+#include <utility>
+
+namespace RoboPioneers::Prometheus::Benchmarks
+{
+	/// 颜色过滤阶段，使用CPU路径
+	void BenchmarkColorFilter(benchmark::State& state, const BenchmarkScene& scene)
+	{
+		StageSet stages(scene);
+		Core::Frame frame;
+		stages.Prepare(frame, scene, 0);
+
+		for (auto _ : state)
+		{
+			stages.ColorStage.Execute(frame);
+			benchmark::DoNotOptimize(frame.BinaryPicture.data);
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(scene.Picture.total()));
+	}
+
+	/// 灯条检测阶段
+	void BenchmarkLightBarDetector(benchmark::State& state, const BenchmarkScene& scene)
+	{
+		StageSet stages(scene);
+		Core::Frame frame;
+		stages.Prepare(frame, scene, 1);
+
+		for (auto _ : state)
+		{
+			stages.LightBarStage.Execute(frame);
+			benchmark::DoNotOptimize(frame.LightBars.size());
+		}
+		state.counters["LightBars"] = static_cast<double>(frame.LightBars.size());
+	}
+
+	/// 装甲板匹配阶段
+	void BenchmarkArmorMatcher(benchmark::State& state, const BenchmarkScene& scene)
+	{
+		StageSet stages(scene);
+		Core::Frame frame;
+		stages.Prepare(frame, scene, 2);
+
+		for (auto _ : state)
+		{
+			stages.ArmorStage.Execute(frame);
+			benchmark::DoNotOptimize(frame.Armors.size());
+		}
+		state.counters["LightBars"] = static_cast<double>(frame.LightBars.size());
+		state.counters["Armors"] = static_cast<double>(frame.Armors.size());
+	}
+
+	/// 装甲板选择阶段
+	void BenchmarkArmorSelector(benchmark::State& state, const BenchmarkScene& scene)
+	{
+		StageSet stages(scene);
+		Core::Frame frame;
+		stages.Prepare(frame, scene, 3);
+
+		for (auto _ : state)
+		{
+			stages.RecommendStage.Execute(frame);
+			benchmark::DoNotOptimize(frame.Target);
+		}
+		state.counters["Armors"] = static_cast<double>(frame.Armors.size());
+	}
+
+	/// 裁剪选择阶段，上一帧的目标为场景中被选择的装甲板
+	void BenchmarkCuttingChooser(benchmark::State& state, const BenchmarkScene& scene)
+	{
+		StageSet stages(scene);
+		Core::Frame previous_frame, frame;
+		stages.Prepare(previous_frame, scene, 4);
+		stages.Prepare(frame, scene, 0);
+		frame.Previous = &previous_frame;
+
+		for (auto _ : state)
+		{
+			stages.CuttingStage.Execute(frame);
+			benchmark::DoNotOptimize(frame.CuttingPicture.data);
+		}
+		state.counters["Locked"] = stages.CuttingStage.LockingRemainTimes != 0 ? 1.0 : 0.0;
+	}
+
+	/// 旋转矩形标准化
+	void BenchmarkStandardizeRotatedRectangle(benchmark::State& state)
+	{
+		// 覆盖各个象限与长宽关系的旋转矩形
+		std::vector<cv::RotatedRect> rectangles;
+		for (int angle = -90; angle < 90; angle += 5)
+		{
+			rectangles.emplace_back(cv::Point2f(100.0f, 100.0f), cv::Size2f(10.0f, 40.0f), static_cast<float>(angle));
+			rectangles.emplace_back(cv::Point2f(100.0f, 100.0f), cv::Size2f(40.0f, 10.0f), static_cast<float>(angle));
+		}
+
+		for (auto _ : state)
+		{
+			for (const auto& rectangle : rectangles)
+			{
+				auto feature = Modules::GeometryFeatureModule::StandardizeRotatedRectangle(rectangle);
+				benchmark::DoNotOptimize(feature);
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(rectangles.size()));
+	}
+
+	/// 注册所有场景上的阶段性能测试
+	void RegisterStageBenchmarks(const std::vector<BenchmarkScene>& scenes)
+	{
+		using StageBenchmark = void (*)(benchmark::State&, const BenchmarkScene&);
+		const std::array<std::pair<const char*, StageBenchmark>, 5> stage_benchmarks {{
+			{"ColorFilter", &BenchmarkColorFilter},
+			{"LightBarDetector", &BenchmarkLightBarDetector},
+			{"ArmorMatcher", &BenchmarkArmorMatcher},
+			{"ArmorSelector", &BenchmarkArmorSelector},
+			{"CuttingChooser", &BenchmarkCuttingChooser}
+		}};
+
+		for (const auto& [stage_name, stage_benchmark] : stage_benchmarks)
+		{
+			for (const auto& scene : scenes)
+			{
+				benchmark::RegisterBenchmark((std::string(stage_name) + "/" + scene.Name).c_str(),
+								 stage_benchmark, scene)->Unit(benchmark::kMicrosecond);
+			}
+		}
+
+		benchmark::RegisterBenchmark("StandardizeRotatedRectangle", &BenchmarkStandardizeRotatedRectangle);
+	}
+}
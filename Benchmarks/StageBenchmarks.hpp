@@ -0,0 +1,17 @@
+#pragma once
+
+#include "BenchmarkScenes.hpp"
+
+#include <vector>
+#include <benchmark/benchmark.h>
+
+namespace RoboPioneers::Prometheus::Benchmarks
+{
+	/**
+	 * @brief 注册各阶段的性能测试
+	 * @param scenes 测试场景，每个阶段在每个场景上各注册一项测试
+	 * @details
+	 *  ~ 测试名称的格式为"阶段名/场景名"；各阶段所需的输入由该阶段之前的阶段在场景上执行一次得到。
+	 */
+	void RegisterStageBenchmarks(const std::vector<BenchmarkScene>& scenes);
+}
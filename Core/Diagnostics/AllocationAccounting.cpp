@@ -0,0 +1,385 @@
+#include "AllocationAccounting.hpp"
+
+#ifdef PROMETHEUS_ALLOCATION_ACCOUNTING
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+#include <malloc.h>
+
+extern "C"
+{
+	void* __libc_malloc(std::size_t size);
+	void* __libc_calloc(std::size_t count, std::size_t size);
+	void* __libc_realloc(void* pointer, std::size_t size);
+	void* __libc_memalign(std::size_t alignment, std::size_t size);
+	void __libc_free(void* pointer);
+}
+#endif
+
+namespace RoboPioneers::Prometheus::Core
+{
+	#ifdef PROMETHEUS_ALLOCATION_ACCOUNTING
+	namespace
+	{
+		/// 可被统计的最大线程数，超出的线程的分配不被统计
+		constexpr std::size_t MaxThreadCount = 256;
+
+		/// 线程计数器，只由所属线程写入，故不需要原子读-改-写操作
+		struct ThreadAllocations
+		{
+			/// 各统计槽的分配次数
+			std::array<std::atomic<std::uint64_t>, AllocationAccounting::SlotCount> Counts {};
+			/// 各统计槽的分配字节数
+			std::array<std::atomic<std::uint64_t>, AllocationAccounting::SlotCount> Bytes {};
+		};
+
+		/// 全部线程的计数器，静态分配，以免在分配函数中再次分配
+		std::array<ThreadAllocations, MaxThreadCount> ThreadSlots;
+		/// 已被占用的线程计数器数量
+		std::atomic<std::size_t> ThreadSlotCount {0};
+
+		/// 当前阶段开始时的未释放字节数
+		std::atomic<std::int64_t> StageBaseline {0};
+		/// 全局未释放字节数
+		std::atomic<std::int64_t> LiveBytes {0};
+		/// 各统计槽的峰值
+		std::array<std::atomic<std::uint64_t>, AllocationAccounting::SlotCount> Peaks {};
+
+		/// 当前线程的计数器，使用初始执行模型以免首次访问时发生分配
+		__attribute__((tls_model("initial-exec"))) thread_local ThreadAllocations* CurrentThreadSlot {nullptr};
+		/// 当前线程是否已经尝试获取计数器
+		__attribute__((tls_model("initial-exec"))) thread_local bool CurrentThreadInitialized {false};
+		/// 当前线程的当前阶段，其他线程上的分配不会被计入流水线正在执行的阶段
+		__attribute__((tls_model("initial-exec"))) thread_local std::size_t CurrentStage
+			{AllocationAccounting::UnattributedSlot};
+
+		/// 为当前线程获取计数器
+		inline ThreadAllocations* GetThreadSlot() noexcept
+		{
+			if (!CurrentThreadInitialized)
+			{
+				CurrentThreadInitialized = true;
+				auto index = ThreadSlotCount.fetch_add(1, std::memory_order_relaxed);
+				CurrentThreadSlot = index < MaxThreadCount ? &ThreadSlots[index] : nullptr;
+			}
+			return CurrentThreadSlot;
+		}
+
+		/// 记录一次分配
+		inline void RecordAllocation(void* pointer) noexcept
+		{
+			if (!pointer) return;
+
+			auto size = static_cast<std::uint64_t>(malloc_usable_size(pointer));
+			auto stage = CurrentStage;
+
+			if (auto* slot = GetThreadSlot())
+			{
+				auto& count = slot->Counts[stage];
+				count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				auto& bytes = slot->Bytes[stage];
+				bytes.store(bytes.load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+			}
+
+			auto live = LiveBytes.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed) +
+				static_cast<std::int64_t>(size);
+			auto growth = live - StageBaseline.load(std::memory_order_relaxed);
+			if (growth > 0)
+			{
+				auto& peak = Peaks[stage];
+				auto current_peak = peak.load(std::memory_order_relaxed);
+				while (static_cast<std::uint64_t>(growth) > current_peak &&
+					!peak.compare_exchange_weak(current_peak, static_cast<std::uint64_t>(growth),
+									  std::memory_order_relaxed))
+				{}
+			}
+		}
+
+		/// 记录释放的字节数
+		inline void RecordReleasedBytes(std::size_t size) noexcept
+		{
+			LiveBytes.fetch_sub(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+		}
+
+		/// 记录一次释放
+		inline void RecordDeallocation(void* pointer) noexcept
+		{
+			if (!pointer) return;
+			RecordReleasedBytes(malloc_usable_size(pointer));
+		}
+
+		/// 对齐值是否为2的幂
+		inline bool IsPowerOfTwo(std::size_t alignment) noexcept
+		{
+			return alignment != 0 && (alignment & (alignment - 1)) == 0;
+		}
+	}
+
+	/// 设置当前阶段
+	void AllocationAccounting::SetCurrentStage(std::size_t slot) noexcept
+	{
+		StageBaseline.store(LiveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		CurrentStage = slot < SlotCount ? slot : UnattributedSlot;
+	}
+
+	/// 获取当前阶段
+	std::size_t AllocationAccounting::GetCurrentStage() noexcept
+	{
+		return CurrentStage;
+	}
+
+	/// 设置当前线程的阶段
+	AllocationAccounting::StageScope::StageScope(std::size_t slot) noexcept : PreviousStage(CurrentStage)
+	{
+		CurrentStage = slot < SlotCount ? slot : UnattributedSlot;
+	}
+
+	/// 恢复当前线程原有的阶段
+	AllocationAccounting::StageScope::~StageScope() noexcept
+	{
+		CurrentStage = PreviousStage;
+	}
+
+	/// 获取全部线程的累计统计
+	auto AllocationAccounting::TakeSnapshot() noexcept -> Snapshot
+	{
+		Snapshot snapshot;
+
+		auto thread_count = std::min(ThreadSlotCount.load(std::memory_order_relaxed), MaxThreadCount);
+		for (std::size_t thread_index = 0; thread_index < thread_count; ++thread_index)
+		{
+			const auto& thread_slot = ThreadSlots[thread_index];
+			for (std::size_t slot = 0; slot < SlotCount; ++slot)
+			{
+				snapshot[slot].Count += thread_slot.Counts[slot].load(std::memory_order_relaxed);
+				snapshot[slot].Bytes += thread_slot.Bytes[slot].load(std::memory_order_relaxed);
+			}
+		}
+		for (std::size_t slot = 0; slot < SlotCount; ++slot)
+		{
+			snapshot[slot].Peak = Peaks[slot].load(std::memory_order_relaxed);
+		}
+
+		return snapshot;
+	}
+
+	/// 清空各统计槽的峰值
+	void AllocationAccounting::ResetPeaks() noexcept
+	{
+		for (auto& peak : Peaks)
+		{
+			peak.store(0, std::memory_order_relaxed);
+		}
+	}
+	#else
+	/// 设置当前阶段
+	void AllocationAccounting::SetCurrentStage(std::size_t) noexcept
+	{}
+
+	/// 获取当前阶段
+	std::size_t AllocationAccounting::GetCurrentStage() noexcept
+	{
+		return UnattributedSlot;
+	}
+
+	/// 设置当前线程的阶段
+	AllocationAccounting::StageScope::StageScope(std::size_t) noexcept : PreviousStage(UnattributedSlot)
+	{}
+
+	/// 恢复当前线程原有的阶段
+	AllocationAccounting::StageScope::~StageScope() noexcept
+	{}
+
+	/// 获取全部线程的累计统计
+	auto AllocationAccounting::TakeSnapshot() noexcept -> Snapshot
+	{
+		return {};
+	}
+
+	/// 清空各统计槽的峰值
+	void AllocationAccounting::ResetPeaks() noexcept
+	{}
+	#endif
+
+	/// 计算两份快照之间的差值
+	auto AllocationAccounting::GetDifference(const Snapshot& later, const Snapshot& earlier) noexcept -> Snapshot
+	{
+		Snapshot difference;
+		for (std::size_t slot = 0; slot < SlotCount; ++slot)
+		{
+			difference[slot].Count = later[slot].Count - earlier[slot].Count;
+			difference[slot].Bytes = later[slot].Bytes - earlier[slot].Bytes;
+			difference[slot].Peak = later[slot].Peak;
+		}
+		return difference;
+	}
+}
+
+#ifdef PROMETHEUS_ALLOCATION_ACCOUNTING
+//==============================
+// 分配函数替换
+//==============================
+
+using RoboPioneers::Prometheus::Core::RecordAllocation;
+using RoboPioneers::Prometheus::Core::RecordDeallocation;
+using RoboPioneers::Prometheus::Core::RecordReleasedBytes;
+using RoboPioneers::Prometheus::Core::IsPowerOfTwo;
+
+extern "C"
+{
+	void* malloc(std::size_t size)
+	{
+		auto* pointer = __libc_malloc(size);
+		RecordAllocation(pointer);
+		return pointer;
+	}
+
+	void* calloc(std::size_t count, std::size_t size)
+	{
+		auto* pointer = __libc_calloc(count, size);
+		RecordAllocation(pointer);
+		return pointer;
+	}
+
+	void* realloc(void* pointer, std::size_t size)
+	{
+		if (!pointer) return malloc(size);
+		// 与glibc一致，大小为零时释放原内存块并返回空指针
+		if (size == 0)
+		{
+			free(pointer);
+			return nullptr;
+		}
+
+		// 失败时原内存块仍然有效，故只在成功后记录原内存块的释放
+		const auto old_size = malloc_usable_size(pointer);
+		auto* new_pointer = __libc_realloc(pointer, size);
+		if (!new_pointer) return nullptr;
+
+		RecordReleasedBytes(old_size);
+		RecordAllocation(new_pointer);
+		return new_pointer;
+	}
+
+	void free(void* pointer)
+	{
+		RecordDeallocation(pointer);
+		__libc_free(pointer);
+	}
+
+	void* memalign(std::size_t alignment, std::size_t size)
+	{
+		auto* pointer = __libc_memalign(alignment, size);
+		RecordAllocation(pointer);
+		return pointer;
+	}
+
+	void* aligned_alloc(std::size_t alignment, std::size_t size)
+	{
+		if (!IsPowerOfTwo(alignment))
+		{
+			errno = EINVAL;
+			return nullptr;
+		}
+		return memalign(alignment, size);
+	}
+
+	int posix_memalign(void** pointer, std::size_t alignment, std::size_t size)
+	{
+		// 对齐值须为2的幂且为指针大小的倍数，失败时不修改输出的指针
+		if (!IsPowerOfTwo(alignment) || alignment % sizeof(void*) != 0) return EINVAL;
+
+		auto* result = __libc_memalign(alignment, size);
+		if (!result) return ENOMEM;
+		RecordAllocation(result);
+		*pointer = result;
+		return 0;
+	}
+}
+
+void* operator new(std::size_t size)
+{
+	auto* pointer = malloc(size == 0 ? 1 : size);
+	if (!pointer) throw std::bad_alloc();
+	return pointer;
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	return malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+	free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+	free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+	free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+	free(pointer);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	auto* pointer = memalign(static_cast<std::size_t>(alignment), size == 0 ? 1 : size);
+	if (!pointer) throw std::bad_alloc();
+	return pointer;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+	return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return memalign(static_cast<std::size_t>(alignment), size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return memalign(static_cast<std::size_t>(alignment), size == 0 ? 1 : size);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+	free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept
+{
+	free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept
+{
+	free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept
+{
+	free(pointer);
+}
+#endif
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "StageStatistics.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/// 单个阶段的堆分配统计
+	struct StageAllocations
+	{
+		/// 分配次数
+		std::uint64_t Count {0};
+		/// 分配的字节数
+		std::uint64_t Bytes {0};
+		/// 阶段执行期间未释放字节数的峰值，即相对于阶段开始时的增量的最大值
+		std::uint64_t Peak {0};
+	};
+
+	/**
+	 * @brief 堆分配统计
+	 * @author Vincent
+	 * @details
+	 *  ~ 仅在定义了PROMETHEUS_ALLOCATION_ACCOUNTING宏的诊断构建中可用，此时全局的operator new与malloc系列函数
+	 *    将被替换，每次分配计入当前线程的计数器，并归属于当前正在执行的阶段；
+	 *    未处于任何阶段时的分配归属于最后一个统计槽。
+	 *  ~ 计数器按线程存储，分配时只写入本线程的计数器。
+	 *  ~ 当前阶段同样按线程记录，串口、指标服务等其他线程上的分配归属于最后一个统计槽；
+	 *    阶段内派发的TBB任务须以StageScope继承发起线程的阶段，其在工作线程上的分配才归属于该阶段。
+	 *  ~ 未定义该宏时，所有方法均为空操作，不替换任何分配函数。
+	 */
+	class AllocationAccounting
+	{
+	public:
+		/// 统计槽数量，最后一个槽用于不属于任何阶段的分配
+		static constexpr std::size_t SlotCount = StageStatistics::StageCount + 1;
+		/// 不属于任何阶段的统计槽
+		static constexpr std::size_t UnattributedSlot = StageStatistics::StageCount;
+
+		/// 各统计槽的分配统计
+		using Snapshot = std::array<StageAllocations, SlotCount>;
+
+		/// 是否启用了堆分配统计
+		static constexpr bool IsAvailable() noexcept
+		{
+			#ifdef PROMETHEUS_ALLOCATION_ACCOUNTING
+			return true;
+			#else
+			return false;
+			#endif
+		}
+
+		/**
+		 * @brief 阶段作用域
+		 * @details
+		 *  ~ 在其生命周期内将当前线程的阶段设为指定的统计槽，析构时恢复原有的阶段，不修改未释放字节数基准。
+		 *  ~ 用于TBB任务：在派发前以GetCurrentStage取得发起线程的阶段，在任务中构造该作用域。
+		 */
+		class StageScope
+		{
+		private:
+			/// 构造前当前线程的阶段
+			std::size_t PreviousStage;
+
+		public:
+			/// 设置当前线程的阶段
+			explicit StageScope(std::size_t slot) noexcept;
+			/// 恢复当前线程原有的阶段
+			~StageScope() noexcept;
+
+			StageScope(const StageScope&) = delete;
+			StageScope& operator=(const StageScope&) = delete;
+		};
+
+		/**
+		 * @brief 设置当前线程的当前阶段
+		 * @param slot 统计槽，通常为阶段标识符的值
+		 * @details
+		 *  ~ 同时将该阶段的未释放字节数基准设为当前值。
+		 */
+		static void SetCurrentStage(std::size_t slot) noexcept;
+
+		/// 获取当前线程的当前阶段
+		static std::size_t GetCurrentStage() noexcept;
+
+		/**
+		 * @brief 获取全部线程的累计统计
+		 * @return 各统计槽的累计分配次数与字节数，以及自上次清空以来的峰值
+		 */
+		static Snapshot TakeSnapshot() noexcept;
+
+		/// 清空各统计槽的峰值
+		static void ResetPeaks() noexcept;
+
+		/**
+		 * @brief 计算两份快照之间的差值
+		 * @param later 较晚的快照
+		 * @param earlier 较早的快照
+		 * @return 分配次数与字节数为差值，峰值取较晚快照中的值
+		 */
+		static Snapshot GetDifference(const Snapshot& later, const Snapshot& earlier) noexcept;
+	};
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "AllocationAccounting.hpp"
+
+#include <array>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	class Frame;
+
+	/**
+	 * @brief 堆分配钩子
+	 * @tparam Capacity 可绑定的最大阶段数
+	 * @author Vincent
+	 * @details
+	 *  ~ 该钩子在阶段执行期间将堆分配统计的当前阶段设为绑定的统计槽，执行完毕后恢复为不属于任何阶段。
+	 *  ~ 未启用堆分配统计的构建中，该钩子不产生任何开销。
+	 */
+	template<std::size_t Capacity = 16>
+	class AllocationHook
+	{
+	protected:
+		/// 各流水线阶段所绑定的统计槽
+		std::array<std::size_t, Capacity> Slots;
+
+	public:
+		/// 构造，所有阶段均未绑定
+		AllocationHook() noexcept
+		{
+			Slots.fill(AllocationAccounting::UnattributedSlot);
+		}
+
+		/**
+		 * @brief 将流水线阶段绑定到统计槽
+		 * @param stage_index 阶段在流水线中的索引
+		 * @param stage 被统计的阶段
+		 */
+		void Bind(std::size_t stage_index, StageIdentifier stage)
+		{
+			Slots.at(stage_index) = static_cast<std::size_t>(stage);
+		}
+
+		/// 阶段开始执行
+		template<std::size_t Index, typename Stage>
+		inline void OnStageBegin(Frame&) noexcept
+		{
+			static_assert(Index < Capacity, "AllocationHook capacity is smaller than the stage count.");
+			if constexpr (AllocationAccounting::IsAvailable())
+			{
+				AllocationAccounting::SetCurrentStage(Slots[Index]);
+			}
+		}
+
+		/// 阶段执行完毕
+		template<std::size_t Index, typename Stage>
+		inline void OnStageEnd(Frame&) noexcept
+		{
+			if constexpr (AllocationAccounting::IsAvailable())
+			{
+				AllocationAccounting::SetCurrentStage(AllocationAccounting::UnattributedSlot);
+			}
+		}
+	};
+}
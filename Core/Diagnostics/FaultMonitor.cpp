@@ -0,0 +1,165 @@
+#include "FaultMonitor.hpp"
+
+#include <new>
+#include <stdexcept>
+#include <opencv4/opencv2/core.hpp>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/// 构造并分配窗口
+	FaultMonitor::FaultMonitor()
+	{
+		SetBudget(Limits);
+	}
+
+	/// 设置故障预算
+	void FaultMonitor::SetBudget(const Budget &budget)
+	{
+		Limits = budget;
+		if (Limits.WindowSize == 0)
+		{
+			throw std::invalid_argument("[FaultMonitor::SetBudget] Window Size Must be Positive.");
+		}
+
+		Window.assign(Limits.WindowSize, NoFault);
+		WindowCursor = 0;
+		WindowFailures.fill(0);
+		LastResetFrames.fill(0);
+		ConsecutiveResets.fill(0);
+	}
+
+	/// 绑定阶段名称
+	void FaultMonitor::Bind(std::size_t stage_index, const char *name) noexcept
+	{
+		if (stage_index < MaxStageCount)
+		{
+			Names[stage_index] = name;
+		}
+	}
+
+	/// 获取阶段名称
+	const char* FaultMonitor::GetStageName(std::size_t stage_index) const noexcept
+	{
+		if (stage_index == OutsideStage) return "Outside";
+		return stage_index < MaxStageCount ? Names[stage_index] : nullptr;
+	}
+
+	/// 获取故障类型名称
+	const char* FaultMonitor::GetTypeName(FaultType type) noexcept
+	{
+		switch (type)
+		{
+			case FaultType::OpenCV:
+				return "OpenCV";
+			case FaultType::CUDA:
+				return "CUDA";
+			case FaultType::Memory:
+				return "Memory";
+			case FaultType::Standard:
+				return "Standard";
+			default:
+				return "Unknown";
+		}
+	}
+
+	/// 判断异常的故障类型
+	FaultType FaultMonitor::Classify(const std::exception_ptr &error) noexcept
+	{
+		try
+		{
+			std::rethrow_exception(error);
+		}
+		catch (const cv::Exception& exception)
+		{
+			return exception.code == cv::Error::GpuApiCallError || exception.code == cv::Error::GpuNotSupported ?
+			       FaultType::CUDA : FaultType::OpenCV;
+		}
+		catch (const std::bad_alloc&)
+		{
+			return FaultType::Memory;
+		}
+		catch (const std::exception&)
+		{
+			return FaultType::Standard;
+		}
+		catch (...)
+		{
+			return FaultType::Unknown;
+		}
+	}
+
+	/// 将一帧的结果放入窗口
+	void FaultMonitor::Push(std::uint8_t stage_index) noexcept
+	{
+		auto& entry = Window[WindowCursor];
+		if (entry != NoFault)
+		{
+			--WindowFailures[entry];
+		}
+		entry = stage_index;
+		if (entry != NoFault)
+		{
+			++WindowFailures[entry];
+		}
+		WindowCursor = (WindowCursor + 1) % Window.size();
+	}
+
+	/// 从窗口中清除某个阶段的故障
+	void FaultMonitor::ClearWindow(std::size_t stage_index) noexcept
+	{
+		for (auto& entry : Window)
+		{
+			if (entry == stage_index)
+			{
+				entry = NoFault;
+			}
+		}
+		WindowFailures[stage_index] = 0;
+	}
+
+	/// 记录一帧处理成功
+	void FaultMonitor::RecordSuccess() noexcept
+	{
+		FrameCount.fetch_add(1, std::memory_order_relaxed);
+		Push(NoFault);
+	}
+
+	/// 记录一帧发生故障
+	FaultAction FaultMonitor::RecordFailure(std::size_t stage_index, FaultType type) noexcept
+	{
+		if (stage_index > OutsideStage)
+		{
+			stage_index = OutsideStage;
+		}
+
+		auto frame_count = FrameCount.fetch_add(1, std::memory_order_relaxed) + 1;
+		FailedFrameCount.fetch_add(1, std::memory_order_relaxed);
+		Counts[stage_index][static_cast<std::size_t>(type)].fetch_add(1, std::memory_order_relaxed);
+		Push(static_cast<std::uint8_t>(stage_index));
+
+		if (static_cast<double>(WindowFailures[stage_index]) <=
+		    Limits.MaxFailureRatio * static_cast<double>(Window.size()))
+		{
+			return FaultAction::None;
+		}
+
+		// 超出预算，清除该阶段在窗口内的故障，重置后重新开始统计
+		ClearWindow(stage_index);
+		if (LastResetFrames[stage_index] != 0 && frame_count - LastResetFrames[stage_index] <= Limits.RecoveryFrames)
+		{
+			++ConsecutiveResets[stage_index];
+		}
+		else
+		{
+			ConsecutiveResets[stage_index] = 1;
+		}
+		LastResetFrames[stage_index] = frame_count;
+
+		if (ConsecutiveResets[stage_index] > Limits.MaxConsecutiveResets)
+		{
+			return FaultAction::Restart;
+		}
+		ResetCounts[stage_index].fetch_add(1, std::memory_order_relaxed);
+		return FaultAction::ResetStage;
+	}
+}
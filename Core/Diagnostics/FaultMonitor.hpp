@@ -0,0 +1,186 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/// 故障类型
+	enum class FaultType : std::size_t
+	{
+		/// OpenCV抛出的异常
+		OpenCV,
+		/// CUDA调用失败，由OpenCV以异常的形式抛出
+		CUDA,
+		/// 内存分配失败
+		Memory,
+		/// 其他标准库异常
+		Standard,
+		/// 非标准异常
+		Unknown,
+		/// 类型数量，不是有效的类型
+		Count
+	};
+
+	/// 故障处理动作
+	enum class FaultAction
+	{
+		/// 仅丢弃故障帧
+		None,
+		/// 重置故障阶段，阶段没有可重置的状态时由调用者直接重启
+		ResetStage,
+		/// 重启程序
+		Restart
+	};
+
+	/**
+	 * @brief 故障监视器
+	 * @author Vincent
+	 * @details
+	 *  ~ 处理线程在每帧结束时记录该帧成功或在哪个阶段发生了何种故障，监视器按阶段与故障类型计数。
+	 *  ~ 监视器在最近若干帧的窗口内统计各阶段的故障率，超出预算时要求重置该阶段；
+	 *    重置后未能恢复而连续多次超出预算时，要求重启程序。偶发的故障只会丢弃对应的帧。
+	 *  ~ 计数均为宽松原子变量，可由监控线程读取；窗口只能由处理线程访问。
+	 */
+	class FaultMonitor
+	{
+	public:
+		/// 可记录的最大阶段数
+		static constexpr std::size_t MaxStageCount = 16;
+		/// 流水线之外的故障所使用的阶段索引
+		static constexpr std::size_t OutsideStage = MaxStageCount;
+		/// 故障类型数量
+		static constexpr std::size_t TypeCount = static_cast<std::size_t>(FaultType::Count);
+
+		/// 故障预算
+		struct Budget
+		{
+			/// 统计故障率的窗口帧数
+			std::size_t WindowSize {200};
+			/// 单个阶段在窗口内允许的最大故障率
+			double MaxFailureRatio {0.05};
+			/// 重置后在该帧数内再次超出预算，视为重置未能恢复
+			std::uint64_t RecoveryFrames {400};
+			/// 连续重置未能恢复的次数超过该值时要求重启
+			unsigned int MaxConsecutiveResets {3};
+		};
+
+	protected:
+		/// 窗口中表示该帧没有故障的值
+		static constexpr std::uint8_t NoFault = 0xFF;
+
+		/// 故障预算
+		Budget Limits;
+		/// 阶段名称
+		std::array<const char*, MaxStageCount + 1> Names {};
+
+		/// 各阶段各类型的故障数
+		std::array<std::array<std::atomic<std::uint64_t>, TypeCount>, MaxStageCount + 1> Counts {};
+		/// 各阶段被重置的次数
+		std::array<std::atomic<std::uint64_t>, MaxStageCount + 1> ResetCounts {};
+		/// 已记录的帧数
+		std::atomic<std::uint64_t> FrameCount {0};
+		/// 发生故障的帧数
+		std::atomic<std::uint64_t> FailedFrameCount {0};
+
+		/// 最近若干帧的故障阶段，仅由处理线程访问
+		std::vector<std::uint8_t> Window;
+		/// 窗口中下一帧的位置
+		std::size_t WindowCursor {0};
+		/// 各阶段在窗口内的故障数
+		std::array<std::size_t, MaxStageCount + 1> WindowFailures {};
+		/// 各阶段最近一次要求重置时的帧数
+		std::array<std::uint64_t, MaxStageCount + 1> LastResetFrames {};
+		/// 各阶段连续重置未能恢复的次数
+		std::array<unsigned int, MaxStageCount + 1> ConsecutiveResets {};
+
+		/// 将一帧的结果放入窗口
+		void Push(std::uint8_t stage_index) noexcept;
+
+		/// 从窗口中清除某个阶段的故障
+		void ClearWindow(std::size_t stage_index) noexcept;
+
+	public:
+		/// 构造并按照默认预算分配窗口
+		FaultMonitor();
+
+		/**
+		 * @brief 设置故障预算，窗口将被清空
+		 * @param budget 故障预算
+		 */
+		void SetBudget(const Budget& budget);
+
+		/// 获取故障预算
+		[[nodiscard]] inline const Budget& GetBudget() const noexcept
+		{
+			return Limits;
+		}
+
+		/**
+		 * @brief 绑定阶段名称
+		 * @param stage_index 阶段索引
+		 * @param name 阶段名称，应为静态字符串
+		 */
+		void Bind(std::size_t stage_index, const char* name) noexcept;
+
+		/**
+		 * @brief 获取阶段名称
+		 * @param stage_index 阶段索引
+		 * @return 绑定的名称，未绑定时为空指针
+		 */
+		[[nodiscard]] const char* GetStageName(std::size_t stage_index) const noexcept;
+
+		/**
+		 * @brief 获取故障类型名称
+		 * @param type 故障类型
+		 * @return 类型名称
+		 */
+		static const char* GetTypeName(FaultType type) noexcept;
+
+		/**
+		 * @brief 判断异常的故障类型
+		 * @param error 捕获的异常
+		 * @return 故障类型
+		 */
+		static FaultType Classify(const std::exception_ptr& error) noexcept;
+
+		/// 记录一帧处理成功，只能由处理线程调用
+		void RecordSuccess() noexcept;
+
+		/**
+		 * @brief 记录一帧发生故障，只能由处理线程调用
+		 * @param stage_index 发生故障的阶段索引，流水线之外的故障为OutsideStage
+		 * @param type 故障类型
+		 * @return 调用者应当执行的处理动作
+		 */
+		FaultAction RecordFailure(std::size_t stage_index, FaultType type) noexcept;
+
+		/// 获取某个阶段某类故障的次数
+		[[nodiscard]] inline std::uint64_t GetCount(std::size_t stage_index, FaultType type) const noexcept
+		{
+			return Counts[stage_index][static_cast<std::size_t>(type)].load(std::memory_order_relaxed);
+		}
+
+		/// 获取某个阶段被重置的次数
+		[[nodiscard]] inline std::uint64_t GetResetCount(std::size_t stage_index) const noexcept
+		{
+			return ResetCounts[stage_index].load(std::memory_order_relaxed);
+		}
+
+		/// 获取已记录的帧数
+		[[nodiscard]] inline std::uint64_t GetFrameCount() const noexcept
+		{
+			return FrameCount.load(std::memory_order_relaxed);
+		}
+
+		/// 获取发生故障的帧数
+		[[nodiscard]] inline std::uint64_t GetFailedFrameCount() const noexcept
+		{
+			return FailedFrameCount.load(std::memory_order_relaxed);
+		}
+	};
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "HardwareCounters.hpp"
+#include "HardwareStatistics.hpp"
+
+#include <array>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	class Frame;
+
+	/**
+	 * @brief 硬件计数钩子
+	 * @tparam Capacity 可绑定的最大阶段数
+	 * @author Vincent
+	 * @details
+	 *  ~ 该钩子在阶段开始与结束时读取全部已注册线程的硬件计数之和，将其差值计入绑定的累加器，
+	 *    故TBB工作线程上执行的并行任务也计入其所属的阶段。
+	 *  ~ 注册表未启用时，每个阶段只有一次宽松原子读取的开销；启用后每个阶段需要为每个线程进行两次系统调用。
+	 */
+	template<std::size_t Capacity = 16>
+	class HardwareCounterHook
+	{
+	protected:
+		/// 各流水线阶段所绑定的累加器
+		std::array<HardwareAccumulator*, Capacity> Accumulators {};
+		/// 当前阶段开始时的计数
+		HardwareCounterValues BeginValues {};
+		/// 当前阶段是否正在计数
+		bool Counting {false};
+
+	public:
+		/**
+		 * @brief 将流水线阶段绑定到累加器
+		 * @param stage_index 阶段在流水线中的索引
+		 * @param accumulator 累加器，为空则解除绑定
+		 */
+		void Bind(std::size_t stage_index, HardwareAccumulator* accumulator)
+		{
+			Accumulators.at(stage_index) = accumulator;
+		}
+
+		/// 阶段开始执行
+		template<std::size_t Index, typename Stage>
+		inline void OnStageBegin(Frame&) noexcept
+		{
+			static_assert(Index < Capacity, "HardwareCounterHook capacity is smaller than the stage count.");
+
+			auto& registry = HardwareCounterRegistry::GetInstance();
+			Counting = Accumulators[Index] && registry.IsEnabled();
+			if (Counting)
+			{
+				registry.ReadAll(BeginValues);
+			}
+		}
+
+		/// 阶段执行完毕
+		template<std::size_t Index, typename Stage>
+		inline void OnStageEnd(Frame&) noexcept
+		{
+			if (!Counting) return;
+
+			HardwareCounterValues end_values;
+			HardwareCounterRegistry::GetInstance().ReadAll(end_values);
+
+			// 某个线程的计数器读取失败时，差值可能为负，此时丢弃该样本
+			for (std::size_t index = 0; index < end_values.size(); ++index)
+			{
+				if (end_values[index] < BeginValues[index]) return;
+				end_values[index] -= BeginValues[index];
+			}
+			Accumulators[Index]->Add(end_values);
+		}
+	};
+}
@@ -0,0 +1,146 @@
+#include "HardwareCounters.hpp"
+
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	namespace
+	{
+		/// 各硬件事件对应的perf事件配置
+		constexpr std::array<std::uint64_t, static_cast<std::size_t>(HardwareEvent::Count)> EventConfigs {
+			PERF_COUNT_HW_CPU_CYCLES,
+			PERF_COUNT_HW_INSTRUCTIONS,
+			PERF_COUNT_HW_CACHE_MISSES,
+			PERF_COUNT_HW_BRANCH_MISSES
+		};
+
+		/// 当前线程是否已经注册计数器
+		thread_local bool CurrentThreadRegistered {false};
+
+		/// 打开当前线程上的一个硬件计数器
+		int OpenCounter(std::uint64_t config, int group_descriptor)
+		{
+			perf_event_attr attribute;
+			std::memset(&attribute, 0, sizeof(attribute));
+			attribute.type = PERF_TYPE_HARDWARE;
+			attribute.size = sizeof(attribute);
+			attribute.config = config;
+			attribute.exclude_kernel = 1;
+			attribute.exclude_hv = 1;
+			attribute.read_format = PERF_FORMAT_GROUP;
+
+			return static_cast<int>(::syscall(__NR_perf_event_open, &attribute, 0, -1, group_descriptor, 0));
+		}
+	}
+
+	/// 为当前线程打开计数器
+	ThreadHardwareCounters::ThreadHardwareCounters()
+	{
+		Descriptors.fill(-1);
+
+		for (std::size_t index = 0; index < EventConfigs.size(); ++index)
+		{
+			Descriptors[index] = OpenCounter(EventConfigs[index], index == 0 ? -1 : Descriptors[0]);
+			if (Descriptors[index] < 0)
+			{
+				// 任意一个事件不可用则放弃整组，以免各阶段的计数含义不一致
+				for (auto& descriptor : Descriptors)
+				{
+					if (descriptor >= 0) ::close(descriptor);
+					descriptor = -1;
+				}
+				return;
+			}
+		}
+
+		GroupDescriptor = Descriptors[0];
+	}
+
+	/// 关闭计数器
+	ThreadHardwareCounters::~ThreadHardwareCounters()
+	{
+		for (auto descriptor : Descriptors)
+		{
+			if (descriptor >= 0) ::close(descriptor);
+		}
+	}
+
+	/// 读取计数值
+	bool ThreadHardwareCounters::AddTo(HardwareCounterValues &values) const noexcept
+	{
+		if (!IsAvailable()) return false;
+
+		// 组读取格式：事件数量，随后为各事件的计数值
+		std::array<std::uint64_t, 1 + static_cast<std::size_t>(HardwareEvent::Count)> buffer {};
+		auto read_size = ::read(GroupDescriptor, buffer.data(), sizeof(buffer));
+		if (read_size != static_cast<ssize_t>(sizeof(buffer)) || buffer[0] != values.size()) return false;
+
+		for (std::size_t index = 0; index < values.size(); ++index)
+		{
+			values[index] += buffer[index + 1];
+		}
+		return true;
+	}
+
+	/// 获取全局实例
+	HardwareCounterRegistry& HardwareCounterRegistry::GetInstance()
+	{
+		static HardwareCounterRegistry instance;
+		return instance;
+	}
+
+	/// 析构并停止观察
+	HardwareCounterRegistry::~HardwareCounterRegistry()
+	{
+		Observer.observe(false);
+	}
+
+	/// 启用计数器
+	bool HardwareCounterRegistry::Enable()
+	{
+		if (IsEnabled()) return true;
+
+		// 先在当前线程上验证系统是否允许打开计数器
+		auto counters = std::make_unique<ThreadHardwareCounters>();
+		if (!counters->IsAvailable()) return false;
+
+		{
+			std::unique_lock lock(ThreadsMutex);
+			Threads.push_back(std::move(counters));
+		}
+		CurrentThreadRegistered = true;
+
+		Enabled = true;
+		Observer.observe(true);
+		return true;
+	}
+
+	/// 为当前线程注册计数器
+	void HardwareCounterRegistry::RegisterCurrentThread()
+	{
+		if (CurrentThreadRegistered || !IsEnabled()) return;
+		CurrentThreadRegistered = true;
+
+		auto counters = std::make_unique<ThreadHardwareCounters>();
+		if (!counters->IsAvailable()) return;
+
+		std::unique_lock lock(ThreadsMutex);
+		Threads.push_back(std::move(counters));
+	}
+
+	/// 读取全部线程的计数之和
+	void HardwareCounterRegistry::ReadAll(HardwareCounterValues &values)
+	{
+		values.fill(0);
+
+		std::unique_lock lock(ThreadsMutex);
+		for (const auto& counters : Threads)
+		{
+			counters->AddTo(values);
+		}
+	}
+}
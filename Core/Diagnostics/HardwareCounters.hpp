@@ -0,0 +1,138 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <tbb/task_scheduler_observer.h>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/// 硬件事件
+	enum class HardwareEvent : std::size_t
+	{
+		/// CPU周期
+		Cycles,
+		/// 退休的指令
+		Instructions,
+		/// 末级缓存未命中
+		CacheMisses,
+		/// 分支预测失败
+		BranchMisses,
+		/// 事件数量，不是有效的事件
+		Count
+	};
+
+	/// 各硬件事件的计数值
+	using HardwareCounterValues = std::array<std::uint64_t, static_cast<std::size_t>(HardwareEvent::Count)>;
+
+	/**
+	 * @brief 线程硬件计数器
+	 * @author Vincent
+	 * @details
+	 *  ~ 使用perf_event_open为构造时所在的线程打开一组硬件计数器，只统计用户态事件。
+	 *  ~ 计数器文件描述符可以由任意线程读取，读取一组计数器只需一次系统调用。
+	 */
+	class ThreadHardwareCounters
+	{
+	protected:
+		/// 计数器组的组长文件描述符
+		int GroupDescriptor {-1};
+		/// 组内其余计数器的文件描述符
+		std::array<int, static_cast<std::size_t>(HardwareEvent::Count)> Descriptors {};
+
+	public:
+		/// 为当前线程打开计数器，失败时IsAvailable返回false
+		ThreadHardwareCounters();
+		/// 关闭计数器
+		~ThreadHardwareCounters();
+
+		ThreadHardwareCounters(const ThreadHardwareCounters&) = delete;
+		ThreadHardwareCounters& operator=(const ThreadHardwareCounters&) = delete;
+
+		/// 计数器是否可用
+		[[nodiscard]] inline bool IsAvailable() const noexcept
+		{
+			return GroupDescriptor >= 0;
+		}
+
+		/**
+		 * @brief 读取计数值
+		 * @param values 计数值将被累加到其中
+		 * @retval true 当读取成功
+		 * @retval false 当计数器不可用或读取失败
+		 */
+		bool AddTo(HardwareCounterValues& values) const noexcept;
+	};
+
+	/**
+	 * @brief 硬件计数器注册表
+	 * @author Vincent
+	 * @details
+	 *  ~ 注册表为启用时所在的线程与所有进入TBB调度器的工作线程打开硬件计数器，
+	 *    并可以读取全部线程的计数之和，从而将并行任务的开销也计入其所属的阶段。
+	 *  ~ 注册表默认关闭；内核的perf_event_paranoid设定过高时将无法启用。
+	 */
+	class HardwareCounterRegistry
+	{
+	protected:
+		/// TBB调度器观察者，在工作线程进入调度器时为其注册计数器
+		class WorkerObserver : public tbb::task_scheduler_observer
+		{
+		protected:
+			/// 所属的注册表
+			HardwareCounterRegistry& Registry;
+
+		public:
+			/// 构造并绑定注册表
+			explicit WorkerObserver(HardwareCounterRegistry& registry) : Registry(registry)
+			{}
+
+			/// 线程进入调度器
+			void on_scheduler_entry(bool) override
+			{
+				Registry.RegisterCurrentThread();
+			}
+		};
+
+		/// 是否已经启用
+		std::atomic_bool Enabled {false};
+		/// 线程计数器列表互斥量
+		std::mutex ThreadsMutex;
+		/// 所有已注册线程的计数器
+		std::vector<std::unique_ptr<ThreadHardwareCounters>> Threads;
+		/// 工作线程观察者
+		WorkerObserver Observer {*this};
+
+	public:
+		/// 获取全局实例
+		static HardwareCounterRegistry& GetInstance();
+
+		/// 析构并停止观察
+		~HardwareCounterRegistry();
+
+		/**
+		 * @brief 启用计数器
+		 * @retval true 当当前线程的计数器成功打开
+		 * @retval false 当系统不支持或权限不足，此时注册表保持关闭
+		 */
+		bool Enable();
+
+		/// 是否已经启用
+		[[nodiscard]] inline bool IsEnabled() const noexcept
+		{
+			return Enabled.load(std::memory_order_relaxed);
+		}
+
+		/// 为当前线程注册计数器，已注册的线程不会重复注册
+		void RegisterCurrentThread();
+
+		/**
+		 * @brief 读取全部线程的计数之和
+		 * @param values 计数值，将被覆盖
+		 */
+		void ReadAll(HardwareCounterValues& values);
+	};
+}
@@ -0,0 +1,40 @@
+#include "HardwareStatistics.hpp"
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/// 获取快照
+	HardwareSnapshot HardwareAccumulator::TakeSnapshot(bool reset) noexcept
+	{
+		HardwareSnapshot snapshot;
+
+		if (reset)
+		{
+			snapshot.Samples = Samples.exchange(0, std::memory_order_relaxed);
+			for (std::size_t index = 0; index < Totals.size(); ++index)
+			{
+				snapshot.Totals[index] = Totals[index].exchange(0, std::memory_order_relaxed);
+			}
+		}
+		else
+		{
+			snapshot.Samples = Samples.load(std::memory_order_relaxed);
+			for (std::size_t index = 0; index < Totals.size(); ++index)
+			{
+				snapshot.Totals[index] = Totals[index].load(std::memory_order_relaxed);
+			}
+		}
+
+		return snapshot;
+	}
+
+	/// 获取所有阶段的统计快照
+	auto HardwareStatistics::TakeSnapshot(bool reset) -> Snapshot
+	{
+		Snapshot snapshot;
+		for (std::size_t index = 0; index < StageStatistics::StageCount; ++index)
+		{
+			snapshot[index] = Accumulators[index].TakeSnapshot(reset);
+		}
+		return snapshot;
+	}
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "HardwareCounters.hpp"
+#include "StageStatistics.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/// 硬件计数统计快照
+	struct HardwareSnapshot
+	{
+		/// 样本数，即阶段执行的次数
+		std::uint64_t Samples {0};
+		/// 各硬件事件的计数总和
+		HardwareCounterValues Totals {};
+
+		/// 获取单个样本的平均计数
+		[[nodiscard]] inline double GetAverage(HardwareEvent event) const noexcept
+		{
+			return Samples == 0 ? 0.0 :
+				static_cast<double>(Totals[static_cast<std::size_t>(event)]) / static_cast<double>(Samples);
+		}
+
+		/// 获取每周期指令数
+		[[nodiscard]] inline double GetIPC() const noexcept
+		{
+			auto cycles = Totals[static_cast<std::size_t>(HardwareEvent::Cycles)];
+			return cycles == 0 ? 0.0 :
+				static_cast<double>(Totals[static_cast<std::size_t>(HardwareEvent::Instructions)]) /
+				static_cast<double>(cycles);
+		}
+	};
+
+	/**
+	 * @brief 硬件计数累加器
+	 * @details
+	 *  ~ 累加操作只有数次宽松原子加法，可以由任意线程并发调用。
+	 */
+	class HardwareAccumulator
+	{
+	protected:
+		/// 样本数
+		std::atomic<std::uint64_t> Samples {0};
+		/// 各硬件事件的计数总和
+		std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(HardwareEvent::Count)> Totals {};
+
+	public:
+		/// 累加一个样本
+		inline void Add(const HardwareCounterValues& delta) noexcept
+		{
+			for (std::size_t index = 0; index < Totals.size(); ++index)
+			{
+				Totals[index].fetch_add(delta[index], std::memory_order_relaxed);
+			}
+			Samples.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief 获取快照
+		 * @param reset 是否在获取快照的同时清空
+		 * @return 快照
+		 */
+		HardwareSnapshot TakeSnapshot(bool reset = false) noexcept;
+	};
+
+	/**
+	 * @brief 硬件计数统计
+	 * @author Vincent
+	 * @details
+	 *  ~ 该类为每个被统计的阶段持有一个硬件计数累加器，阶段的划分与阶段统计一致。
+	 */
+	class HardwareStatistics
+	{
+	public:
+		/// 各阶段的统计快照
+		using Snapshot = std::array<HardwareSnapshot, StageStatistics::StageCount>;
+
+	protected:
+		/// 各阶段的累加器
+		std::array<HardwareAccumulator, StageStatistics::StageCount> Accumulators;
+
+	public:
+		/// 获取阶段的累加器
+		inline HardwareAccumulator& operator[](StageIdentifier stage) noexcept
+		{
+			return Accumulators[static_cast<std::size_t>(stage)];
+		}
+
+		/**
+		 * @brief 获取所有阶段的统计快照
+		 * @param reset 是否在获取快照的同时清空
+		 * @return 各阶段的统计快照，以阶段标识符的值为索引
+		 */
+		Snapshot TakeSnapshot(bool reset = false);
+	};
+}
@@ -0,0 +1,63 @@
+#include "LatencyHistogram.hpp"
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/// 获取统计快照
+	LatencySnapshot LatencyHistogram::TakeSnapshot(bool reset)
+	{
+		LatencySnapshot snapshot;
+
+		// 先拷贝各桶的计数，以保证分位数计算所用的数据是一致的
+		std::array<std::uint64_t, BucketCount> counts {};
+		std::uint64_t total_count {0};
+		for (std::size_t index = 0; index < BucketCount; ++index)
+		{
+			counts[index] = reset ? Buckets[index].exchange(0, std::memory_order_relaxed)
+					: Buckets[index].load(std::memory_order_relaxed);
+			total_count += counts[index];
+		}
+		auto total_value = reset ? TotalValue.exchange(0, std::memory_order_relaxed)
+				: TotalValue.load(std::memory_order_relaxed);
+		snapshot.Max = reset ? MaxValue.exchange(0, std::memory_order_relaxed)
+				: MaxValue.load(std::memory_order_relaxed);
+		if (reset)
+		{
+			TotalCount.exchange(0, std::memory_order_relaxed);
+		}
+
+		snapshot.Count = total_count;
+		if (total_count == 0) return snapshot;
+
+		snapshot.Mean = total_value / total_count;
+
+		// 各分位数所对应的样本序号，序号从1开始
+		const std::uint64_t p50_rank = (total_count * 50 + 99) / 100;
+		const std::uint64_t p90_rank = (total_count * 90 + 99) / 100;
+		const std::uint64_t p99_rank = (total_count * 99 + 99) / 100;
+
+		std::uint64_t accumulated_count {0};
+		for (std::size_t index = 0; index < BucketCount; ++index)
+		{
+			if (counts[index] == 0) continue;
+
+			auto previous_count = accumulated_count;
+			accumulated_count += counts[index];
+			auto value = GetBucketValue(index);
+
+			if (previous_count < p50_rank && accumulated_count >= p50_rank) snapshot.P50 = value;
+			if (previous_count < p90_rank && accumulated_count >= p90_rank) snapshot.P90 = value;
+			if (previous_count < p99_rank && accumulated_count >= p99_rank)
+			{
+				snapshot.P99 = value;
+				break;
+			}
+		}
+
+		// 分位数为桶的中值，可能略大于真实的最大值
+		if (snapshot.P50 > snapshot.Max) snapshot.P50 = snapshot.Max;
+		if (snapshot.P90 > snapshot.Max) snapshot.P90 = snapshot.Max;
+		if (snapshot.P99 > snapshot.Max) snapshot.P99 = snapshot.Max;
+
+		return snapshot;
+	}
+}
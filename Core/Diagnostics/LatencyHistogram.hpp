@@ -0,0 +1,161 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/**
+	 * @brief 延迟统计快照
+	 * @details
+	 *  ~ 时间单位均为纳秒，分位数为所在桶的中值，相对误差不超过约3%。
+	 */
+	struct LatencySnapshot
+	{
+		/// 样本数
+		std::uint64_t Count {0};
+		/// 平均值
+		std::uint64_t Mean {0};
+		/// 50%分位数
+		std::uint64_t P50 {0};
+		/// 90%分位数
+		std::uint64_t P90 {0};
+		/// 99%分位数
+		std::uint64_t P99 {0};
+		/// 最大值
+		std::uint64_t Max {0};
+	};
+
+	/**
+	 * @brief 延迟直方图
+	 * @author Vincent
+	 * @details
+	 *  ~ 该直方图采用对数-线性分桶（与HDR直方图相同的思路）：每个2的幂区间被等分为32个桶，
+	 *    故在1纳秒至约68秒的范围内相对误差不超过约3%，超出范围的值计入最后一个桶。
+	 *  ~ 内存大小固定，记录操作只有数次宽松原子加法，不加锁，可以由任意线程并发调用。
+	 */
+	class LatencyHistogram
+	{
+	public:
+		/// 每个2的幂区间的子桶数量的位数
+		static constexpr unsigned int SubBucketBits = 5;
+		/// 每个2的幂区间的子桶数量
+		static constexpr std::uint64_t SubBucketCount = 1ull << SubBucketBits;
+		/// 可以表示的最大值的位数
+		static constexpr unsigned int MaxValueBits = 36;
+		/// 桶的总数
+		static constexpr std::size_t BucketCount = (MaxValueBits - SubBucketBits + 1) * SubBucketCount;
+
+	protected:
+		/// 各桶的计数
+		std::array<std::atomic<std::uint64_t>, BucketCount> Buckets {};
+		/// 样本总数
+		std::atomic<std::uint64_t> TotalCount {0};
+		/// 样本总和
+		std::atomic<std::uint64_t> TotalValue {0};
+		/// 最大值
+		std::atomic<std::uint64_t> MaxValue {0};
+
+	public:
+		/**
+		 * @brief 获取值所在的桶的索引
+		 * @param value 值
+		 * @return 桶索引
+		 */
+		static constexpr std::size_t GetBucketIndex(std::uint64_t value) noexcept
+		{
+			if (value < SubBucketCount) return static_cast<std::size_t>(value);
+
+			auto highest_bit = 63u - static_cast<unsigned int>(__builtin_clzll(value));
+			if (highest_bit >= MaxValueBits) return BucketCount - 1;
+
+			auto shift = highest_bit - SubBucketBits;
+			return static_cast<std::size_t>((shift + 1) * SubBucketCount + ((value >> shift) - SubBucketCount));
+		}
+
+		/**
+		 * @brief 获取桶的代表值
+		 * @param index 桶索引
+		 * @return 桶所表示的区间的中值
+		 */
+		static constexpr std::uint64_t GetBucketValue(std::size_t index) noexcept
+		{
+			if (index < 2 * SubBucketCount) return index;
+
+			auto shift = index / SubBucketCount - 1;
+			auto lower_bound = (index % SubBucketCount + SubBucketCount) << shift;
+			return lower_bound + ((1ull << shift) >> 1u);
+		}
+
+		/**
+		 * @brief 记录一个样本
+		 * @param value 值，单位为纳秒
+		 */
+		inline void Record(std::uint64_t value) noexcept
+		{
+			Buckets[GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+			TotalCount.fetch_add(1, std::memory_order_relaxed);
+			TotalValue.fetch_add(value, std::memory_order_relaxed);
+
+			auto current_max = MaxValue.load(std::memory_order_relaxed);
+			while (value > current_max &&
+				!MaxValue.compare_exchange_weak(current_max, value, std::memory_order_relaxed))
+			{}
+		}
+
+		/**
+		 * @brief 记录一个时长样本
+		 * @param duration 时长
+		 */
+		template<typename Representation, typename Period>
+		inline void Record(std::chrono::duration<Representation, Period> duration) noexcept
+		{
+			auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+			Record(static_cast<std::uint64_t>(nanoseconds > 0 ? nanoseconds : 0));
+		}
+
+		/**
+		 * @brief 获取统计快照
+		 * @param reset 是否在获取快照的同时清空直方图，用于获取周期性的区间统计
+		 * @return 统计快照
+		 * @details
+		 *  ~ 清空与并发的记录操作之间没有同步，少量样本可能被计入相邻的区间。
+		 */
+		LatencySnapshot TakeSnapshot(bool reset = false);
+	};
+
+	/**
+	 * @brief 延迟计时域
+	 * @author Vincent
+	 * @details
+	 *  ~ 构造时开始计时，析构时将经过的时长记录到直方图中。
+	 */
+	class LatencyScope
+	{
+	protected:
+		/// 目标直方图
+		LatencyHistogram& Histogram;
+		/// 开始时间
+		std::chrono::steady_clock::time_point BeginTime;
+
+	public:
+		/**
+		 * @brief 开始计时
+		 * @param histogram 目标直方图
+		 */
+		explicit LatencyScope(LatencyHistogram& histogram) noexcept :
+			Histogram(histogram), BeginTime(std::chrono::steady_clock::now())
+		{}
+
+		/// 结束计时并记录
+		~LatencyScope()
+		{
+			Histogram.Record(std::chrono::steady_clock::now() - BeginTime);
+		}
+
+		LatencyScope(const LatencyScope&) = delete;
+		LatencyScope& operator=(const LatencyScope&) = delete;
+	};
+}
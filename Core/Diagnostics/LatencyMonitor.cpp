@@ -0,0 +1,37 @@
+#include "LatencyMonitor.hpp"
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/// 设置相机时间戳频率
+	void LatencyMonitor::SetTickFrequency(unsigned long long frequency) noexcept
+	{
+		TickPeriod = frequency > 0 ? 1e9 / static_cast<double>(frequency) : 0.0;
+		MinimumOffset = std::numeric_limits<std::int64_t>::max();
+	}
+
+	/// 记录帧开始处理
+	void LatencyMonitor::OnProcessBegin(const Frame& frame) noexcept
+	{
+		if (TickPeriod > 0.0 && frame.SensorTimeStamp != 0)
+		{
+			auto receive_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+					frame.ReceiveTime.time_since_epoch()).count();
+			auto offset = static_cast<std::int64_t>(receive_time) -
+					static_cast<std::int64_t>(static_cast<double>(frame.SensorTimeStamp) * TickPeriod);
+
+			if (offset < MinimumOffset)
+			{
+				MinimumOffset = offset;
+			}
+			Statistics[StageIdentifier::CaptureToCallback].Record(static_cast<std::uint64_t>(offset - MinimumOffset));
+		}
+
+		Statistics[StageIdentifier::CallbackToProcess].Record(frame.ProcessBeginTime - frame.ReceiveTime);
+	}
+
+	/// 记录帧的结果已写入串口
+	void LatencyMonitor::OnSerialWritten(const Frame& frame, std::chrono::steady_clock::time_point write_time) noexcept
+	{
+		Statistics[StageIdentifier::ProcessToSerial].Record(write_time - frame.ProcessBeginTime);
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "StageStatistics.hpp"
+#include "../Frames/Frame.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/**
+	 * @brief 延迟监视器
+	 * @author Vincent
+	 * @details
+	 *  ~ 该类根据帧上的相机时间戳与单调时钟时间，将采集、处理与发送之间的延迟记录到阶段统计中。
+	 *  ~ 相机时钟与主机时钟之间的偏移是未知的，故采集延迟以观测到的最小偏移为基准，
+	 *    记录的是相对于最快的一帧多出的延迟，可以反映传输与驱动引入的抖动。
+	 *  ~ 监视器只应当在处理线程中使用。
+	 */
+	class LatencyMonitor
+	{
+	protected:
+		/// 阶段统计
+		StageStatistics& Statistics;
+
+		/// 相机时钟每个计数对应的纳秒数，为零则不记录采集延迟
+		double TickPeriod {0.0};
+		/// 观测到的最小的主机时间与相机时间之差，单位为纳秒
+		std::int64_t MinimumOffset {std::numeric_limits<std::int64_t>::max()};
+
+	public:
+		/**
+		 * @brief 构造并绑定阶段统计
+		 * @param statistics 阶段统计
+		 */
+		explicit LatencyMonitor(StageStatistics& statistics) noexcept : Statistics(statistics)
+		{}
+
+		/**
+		 * @brief 设置相机时间戳频率
+		 * @param frequency 相机时间戳每秒的计数值，为零则不记录采集延迟
+		 * @details
+		 *  ~ 设置时将清空已观测到的最小偏移。
+		 */
+		void SetTickFrequency(unsigned long long frequency) noexcept;
+
+		/**
+		 * @brief 记录帧开始处理
+		 * @param frame 已填充时间部分的帧
+		 * @details
+		 *  ~ 记录采集延迟与开始处理前的等待延迟。
+		 */
+		void OnProcessBegin(const Frame& frame) noexcept;
+
+		/**
+		 * @brief 记录帧的结果已写入串口
+		 * @param frame 帧
+		 * @param write_time 写入完毕的时间
+		 */
+		void OnSerialWritten(const Frame& frame,
+					   std::chrono::steady_clock::time_point write_time = std::chrono::steady_clock::now()) noexcept;
+	};
+}
@@ -0,0 +1,38 @@
+#include "StageStatistics.hpp"
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/// 获取阶段名称
+	const char* StageStatistics::GetName(StageIdentifier stage) noexcept
+	{
+		switch (stage)
+		{
+			case StageIdentifier::CaptureWait: return "CaptureWait";
+			case StageIdentifier::Debayer: return "Debayer";
+			case StageIdentifier::Cut: return "Cut";
+			case StageIdentifier::Upload: return "Upload";
+			case StageIdentifier::Color: return "Color";
+			case StageIdentifier::Detect: return "Detect";
+			case StageIdentifier::Match: return "Match";
+			case StageIdentifier::Select: return "Select";
+			case StageIdentifier::Predict: return "Predict";
+			case StageIdentifier::Serial: return "Serial";
+			case StageIdentifier::CaptureToCallback: return "Capture>Call";
+			case StageIdentifier::CallbackToProcess: return "Call>Process";
+			case StageIdentifier::ProcessToSerial: return "Process>Send";
+			case StageIdentifier::EndToEnd: return "EndToEnd";
+			default: return "Unknown";
+		}
+	}
+
+	/// 获取所有阶段的统计快照
+	auto StageStatistics::TakeSnapshot(bool reset) -> Snapshot
+	{
+		Snapshot snapshot;
+		for (std::size_t index = 0; index < StageCount; ++index)
+		{
+			snapshot[index] = Histograms[index].TakeSnapshot(reset);
+		}
+		return snapshot;
+	}
+}
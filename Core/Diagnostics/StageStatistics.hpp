@@ -0,0 +1,85 @@
+#pragma once
+
+#include "LatencyHistogram.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/// 被统计的阶段
+	enum class StageIdentifier : std::size_t
+	{
+		/// 等待相机图像
+		CaptureWait,
+		/// Bayer转换
+		Debayer,
+		/// 裁剪
+		Cut,
+		/// 上传至显存
+		Upload,
+		/// 颜色过滤
+		Color,
+		/// 灯条检测
+		Detect,
+		/// 装甲板匹配
+		Match,
+		/// 装甲板选择
+		Select,
+		/// 目标预测
+		Predict,
+		/// 串口发送
+		Serial,
+		/// 从相机曝光到采集回调被触发，为相对于观测到的最小值的延迟
+		CaptureToCallback,
+		/// 从采集回调被触发到开始处理
+		CallbackToProcess,
+		/// 从开始处理到串口写入完毕
+		ProcessToSerial,
+		/// 端到端，即从取得图像到发送完毕
+		EndToEnd,
+		/// 阶段数量，不是有效的阶段
+		Count
+	};
+
+	/**
+	 * @brief 阶段统计
+	 * @author Vincent
+	 * @details
+	 *  ~ 该类为每个被统计的阶段持有一个延迟直方图。
+	 */
+	class StageStatistics
+	{
+	public:
+		/// 阶段数量
+		static constexpr std::size_t StageCount = static_cast<std::size_t>(StageIdentifier::Count);
+
+		/// 各阶段的统计快照
+		using Snapshot = std::array<LatencySnapshot, StageCount>;
+
+	protected:
+		/// 各阶段的直方图
+		std::array<LatencyHistogram, StageCount> Histograms;
+
+	public:
+		/**
+		 * @brief 获取阶段名称
+		 * @param stage 阶段
+		 * @return 阶段名称
+		 */
+		static const char* GetName(StageIdentifier stage) noexcept;
+
+		/// 获取阶段的直方图
+		inline LatencyHistogram& operator[](StageIdentifier stage) noexcept
+		{
+			return Histograms[static_cast<std::size_t>(stage)];
+		}
+
+		/**
+		 * @brief 获取所有阶段的统计快照
+		 * @param reset 是否在获取快照的同时清空直方图
+		 * @return 各阶段的统计快照，以阶段标识符的值为索引
+		 */
+		Snapshot TakeSnapshot(bool reset = false);
+	};
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "LatencyHistogram.hpp"
+#include "StageStatistics.hpp"
+
+#include <array>
+#include <chrono>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	class Frame;
+
+	/**
+	 * @brief 统计钩子
+	 * @tparam Capacity 可绑定的最大阶段数
+	 * @author Vincent
+	 * @details
+	 *  ~ 该钩子将流水线中各阶段的耗时记录到绑定的直方图中，未绑定的阶段不计时。
+	 *  ~ 单个阶段的开销为两次单调时钟读取与数次宽松原子加法，远小于阶段本身的耗时。
+	 */
+	template<std::size_t Capacity = 16>
+	class StatisticsHook
+	{
+	protected:
+		/// 各流水线阶段所绑定的直方图
+		std::array<LatencyHistogram*, Capacity> Histograms {};
+		/// 当前阶段的开始时间
+		std::chrono::steady_clock::time_point BeginTime;
+
+	public:
+		/**
+		 * @brief 将流水线阶段绑定到直方图
+		 * @param stage_index 阶段在流水线中的索引
+		 * @param histogram 直方图，为空则解除绑定
+		 */
+		void Bind(std::size_t stage_index, LatencyHistogram* histogram)
+		{
+			Histograms.at(stage_index) = histogram;
+		}
+
+		/// 阶段开始执行
+		template<std::size_t Index, typename Stage>
+		inline void OnStageBegin(Frame&) noexcept
+		{
+			static_assert(Index < Capacity, "StatisticsHook capacity is smaller than the stage count.");
+			if (Histograms[Index])
+			{
+				BeginTime = std::chrono::steady_clock::now();
+			}
+		}
+
+		/// 阶段执行完毕
+		template<std::size_t Index, typename Stage>
+		inline void OnStageEnd(Frame&) noexcept
+		{
+			if (auto* histogram = Histograms[Index])
+			{
+				histogram->Record(std::chrono::steady_clock::now() - BeginTime);
+			}
+		}
+	};
+}
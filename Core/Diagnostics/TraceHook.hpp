@@ -0,0 +1,57 @@
+#pragma once
+
+#include "TraceRecorder.hpp"
+#include "../Frames/Frame.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/**
+	 * @brief 追踪钩子
+	 * @tparam Capacity 可绑定的最大阶段数
+	 * @author Vincent
+	 * @details
+	 *  ~ 该钩子将流水线中各阶段的起止时间以绑定的名称记录到追踪记录器中，未绑定名称的阶段不记录。
+	 *  ~ 追踪关闭时，每个阶段只有一次宽松原子读取的开销。
+	 */
+	template<std::size_t Capacity = 16>
+	class TraceHook
+	{
+	protected:
+		/// 各流水线阶段所绑定的事件名称
+		std::array<const char*, Capacity> Names {};
+		/// 当前阶段的开始时间，为零表示当前阶段不记录
+		std::uint64_t BeginTime {0};
+
+	public:
+		/**
+		 * @brief 为流水线阶段绑定事件名称
+		 * @param stage_index 阶段在流水线中的索引
+		 * @param name 事件名称，应当为静态字符串，为空则解除绑定
+		 */
+		void Bind(std::size_t stage_index, const char* name)
+		{
+			Names.at(stage_index) = name;
+		}
+
+		/// 阶段开始执行
+		template<std::size_t Index, typename Stage>
+		inline void OnStageBegin(Frame&) noexcept
+		{
+			static_assert(Index < Capacity, "TraceHook capacity is smaller than the stage count.");
+			BeginTime = Names[Index] && TraceRecorder::GetInstance().IsEnabled() ? TraceRecorder::Now() : 0;
+		}
+
+		/// 阶段执行完毕
+		template<std::size_t Index, typename Stage>
+		inline void OnStageEnd(Frame& frame) noexcept
+		{
+			if (BeginTime != 0)
+			{
+				TraceRecorder::GetInstance().Record(Names[Index], BeginTime, TraceRecorder::Now(), frame.Index);
+			}
+		}
+	};
+}
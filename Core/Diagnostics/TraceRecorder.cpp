@@ -0,0 +1,182 @@
+#include "TraceRecorder.hpp"
+
+#include <stdexcept>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/// 获取全局实例
+	TraceRecorder& TraceRecorder::GetInstance()
+	{
+		static TraceRecorder instance;
+		return instance;
+	}
+
+	/// 析构并停止追踪
+	TraceRecorder::~TraceRecorder()
+	{
+		Stop();
+	}
+
+	/// 获取当前线程的缓冲区
+	auto TraceRecorder::GetThreadBuffer() -> ThreadBuffer&
+	{
+		thread_local ThreadBuffer* current_buffer {nullptr};
+
+		if (!current_buffer)
+		{
+			auto buffer = std::make_unique<ThreadBuffer>();
+			buffer->ThreadID = static_cast<std::uint32_t>(::syscall(SYS_gettid));
+			current_buffer = buffer.get();
+
+			std::unique_lock lock(BuffersMutex);
+			Buffers.push_back(std::move(buffer));
+		}
+		return *current_buffer;
+	}
+
+	/// 记录事件
+	void TraceRecorder::Record(const char *name, std::uint64_t begin_time, std::uint64_t end_time,
+							std::uint64_t frame_index) noexcept
+	{
+		if (!IsEnabled()) return;
+
+		ThreadBuffer* buffer;
+		try
+		{
+			buffer = &GetThreadBuffer();
+		}
+		catch (...)
+		{
+			return;
+		}
+
+		auto write_count = buffer->WriteCount.load(std::memory_order_relaxed);
+		auto read_count = buffer->ReadCount.load(std::memory_order_acquire);
+		if (write_count - read_count >= BufferCapacity)
+		{
+			buffer->DroppedCount.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		auto& event = buffer->Events[write_count % BufferCapacity];
+		event.Name = name;
+		event.BeginTime = begin_time;
+		event.EndTime = end_time;
+		event.FrameIndex = frame_index;
+
+		buffer->WriteCount.store(write_count + 1, std::memory_order_release);
+	}
+
+	/// 开始追踪
+	void TraceRecorder::Start(const std::string &path, std::chrono::milliseconds duration)
+	{
+		std::unique_lock control_lock(ControlMutex);
+
+		if (File) return;
+
+		File = std::fopen(path.c_str(), "w");
+		if (!File)
+		{
+			throw std::runtime_error("[TraceRecorder::Start] Failed to Open Trace File: " + path);
+		}
+		std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", File);
+		FirstEvent = true;
+
+		// 丢弃开始之前残留的事件
+		{
+			std::unique_lock lock(BuffersMutex);
+			for (auto& buffer : Buffers)
+			{
+				buffer->ReadCount.store(buffer->WriteCount.load(std::memory_order_acquire), std::memory_order_release);
+				buffer->DroppedCount.store(0, std::memory_order_relaxed);
+			}
+		}
+
+		StopTime = duration.count() > 0 ?
+				Now() + static_cast<std::uint64_t>(std::chrono::nanoseconds(duration).count()) : 0;
+
+		Enabled = true;
+		Flushing = true;
+		FlushThread = std::thread(&TraceRecorder::RunFlusher, this);
+	}
+
+	/// 停止追踪
+	void TraceRecorder::Stop()
+	{
+		std::unique_lock control_lock(ControlMutex);
+
+		Enabled = false;
+		Flushing = false;
+		if (FlushThread.joinable())
+		{
+			FlushThread.join();
+		}
+
+		if (File)
+		{
+			// 写出正在进行中的记录操作所产生的最后一批事件
+			Flush();
+
+			std::uint64_t dropped_count {0};
+			{
+				std::unique_lock lock(BuffersMutex);
+				for (auto& buffer : Buffers)
+				{
+					dropped_count += buffer->DroppedCount.load(std::memory_order_relaxed);
+				}
+			}
+
+			std::fprintf(File, "\n],\"otherData\":{\"droppedEvents\":%llu}}\n",
+				static_cast<unsigned long long>(dropped_count));
+			std::fclose(File);
+			File = nullptr;
+		}
+	}
+
+	/// 写出事件
+	void TraceRecorder::Flush()
+	{
+		std::unique_lock lock(BuffersMutex);
+
+		for (auto& buffer : Buffers)
+		{
+			auto read_count = buffer->ReadCount.load(std::memory_order_relaxed);
+			auto write_count = buffer->WriteCount.load(std::memory_order_acquire);
+
+			for (; read_count != write_count; ++read_count)
+			{
+				const auto& event = buffer->Events[read_count % BufferCapacity];
+
+				// 完整事件，时间单位为微秒
+				std::fprintf(File, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+					   "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%llu}}",
+					   FirstEvent ? "" : ",\n", event.Name, buffer->ThreadID,
+					   static_cast<double>(event.BeginTime) / 1000.0,
+					   static_cast<double>(event.EndTime - event.BeginTime) / 1000.0,
+					   static_cast<unsigned long long>(event.FrameIndex));
+				FirstEvent = false;
+			}
+
+			buffer->ReadCount.store(read_count, std::memory_order_release);
+		}
+	}
+
+	/// 后台写出线程主循环
+	void TraceRecorder::RunFlusher()
+	{
+		while (Flushing)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+			if (StopTime != 0 && Now() >= StopTime)
+			{
+				// 到期后不再接收新事件，剩余事件由Stop写出
+				Enabled = false;
+			}
+
+			Flush();
+		}
+	}
+}
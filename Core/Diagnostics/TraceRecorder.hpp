@@ -0,0 +1,178 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/**
+	 * @brief 追踪记录器
+	 * @author Vincent
+	 * @details
+	 *  ~ 记录器将各阶段与TBB任务的起止时间记录到每个线程独立的环形缓冲区中，
+	 *    并由后台线程周期性地将其写出为Chrome追踪格式的JSON文件，可以直接在
+	 *    chrome://tracing或Perfetto中打开。
+	 *  ~ 追踪默认关闭，关闭时记录操作只有一次宽松原子读取的开销。
+	 *  ~ 环形缓冲区写满（后台线程来不及写出）时，新的事件将被丢弃并计数。
+	 */
+	class TraceRecorder
+	{
+	public:
+		/// 追踪事件
+		struct Event
+		{
+			/// 事件名称，应当为静态字符串
+			const char* Name {nullptr};
+			/// 开始时间，单位为纳秒
+			std::uint64_t BeginTime {0};
+			/// 结束时间，单位为纳秒
+			std::uint64_t EndTime {0};
+			/// 所属帧序号
+			std::uint64_t FrameIndex {0};
+		};
+
+		/// 每个线程的环形缓冲区可容纳的事件数量
+		static constexpr std::size_t BufferCapacity = 1u << 14u;
+
+	protected:
+		/// 线程缓冲区，由所属线程单独写入，由后台线程单独读取
+		struct ThreadBuffer
+		{
+			/// 线程号
+			std::uint32_t ThreadID {0};
+			/// 事件环
+			std::array<Event, BufferCapacity> Events;
+			/// 已写入的事件总数
+			std::atomic<std::uint64_t> WriteCount {0};
+			/// 已读取的事件总数
+			std::atomic<std::uint64_t> ReadCount {0};
+			/// 因缓冲区已满而丢弃的事件数
+			std::atomic<std::uint64_t> DroppedCount {0};
+		};
+
+		/// 线程缓冲区列表互斥量
+		std::mutex BuffersMutex;
+		/// 所有线程的缓冲区，线程退出后缓冲区依然保留
+		std::vector<std::unique_ptr<ThreadBuffer>> Buffers;
+
+		/// 是否正在追踪
+		std::atomic_bool Enabled {false};
+		/// 后台写出线程是否应当继续运行
+		std::atomic_bool Flushing {false};
+		/// 后台写出线程
+		std::thread FlushThread;
+		/// 控制互斥量，保护启动与停止
+		std::mutex ControlMutex;
+
+		/// 输出文件
+		std::FILE* File {nullptr};
+		/// 是否尚未写出任何事件
+		bool FirstEvent {true};
+		/// 自动停止的时间，为零表示不自动停止
+		std::uint64_t StopTime {0};
+
+		/// 获取当前线程的缓冲区，首次调用时创建
+		ThreadBuffer& GetThreadBuffer();
+
+		/// 将所有缓冲区中的事件写出
+		void Flush();
+
+		/// 后台写出线程主循环
+		void RunFlusher();
+
+	public:
+		/// 获取全局实例
+		static TraceRecorder& GetInstance();
+
+		/// 获取当前单调时钟时间，单位为纳秒
+		static inline std::uint64_t Now() noexcept
+		{
+			return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+		/// 析构，若正在追踪则将停止
+		~TraceRecorder();
+
+		/**
+		 * @brief 是否正在追踪
+		 * @retval true 当正在追踪
+		 * @retval false 当追踪关闭
+		 */
+		[[nodiscard]] inline bool IsEnabled() const noexcept
+		{
+			return Enabled.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief 开始追踪
+		 * @param path 输出文件路径
+		 * @param duration 追踪时长，到期后自动停止，为零则持续追踪至调用Stop
+		 */
+		void Start(const std::string& path, std::chrono::milliseconds duration = std::chrono::milliseconds(0));
+
+		/// 停止追踪，写出剩余的事件并关闭文件
+		void Stop();
+
+		/**
+		 * @brief 记录事件
+		 * @param name 事件名称，应当为静态字符串
+		 * @param begin_time 开始时间，单位为纳秒
+		 * @param end_time 结束时间，单位为纳秒
+		 * @param frame_index 所属帧序号
+		 */
+		void Record(const char* name, std::uint64_t begin_time, std::uint64_t end_time,
+			  std::uint64_t frame_index) noexcept;
+	};
+
+	/**
+	 * @brief 追踪域
+	 * @author Vincent
+	 * @details
+	 *  ~ 构造时记录开始时间，析构时记录一个完整的事件；追踪关闭时不做任何事。
+	 */
+	class TraceScope
+	{
+	protected:
+		/// 事件名称
+		const char* Name;
+		/// 所属帧序号
+		std::uint64_t FrameIndex;
+		/// 开始时间
+		std::uint64_t BeginTime {0};
+		/// 构造时是否正在追踪
+		bool Active;
+
+	public:
+		/**
+		 * @brief 开始追踪域
+		 * @param name 事件名称，应当为静态字符串
+		 * @param frame_index 所属帧序号
+		 */
+		TraceScope(const char* name, std::uint64_t frame_index) noexcept :
+			Name(name), FrameIndex(frame_index), Active(TraceRecorder::GetInstance().IsEnabled())
+		{
+			if (Active) BeginTime = TraceRecorder::Now();
+		}
+
+		/// 结束追踪域并记录事件
+		~TraceScope()
+		{
+			if (Active)
+			{
+				TraceRecorder::GetInstance().Record(Name, BeginTime, TraceRecorder::Now(), FrameIndex);
+			}
+		}
+
+		TraceScope(const TraceScope&) = delete;
+		TraceScope& operator=(const TraceScope&) = delete;
+	};
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/**
+	 * @brief 三重缓冲区
+	 * @tparam Value 值类型
+	 * @author Vincent
+	 * @details
+	 *  ~ 用于在一个写入线程与一个读取线程之间传递最新值：写入方在后台缓冲区上写入后将其与中间缓冲区交换，
+	 *    读取方在有新值时将前台缓冲区与中间缓冲区交换；双方均只有一次原子交换，互不等待。
+	 *  ~ 读取方只能看到最新的值，写入方写入得更快时中间的值将被覆盖。
+	 */
+	template<typename Value>
+	class TripleBuffer
+	{
+	protected:
+		/// 缓冲区索引掩码
+		static constexpr std::uint8_t IndexMask = 0x3;
+		/// 中间缓冲区含有新值的标志
+		static constexpr std::uint8_t DirtyFlag = 0x4;
+
+		/// 缓冲区
+		std::array<Value, 3> Buffers {};
+		/// 中间缓冲区的索引与新值标志
+		std::atomic<std::uint8_t> Middle {1};
+		/// 写入方持有的后台缓冲区索引
+		std::uint8_t Back {0};
+		/// 读取方持有的前台缓冲区索引
+		std::uint8_t Front {2};
+
+	public:
+		/// 获取写入方的后台缓冲区，只能由写入线程调用
+		inline Value& GetWriteBuffer() noexcept
+		{
+			return Buffers[Back];
+		}
+
+		/// 发布后台缓冲区中的值，只能由写入线程调用
+		inline void Publish() noexcept
+		{
+			auto previous = Middle.exchange(static_cast<std::uint8_t>(Back | DirtyFlag), std::memory_order_acq_rel);
+			Back = previous & IndexMask;
+		}
+
+		/// 写入并发布值，只能由写入线程调用
+		inline void Write(const Value& value)
+		{
+			GetWriteBuffer() = value;
+			Publish();
+		}
+
+		/**
+		 * @brief 获取最新的值，只能由读取线程调用
+		 * @retval true 当前台缓冲区被更新为新的值
+		 * @retval false 当没有新的值
+		 */
+		inline bool Update() noexcept
+		{
+			if (!(Middle.load(std::memory_order_relaxed) & DirtyFlag)) return false;
+
+			auto previous = Middle.exchange(Front, std::memory_order_acq_rel);
+			Front = previous & IndexMask;
+			return true;
+		}
+
+		/// 获取读取方的前台缓冲区，只能由读取线程调用
+		[[nodiscard]] inline const Value& GetReadBuffer() const noexcept
+		{
+			return Buffers[Front];
+		}
+	};
+}
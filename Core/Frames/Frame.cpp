@@ -0,0 +1,15 @@
+#include "Frame.hpp"
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/// 预分配缓冲区
+	void Frame::Reserve(const cv::Size &max_size, bool gpu)
+	{
+		OriginalPicture.create(max_size, CV_8UC3);
+		BinaryBuffer.create(max_size, CV_8UC1);
+		if (gpu)
+		{
+			GpuBuffer.create(max_size, CV_8UC3);
+		}
+	}
+}
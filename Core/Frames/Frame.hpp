@@ -0,0 +1,127 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <tuple>
+#include <tbb/tbb.h>
+#include <opencv4/opencv2/opencv.hpp>
+#include <opencv4/opencv2/core/cuda.hpp>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/**
+	 * @brief 目标信息
+	 * @details
+	 *  ~ 该结构体存储装甲板选择器的输出结果。
+	 *  ~ 输出的装甲板坐标是加上兴趣区坐标偏移的坐标。
+	 */
+	struct TargetInformation
+	{
+		/// 是否找到目标
+		bool Found {false};
+
+		/// 装甲板中心点横坐标
+		int X {};
+		/// 装甲板中心点纵坐标
+		int Y {};
+		/**
+		 * @brief 根据高度和比例系数估算的距离
+		 * @details
+		 *  ~ 单位为厘米，但精度是米级。
+		 */
+		int Distance {};
+
+		/// 兴趣区域
+		cv::Rect InterestedArea;
+	};
+
+	/**
+	 * @brief 帧
+	 * @author Vincent
+	 * @details
+	 *  ~ 帧持有单次处理过程中所需的全部图像缓冲区、各阶段的输出与结果字节包，
+	 *    各处理阶段从帧上读取输入并将输出写回帧上。
+	 *  ~ 缓冲区按照最大兴趣区（即全屏）尺寸预先分配，处理过程中只在其上截取视图，
+	 *    因而稳态下处理一帧不会发生堆分配。
+	 */
+	class Frame
+	{
+	public:
+		/// 结果字节包大小
+		static constexpr std::size_t PacketSize = 15;
+
+		/// 帧序号，由帧池在取出时分配
+		unsigned long long Index {0};
+		/**
+		 * @brief 上一帧
+		 * @details
+		 *  ~ 由帧池在取出时指定，用于读取上一帧的结果，如上一帧的兴趣区。
+		 */
+		const Frame* Previous {nullptr};
+
+		//==============================
+		// 时间部分
+		//==============================
+
+		/// 相机给出的帧号
+		unsigned long long SensorFrameID {0};
+		/// 相机给出的时间戳，单位为相机时钟的计数值
+		unsigned long long SensorTimeStamp {0};
+		/// 采集回调被触发的时间
+		std::chrono::steady_clock::time_point ReceiveTime;
+		/// 开始处理的时间
+		std::chrono::steady_clock::time_point ProcessBeginTime;
+
+		//==============================
+		// 图像部分
+		//==============================
+
+		/// 原始Bayer图像，通常为相机数据上的视图
+		cv::Mat RawPicture;
+		/// 由Bayer原始数据转换而来的BGR图像，尺寸固定为全屏
+		cv::Mat OriginalPicture;
+		/// 裁剪后的图像，为原始图像上的视图
+		cv::Mat CuttingPicture;
+		/// 裁剪图像相对于全屏的位置偏移
+		cv::Point PositionOffset;
+		/// 上传至显存的裁剪图像，为显存缓冲区上的视图
+		cv::cuda::GpuMat GpuPicture;
+		/// 颜色蒙版图像，为蒙版缓冲区上的视图
+		cv::Mat BinaryPicture;
+
+		//==============================
+		// 结果部分
+		//==============================
+
+		/// 可能的灯条矩形
+		tbb::concurrent_vector<cv::RotatedRect> LightBars;
+		/// 装甲板列表
+		tbb::concurrent_vector<std::tuple<cv::RotatedRect, cv::RotatedRect>> Armors;
+		/// 选择的目标
+		TargetInformation Target;
+		/// 外推至预期执行时刻的目标，由目标预测器给出
+		TargetInformation PredictedTarget;
+		/// PredictedTarget所描述的时刻，外推时为预期执行时刻，未外推时等于ReceiveTime
+		std::chrono::steady_clock::time_point PredictedTime;
+
+		/// 待发送的结果字节包
+		std::array<unsigned char, PacketSize> Packet {};
+
+		//==============================
+		// 缓冲区部分
+		//==============================
+
+		/// 显存图像缓冲区
+		cv::cuda::GpuMat GpuBuffer;
+		/// 蒙版图像缓冲区
+		cv::Mat BinaryBuffer;
+
+	public:
+		/**
+		 * @brief 按照最大尺寸预分配缓冲区
+		 * @param max_size 最大图像尺寸
+		 * @param gpu 是否分配显存缓冲区，仅使用CPU的流水线可以不分配
+		 */
+		void Reserve(const cv::Size& max_size, bool gpu = true);
+	};
+}
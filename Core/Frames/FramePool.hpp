@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Frame.hpp"
+
+#include <array>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/**
+	 * @brief 帧池
+	 * @tparam Count 帧的数量
+	 * @author Vincent
+	 * @details
+	 *  ~ 帧池持有固定数量的预分配帧，并以轮转的方式依次取出复用。
+	 *  ~ 被取出的帧在此后第Count次取出前都不会被复用，
+	 *    故可以在其上保留结果供其他线程在该期限内读取。
+	 */
+	template<std::size_t Count>
+	class FramePool
+	{
+		static_assert(Count > 0, "FramePool requires at least one frame.");
+
+	protected:
+		/// 帧数组
+		std::array<Frame, Count> Frames;
+
+		/// 下一个被取出的帧的位置
+		std::size_t Cursor {0};
+		/// 已经取出的帧的总数
+		unsigned long long AcquiredCount {0};
+
+	public:
+		/**
+		 * @brief 预分配所有帧的缓冲区
+		 * @param max_size 最大图像尺寸
+		 * @param gpu 是否分配显存缓冲区
+		 */
+		void Reserve(const cv::Size& max_size, bool gpu = true)
+		{
+			for (auto& frame : Frames)
+			{
+				frame.Reserve(max_size, gpu);
+			}
+		}
+
+		/**
+		 * @brief 获取下一个被取出的帧的序号
+		 * @return 下一次调用Acquire时赋予帧的序号
+		 */
+		[[nodiscard]] unsigned long long GetNextIndex() const noexcept
+		{
+			return AcquiredCount + 1;
+		}
+
+		/**
+		 * @brief 取出下一个帧
+		 * @return 帧的引用，其序号与上一帧指针将被更新
+		 */
+		Frame& Acquire()
+		{
+			auto& frame = Frames[Cursor];
+			frame.Previous = &Frames[(Cursor + Count - 1) % Count];
+			Cursor = (Cursor + 1) % Count;
+			frame.Index = ++AcquiredCount;
+			return frame;
+		}
+	};
+}
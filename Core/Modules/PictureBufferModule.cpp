@@ -0,0 +1,26 @@
+#include "PictureBufferModule.hpp"
+
+#include <algorithm>
+
+namespace RoboPioneers::Modules
+{
+	/// 获取内存缓冲区上的视图
+	cv::Mat PictureBufferModule::GetView(cv::Mat &buffer, const cv::Size &size, int type)
+	{
+		if (buffer.empty() || buffer.type() != type || buffer.cols < size.width || buffer.rows < size.height)
+		{
+			buffer.create(std::max(buffer.rows, size.height), std::max(buffer.cols, size.width), type);
+		}
+		return buffer(cv::Rect(cv::Point(0, 0), size));
+	}
+
+	/// 获取显存缓冲区上的视图
+	cv::cuda::GpuMat PictureBufferModule::GetView(cv::cuda::GpuMat &buffer, const cv::Size &size, int type)
+	{
+		if (buffer.empty() || buffer.type() != type || buffer.cols < size.width || buffer.rows < size.height)
+		{
+			buffer.create(std::max(buffer.rows, size.height), std::max(buffer.cols, size.width), type);
+		}
+		return buffer(cv::Rect(cv::Point(0, 0), size));
+	}
+}
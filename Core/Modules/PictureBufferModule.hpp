@@ -0,0 +1,36 @@
+#pragma once
+
+#include <opencv4/opencv2/opencv.hpp>
+#include <opencv4/opencv2/core/cuda.hpp>
+
+namespace RoboPioneers::Modules
+{
+	/**
+	 * @brief 图片缓冲区模块
+	 * @author Vincent
+	 * @details
+	 *  ~ 该静态类提供在预分配的缓冲区上截取指定尺寸视图的方法。
+	 *  ~ 缓冲区仅在容量不足或类型不符时才会重新分配，稳态下不发生堆分配。
+	 */
+	class PictureBufferModule
+	{
+	public:
+		/**
+		 * @brief 获取内存缓冲区上的视图
+		 * @param buffer 缓冲区，容量不足时将被重新分配
+		 * @param size 视图尺寸
+		 * @param type 像素类型
+		 * @return 缓冲区左上角的指定尺寸的视图
+		 */
+		static cv::Mat GetView(cv::Mat& buffer, const cv::Size& size, int type);
+
+		/**
+		 * @brief 获取显存缓冲区上的视图
+		 * @param buffer 缓冲区，容量不足时将被重新分配
+		 * @param size 视图尺寸
+		 * @param type 像素类型
+		 * @return 缓冲区左上角的指定尺寸的视图
+		 */
+		static cv::cuda::GpuMat GetView(cv::cuda::GpuMat& buffer, const cv::Size& size, int type);
+	};
+}
@@ -0,0 +1,218 @@
+#pragma once
+
+#include "Slots.hpp"
+#include "PipelineHooks.hpp"
+#include "../Frames/Frame.hpp"
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	namespace SlotTraits
+	{
+		/**
+		 * @brief 阶段组合检查器
+		 * @tparam AvailableSlots 已经可用的槽
+		 * @tparam StageTypes 尚未检查的阶段
+		 * @details
+		 *  ~ 依次检查每个阶段所需的输入槽是否已由数据源或此前的阶段提供。
+		 */
+		template<typename AvailableSlots, typename... StageTypes>
+		struct StageChecker
+		{
+			static constexpr bool Value = true;
+		};
+
+		template<typename AvailableSlots, typename FirstStage, typename... RestStages>
+		struct StageChecker<AvailableSlots, FirstStage, RestStages...>
+		{
+			static_assert(ContainsAll<AvailableSlots, typename FirstStage::InputSlots>::value,
+					"Pipeline stage requires a slot that neither the source nor any previous stage provides.");
+
+			static constexpr bool Value = StageChecker<
+			        typename Concatenate<AvailableSlots, typename FirstStage::OutputSlots>::Type,
+			        RestStages...>::Value;
+		};
+	}
+
+	namespace StageTraits
+	{
+		/// 判断阶段是否提供Reset()方法
+		template<typename StageType, typename = void>
+		struct HasReset : std::false_type
+		{};
+
+		template<typename StageType>
+		struct HasReset<StageType, std::void_t<decltype(std::declval<StageType&>().Reset())>> : std::true_type
+		{};
+	}
+
+	/**
+	 * @brief 流水线
+	 * @tparam SourceSlots 数据源在执行前已经填充的槽
+	 * @tparam Hook 阶段钩子类型，如NullHook
+	 * @tparam StageTypes 阶段类型，按照执行顺序排列
+	 * @author Vincent
+	 * @details
+	 *  ~ 流水线在编译期组合各阶段，并检查每个阶段的输入槽都已经由数据源或此前的阶段提供。
+	 *  ~ 阶段需要声明InputSlots与OutputSlots两个槽列表类型，并提供Execute(Frame&)方法。
+	 *  ~ 各阶段以静态方式调用，不经过虚函数或指针；钩子为空时不产生额外开销。
+	 *  ~ 流水线记录正在执行的阶段，阶段抛出异常时可据此判断故障所在的阶段，
+	 *    该阶段的OnStageEnd钩子仍会在异常传出前被调用；
+	 *    阶段可以提供Reset()方法，用于在故障后丢弃其跨帧保留的状态。
+	 */
+	template<typename SourceSlots, typename Hook, typename... StageTypes>
+	class Pipeline
+	{
+		static_assert(sizeof...(StageTypes) > 0, "Pipeline requires at least one stage.");
+		static_assert(SlotTraits::StageChecker<SourceSlots, StageTypes...>::Value);
+
+	public:
+		/// 阶段数量
+		static constexpr std::size_t StageCount = sizeof...(StageTypes);
+
+		/// 阶段元组
+		std::tuple<StageTypes...> Stages;
+		/// 阶段钩子
+		Hook Hooks;
+
+	protected:
+		/// 正在执行的阶段索引，不在执行中时为StageCount
+		std::size_t CurrentStage {StageCount};
+
+	public:
+		/**
+		 * @brief 按类型获取阶段
+		 * @tparam StageType 阶段类型，在流水线中应当唯一
+		 * @return 阶段的引用
+		 */
+		template<typename StageType>
+		StageType& Get()
+		{
+			return std::get<StageType>(Stages);
+		}
+
+		/**
+		 * @brief 按索引获取阶段
+		 * @tparam Index 阶段索引
+		 * @return 阶段的引用
+		 */
+		template<std::size_t Index>
+		auto Get() -> std::tuple_element_t<Index, std::tuple<StageTypes...>>&
+		{
+			return std::get<Index>(Stages);
+		}
+
+		/**
+		 * @brief 获取阶段在流水线中的索引
+		 * @tparam StageType 阶段类型，应当在流水线中
+		 * @return 第一个该类型的阶段的索引
+		 */
+		template<typename StageType>
+		static constexpr std::size_t IndexOf()
+		{
+			constexpr std::size_t index = FindStageIndex<StageType>();
+			static_assert(index < StageCount, "Stage is not part of the pipeline.");
+			return index;
+		}
+
+		/**
+		 * @brief 在帧上依次执行所有阶段
+		 * @param frame 帧，其上的源数据槽应当已经填充
+		 */
+		inline void Execute(Frame& frame)
+		{
+			ExecuteStages(frame, std::index_sequence_for<StageTypes...>{});
+			CurrentStage = StageCount;
+		}
+
+		/**
+		 * @brief 获取正在执行的阶段索引
+		 * @return 阶段索引；执行被异常中断时为抛出异常的阶段，不在执行中时为StageCount
+		 */
+		[[nodiscard]] inline std::size_t GetCurrentStage() const noexcept
+		{
+			return CurrentStage;
+		}
+
+		/// 清除被异常中断时保留的阶段索引
+		inline void ClearCurrentStage() noexcept
+		{
+			CurrentStage = StageCount;
+		}
+
+		/**
+		 * @brief 按索引重置阶段
+		 * @param index 阶段索引
+		 * @retval true 当该阶段提供了Reset()方法并已被重置
+		 * @retval false 当索引无效或该阶段没有可重置的状态
+		 */
+		bool ResetStage(std::size_t index)
+		{
+			return ResetStages(index, std::index_sequence_for<StageTypes...>{});
+		}
+
+	protected:
+		/// 查找阶段的索引，找不到则返回StageCount
+		template<typename StageType>
+		static constexpr std::size_t FindStageIndex()
+		{
+			constexpr bool matches[] = {std::is_same_v<StageType, StageTypes>...};
+			for (std::size_t index = 0; index < StageCount; ++index)
+			{
+				if (matches[index]) return index;
+			}
+			return StageCount;
+		}
+
+		/// 重置索引对应的阶段
+		template<std::size_t... Indices>
+		bool ResetStages(std::size_t index, std::index_sequence<Indices...>)
+		{
+			bool reset = false;
+			([&]{
+				using StageType = std::tuple_element_t<Indices, std::tuple<StageTypes...>>;
+				if constexpr (StageTraits::HasReset<StageType>::value)
+				{
+					if (index == Indices)
+					{
+						std::get<Indices>(Stages).Reset();
+						reset = true;
+					}
+				}
+			}(), ...);
+			return reset;
+		}
+
+		/// 依次执行所有阶段
+		template<std::size_t... Indices>
+		inline void ExecuteStages(Frame& frame, std::index_sequence<Indices...>)
+		{
+			(ExecuteStage<Indices>(frame), ...);
+		}
+
+		/// 执行单个阶段，并在其前后调用钩子
+		template<std::size_t Index>
+		inline void ExecuteStage(Frame& frame)
+		{
+			using StageType = std::tuple_element_t<Index, std::tuple<StageTypes...>>;
+
+			CurrentStage = Index;
+			Hooks.template OnStageBegin<Index, StageType>(frame);
+			try
+			{
+				std::get<Index>(Stages).Execute(frame);
+			}
+			catch (...)
+			{
+				// 阶段抛出异常时仍结束钩子，以免分配归属、追踪事件和计数采样停留在该阶段；
+				// CurrentStage保持不变，供故障处理确定出错的阶段
+				Hooks.template OnStageEnd<Index, StageType>(frame);
+				throw;
+			}
+			Hooks.template OnStageEnd<Index, StageType>(frame);
+		}
+	};
+}
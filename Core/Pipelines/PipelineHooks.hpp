@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	class Frame;
+
+	/**
+	 * @brief 空钩子
+	 * @author Vincent
+	 * @details
+	 *  ~ 流水线在每个阶段执行前后都会调用钩子的OnStageBegin与OnStageEnd方法。
+	 *  ~ 该钩子的方法均为空的内联函数，编译后不产生任何开销。
+	 */
+	struct NullHook
+	{
+		/// 阶段开始执行
+		template<std::size_t Index, typename Stage>
+		inline void OnStageBegin(Frame&) noexcept
+		{}
+
+		/// 阶段执行完毕
+		template<std::size_t Index, typename Stage>
+		inline void OnStageEnd(Frame&) noexcept
+		{}
+	};
+
+	/**
+	 * @brief 秒表钩子
+	 * @tparam Capacity 可记录的最大阶段数
+	 * @author Vincent
+	 * @details
+	 *  ~ 该钩子记录最近一次执行中每个阶段的耗时，用于对流水线进行简单的计时与比较。
+	 */
+	template<std::size_t Capacity = 16>
+	class StopwatchHook
+	{
+	protected:
+		/// 当前阶段的开始时间
+		std::chrono::steady_clock::time_point BeginTime;
+
+	public:
+		/// 最近一次执行中各阶段的耗时
+		std::array<std::chrono::steady_clock::duration, Capacity> Durations {};
+
+		/// 阶段开始执行，记录开始时间
+		template<std::size_t Index, typename Stage>
+		inline void OnStageBegin(Frame&) noexcept
+		{
+			static_assert(Index < Capacity, "StopwatchHook capacity is smaller than the stage count.");
+			BeginTime = std::chrono::steady_clock::now();
+		}
+
+		/// 阶段执行完毕，记录耗时
+		template<std::size_t Index, typename Stage>
+		inline void OnStageEnd(Frame&) noexcept
+		{
+			Durations[Index] = std::chrono::steady_clock::now() - BeginTime;
+		}
+	};
+
+	/**
+	 * @brief 钩子组
+	 * @tparam Hooks 组合在一起的钩子类型
+	 * @author Vincent
+	 * @details
+	 *  ~ 钩子组按照声明顺序依次调用各个钩子的OnStageBegin，并按照相反的顺序调用OnStageEnd，
+	 *    从而使先声明的钩子所测量的区间包含后声明的钩子的开销。
+	 */
+	template<typename... Hooks>
+	class HookGroup
+	{
+	protected:
+		/// 组中的钩子
+		std::tuple<Hooks...> Members;
+
+		/// 按照相反的顺序调用各钩子的OnStageEnd
+		template<std::size_t Index, typename Stage, std::size_t... HookIndices>
+		inline void InvokeStageEnd(Frame& frame, std::index_sequence<HookIndices...>) noexcept
+		{
+			(std::get<sizeof...(Hooks) - 1 - HookIndices>(Members).template OnStageEnd<Index, Stage>(frame), ...);
+		}
+
+	public:
+		/// 获取组中指定类型的钩子
+		template<typename Hook>
+		Hook& Get() noexcept
+		{
+			return std::get<Hook>(Members);
+		}
+
+		/// 阶段开始执行
+		template<std::size_t Index, typename Stage>
+		inline void OnStageBegin(Frame& frame) noexcept
+		{
+			std::apply([&frame](auto&... hooks){
+				(hooks.template OnStageBegin<Index, Stage>(frame), ...);
+			}, Members);
+		}
+
+		/// 阶段执行完毕
+		template<std::size_t Index, typename Stage>
+		inline void OnStageEnd(Frame& frame) noexcept
+		{
+			InvokeStageEnd<Index, Stage>(frame, std::index_sequence_for<Hooks...>{});
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <type_traits>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/**
+	 * @brief 槽列表
+	 * @tparam SlotTypes 槽类型
+	 * @details
+	 *  ~ 槽描述帧上的一项数据，处理阶段通过槽列表声明其读取与写入的数据，
+	 *    流水线据此在编译期检查阶段的组合是否合法。
+	 */
+	template<typename... SlotTypes>
+	struct SlotList
+	{};
+
+	/// 帧上的数据槽
+	namespace Slots
+	{
+		/// 原始Bayer图像
+		struct RawPicture {};
+		/// 上一帧的目标信息
+		struct PreviousTarget {};
+		/// 转换后的BGR图像
+		struct OriginalPicture {};
+		/// 裁剪后的图像
+		struct CuttingPicture {};
+		/// 裁剪图像的位置偏移
+		struct PositionOffset {};
+		/// 显存中的裁剪图像
+		struct GpuPicture {};
+		/// 颜色蒙版图像
+		struct BinaryPicture {};
+		/// 灯条列表
+		struct LightBars {};
+		/// 装甲板列表
+		struct Armors {};
+		/// 目标信息
+		struct Target {};
+		/// 外推至执行时刻的目标信息
+		struct PredictedTarget {};
+	}
+
+	/// 槽列表相关的编译期工具
+	namespace SlotTraits
+	{
+		/// 判断槽列表中是否包含指定槽
+		template<typename List, typename Slot>
+		struct Contains;
+
+		template<typename Slot, typename... SlotTypes>
+		struct Contains<SlotList<SlotTypes...>, Slot> : std::disjunction<std::is_same<Slot, SlotTypes>...>
+		{};
+
+		/// 判断槽列表中是否包含另一槽列表中的全部槽
+		template<typename List, typename RequiredList>
+		struct ContainsAll;
+
+		template<typename List, typename... RequiredSlots>
+		struct ContainsAll<List, SlotList<RequiredSlots...>> : std::conjunction<Contains<List, RequiredSlots>...>
+		{};
+
+		/// 连接两个槽列表
+		template<typename FirstList, typename SecondList>
+		struct Concatenate;
+
+		template<typename... FirstSlots, typename... SecondSlots>
+		struct Concatenate<SlotList<FirstSlots...>, SlotList<SecondSlots...>>
+		{
+			using Type = SlotList<FirstSlots..., SecondSlots...>;
+		};
+	}
+}
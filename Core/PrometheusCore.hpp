@@ -1,7 +1,7 @@
+#include "PrometheusCoreCPU.hpp"
+
+#include "Stages/PictureUploader.hpp"
 #include "Stages/ColorFilter.hpp"
-#include "Stages/LightBarDetector.hpp"
-#include "Stages/ArmorMatcher.hpp"
-#include "Stages/ArmorSelector.hpp"
 
 namespace RoboPioneers::Prometheus::Core
-{}
\ No newline at end of file
+{}
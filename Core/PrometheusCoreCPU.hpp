@@ -0,0 +1,30 @@
+#include "Frames/Frame.hpp"
+#include "Frames/FramePool.hpp"
+
+#include "Pipelines/Slots.hpp"
+#include "Pipelines/PipelineHooks.hpp"
+#include "Pipelines/Pipeline.hpp"
+
+#include "Diagnostics/LatencyHistogram.hpp"
+#include "Diagnostics/StageStatistics.hpp"
+#include "Diagnostics/StatisticsHook.hpp"
+#include "Diagnostics/LatencyMonitor.hpp"
+#include "Diagnostics/HardwareCounters.hpp"
+#include "Diagnostics/HardwareStatistics.hpp"
+#include "Diagnostics/HardwareCounterHook.hpp"
+#include "Diagnostics/AllocationAccounting.hpp"
+#include "Diagnostics/AllocationHook.hpp"
+#include "Diagnostics/TripleBuffer.hpp"
+#include "Diagnostics/TraceRecorder.hpp"
+#include "Diagnostics/TraceHook.hpp"
+#include "Diagnostics/FaultMonitor.hpp"
+
+#include "Stages/BayerConverter.hpp"
+#include "Stages/CPUColorFilter.hpp"
+#include "Stages/LightBarDetector.hpp"
+#include "Stages/ArmorMatcher.hpp"
+#include "Stages/ArmorSelector.hpp"
+#include "Stages/TargetPredictor.hpp"
+
+namespace RoboPioneers::Prometheus::Core
+{}
\ No newline at end of file
@@ -1,23 +1,25 @@
 #include "ArmorMatcher.hpp"
 
 #include "../Modules/GeometryFeatureModule.hpp"
+#include "../Diagnostics/TraceRecorder.hpp"
+#include "../Diagnostics/AllocationAccounting.hpp"
 
 namespace RoboPioneers::Prometheus::Core
 {
 	/// 执行方法
-	void ArmorMatcher::Execute()
+	void ArmorMatcher::Execute(Frame& frame)
 	{
-		auto& light_bars = *LightBars;
+		auto& light_bars = frame.LightBars;
 
 		unsigned int max_result_count = (light_bars.size() * (light_bars.size() - 1) + 1) / 2;
 
-		// 候选组合，提前将组合准备就绪，以便后续进行多线程判断
-		tbb::concurrent_vector<std::tuple<cv::RotatedRect, cv::RotatedRect>> candidate_pairs;
-		candidate_pairs.reserve(max_result_count);
+		// 候选组合，提前将组合准备就绪，以便后续进行多线程判断；并发向量的清空不会释放内存
+		CandidatePairs.clear();
+		CandidatePairs.reserve(max_result_count);
 
 		// 清空结果
-		Armors.clear();
-		Armors.reserve(max_result_count);
+		frame.Armors.clear();
+		frame.Armors.reserve(max_result_count);
 
 		// 串行地制作候选列表
 		for (auto first_index = light_bars.begin(); first_index != light_bars.end(); ++first_index)
@@ -31,14 +33,13 @@ namespace RoboPioneers::Prometheus::Core
 			{
 				auto second_rectangle = *second_index;
 
-				candidate_pairs.emplace_back(first_rectangle, second_rectangle);
+				CandidatePairs.emplace_back(first_rectangle, second_rectangle);
 			}
 		}
 
-		// 并行地进行判断
-		tbb::parallel_for_each(candidate_pairs, [this, armors = &this->Armors](
+		// 判断单个候选组合
+		auto match_candidate = [this, armors = &frame.Armors](
 				const std::tuple<cv::RotatedRect, cv::RotatedRect>& candidate){
-
 			auto first_rectangle = std::get<0>(candidate);
 			auto second_rectangle = std::get<1>(candidate);
 
@@ -93,6 +94,19 @@ namespace RoboPioneers::Prometheus::Core
 			if (!big_armor_wd_matched && !small_armor_wd_matched) return;
 
 			armors->emplace_back(first_rectangle, second_rectangle);
+		};
+
+		// 并行地进行判断，候选组合的数量为灯条数的平方级，故每个任务区间只记录一个追踪事件；
+		// 工作线程上的分配以发起线程的阶段统计
+		tbb::parallel_for(tbb::blocked_range<std::size_t>(0, CandidatePairs.size()),
+			[this, &match_candidate, frame_index = frame.Index,
+			 allocation_stage = AllocationAccounting::GetCurrentStage()](const tbb::blocked_range<std::size_t>& range){
+				AllocationAccounting::StageScope allocation_scope(allocation_stage);
+				TraceScope trace_scope("MatchTask", frame_index);
+				for (auto index = range.begin(); index != range.end(); ++index)
+				{
+					match_candidate(CandidatePairs[index]);
+				}
 		});
 	}
 }
\ No newline at end of file
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "../Frames/Frame.hpp"
+#include "../Pipelines/Slots.hpp"
+
 #include <opencv4/opencv2/opencv.hpp>
 #include <list>
 #include <tuple>
@@ -16,10 +19,14 @@ namespace RoboPioneers::Prometheus::Core
 	class ArmorMatcher
 	{
 	public:
-		/// 灯条列表
-		tbb::concurrent_vector<cv::RotatedRect>* LightBars;
-		/// 装甲板列表
-		tbb::concurrent_vector<std::tuple<cv::RotatedRect, cv::RotatedRect>> Armors;
+		/// 输入槽
+		using InputSlots = SlotList<Slots::LightBars>;
+		/// 输出槽
+		using OutputSlots = SlotList<Slots::Armors>;
+
+	protected:
+		/// 候选组合，跨帧复用以保留容量
+		tbb::concurrent_vector<std::tuple<cv::RotatedRect, cv::RotatedRect>> CandidatePairs;
 
 	public:
 		/// 最大转角偏差值
@@ -46,6 +53,6 @@ namespace RoboPioneers::Prometheus::Core
 		int MaxWidthDistanceRatioSmallArmor = 20;
 
 		/// 执行
-		void Execute();
+		void Execute(Frame& frame);
 	};
 }
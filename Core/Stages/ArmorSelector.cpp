@@ -1,9 +1,13 @@
 #include "ArmorSelector.hpp"
 
 #include "../Modules/GeometryFeatureModule.hpp"
+#include "../Diagnostics/TraceRecorder.hpp"
+#include "../Diagnostics/AllocationAccounting.hpp"
 
 #include <tbb/tbb.h>
 #include <cmath>
+#include <array>
+#include <limits>
 
 #ifdef DEBUG
 #include <iostream>
@@ -14,7 +18,8 @@ namespace RoboPioneers::Prometheus::Core
 	using RotatedRectPair = std::tuple<cv::RotatedRect, cv::RotatedRect>;
 
 	/// 计算装甲板得分
-	double ArmorSelector::GetArmorScore(const std::tuple<cv::RotatedRect, cv::RotatedRect>& armor) const
+	double ArmorSelector::GetArmorScore(const std::tuple<cv::RotatedRect, cv::RotatedRect>& armor,
+									 const cv::Point& position_offset) const
 	{
 		auto first_light = Modules::GeometryFeatureModule::StandardizeRotatedRectangle(std::get<0>(armor));
 		auto second_light = Modules::GeometryFeatureModule::StandardizeRotatedRectangle(std::get<1>(armor));
@@ -23,7 +28,7 @@ namespace RoboPioneers::Prometheus::Core
 		auto width = first_light.Length > second_light.Length ? first_light.Length : second_light.Length;
 
 		auto center_point = (first_light.Center + second_light.Center) / 2;
-		auto real_center_point = center_point + *PositionOffset;
+		auto real_center_point = center_point + position_offset;
 		auto real_offset = cv::norm(real_center_point - (cv::Point(ScreenWidth, ScreenHeight) / 2));
 
 		auto score = static_cast<long>(length * width / (real_offset * real_offset));
@@ -38,44 +43,53 @@ namespace RoboPioneers::Prometheus::Core
 			+ DistanceHeightConstantItem);
 	}
 
-	void ArmorSelector::Execute()
+	void ArmorSelector::Execute(Frame& frame)
 	{
-		if (Armors->empty())
+		auto& target = frame.Target;
+
+		if (frame.Armors.empty())
 		{
-			// 直接设置未找到，不更新兴趣区，由外部程序自行决定
-			Found = false;
+			// 沿用上一帧的目标信息并设置未找到，不更新兴趣区，由外部程序自行决定
+			if (frame.Previous)
+			{
+				target = frame.Previous->Target;
+			}
+			target.Found = false;
 
 			return;
 		}
 		else
 		{
-			using scored_pair = std::tuple<double, RotatedRectPair>;
-
-			// 更坏比较器
-			struct worse_comparer
-			{
-				// 该操作符返回true，则a会排到b的后方
-				bool operator () (const scored_pair& a, const scored_pair& b)
-				{
-					return std::get<0>(a) < std::get<0>(b);
-				}
-			};
-
-			// 计算过分数的装甲板队列
-			tbb::concurrent_priority_queue<scored_pair, worse_comparer> scored_armors;
-
-			// 并行地计算分数并放入优先级队列
-			tbb::parallel_for_each(*Armors, [this, &scored_armors](const RotatedRectPair& armor_candidate){
-				scored_armors.push({this->GetArmorScore(armor_candidate), armor_candidate});
-			});
+			// 分数与装甲板索引
+			using scored_index = std::tuple<double, std::size_t>;
+
+			// 并行地计算分数并归约出最优项，归约过程不需要额外的容器；工作线程上的分配以发起线程的阶段统计
+			auto best_scored_index = tbb::parallel_reduce(
+					tbb::blocked_range<std::size_t>(0, frame.Armors.size()),
+					scored_index {std::numeric_limits<double>::lowest(), 0},
+					[this, &frame, allocation_stage = AllocationAccounting::GetCurrentStage()](
+							const tbb::blocked_range<std::size_t>& range, scored_index best){
+						AllocationAccounting::StageScope allocation_scope(allocation_stage);
+						TraceScope trace_scope("SelectTask", frame.Index);
+						for (auto index = range.begin(); index != range.end(); ++index)
+						{
+							auto score = this->GetArmorScore(frame.Armors[index], frame.PositionOffset);
+							if (score > std::get<0>(best))
+							{
+								best = {score, index};
+							}
+						}
+						return best;
+					},
+					[](const scored_index& a, const scored_index& b){
+						return std::get<0>(a) >= std::get<0>(b) ? a : b;
+					});
 
 			//==============================
 			// 解包获取最优项
 			//==============================
 
-			scored_pair best_scored_pair;
-			while(!scored_armors.try_pop(best_scored_pair));
-			RotatedRectPair best_pair = std::get<1>(best_scored_pair);
+			const RotatedRectPair& best_pair = frame.Armors[std::get<1>(best_scored_index)];
 
 			auto& first_light = std::get<0>(best_pair);
 			auto& second_light = std::get<1>(best_pair);
@@ -86,43 +100,42 @@ namespace RoboPioneers::Prometheus::Core
 			// 计算兴趣区
 			//==============================
 
-			std::vector<cv::Point2f> armor_vertices;
-			armor_vertices.resize(8);
+			std::array<cv::Point2f, 8> armor_vertices;
 			first_light.points(&armor_vertices[0]);
 			second_light.points(&armor_vertices[4]);
 			auto armor_rectangle = cv::minAreaRect(armor_vertices).boundingRect();
 
-			auto& global_offset = *PositionOffset;
+			auto& global_offset = frame.PositionOffset;
 
 			//==============================
 			// 填充输出结果
 			//==============================
 
 			// 计算并限制兴趣区长宽
-			InterestedArea.width = armor_rectangle.width * (WidthExpandRatio + 1);
-			if (InterestedArea.width < LockingBoxMinWidth) InterestedArea.width = LockingBoxMinWidth;
-			InterestedArea.height = armor_rectangle.height * (HeightExpandRatio + 1);
-			if (InterestedArea.height < LockingBoxMinHeight) InterestedArea.height = LockingBoxMinHeight;
+			target.InterestedArea.width = armor_rectangle.width * (WidthExpandRatio + 1);
+			if (target.InterestedArea.width < LockingBoxMinWidth) target.InterestedArea.width = LockingBoxMinWidth;
+			target.InterestedArea.height = armor_rectangle.height * (HeightExpandRatio + 1);
+			if (target.InterestedArea.height < LockingBoxMinHeight) target.InterestedArea.height = LockingBoxMinHeight;
 
 			// 计算并限制兴趣区坐标
-			InterestedArea.x = global_offset.x + armor_rectangle.x - 0.5f * (InterestedArea.width - armor_rectangle.width);
-			if (InterestedArea.x < 0) InterestedArea.x = 0;
-			InterestedArea.y = global_offset.y + armor_rectangle.y - 0.5f * (InterestedArea.height - armor_rectangle.height);
-			if (InterestedArea.y < 0) InterestedArea.y = 0;
+			target.InterestedArea.x = global_offset.x + armor_rectangle.x - 0.5f * (target.InterestedArea.width - armor_rectangle.width);
+			if (target.InterestedArea.x < 0) target.InterestedArea.x = 0;
+			target.InterestedArea.y = global_offset.y + armor_rectangle.y - 0.5f * (target.InterestedArea.height - armor_rectangle.height);
+			if (target.InterestedArea.y < 0) target.InterestedArea.y = 0;
 
 			// 结合兴趣区坐标限制兴趣区长宽
-			if (InterestedArea.x + InterestedArea.width > ScreenWidth)
-				InterestedArea.width = ScreenWidth - InterestedArea.x;
-			if (InterestedArea.y + InterestedArea.height > ScreenHeight)
-				InterestedArea.height = ScreenHeight - InterestedArea.y;
+			if (target.InterestedArea.x + target.InterestedArea.width > ScreenWidth)
+				target.InterestedArea.width = ScreenWidth - target.InterestedArea.x;
+			if (target.InterestedArea.y + target.InterestedArea.height > ScreenHeight)
+				target.InterestedArea.height = ScreenHeight - target.InterestedArea.y;
 
 			// 估算距离
-			Distance = GetEstimatedDistance(armor_rectangle.height);
+			target.Distance = GetEstimatedDistance(armor_rectangle.height);
 
-			Found = true;
+			target.Found = true;
 
-			X = static_cast<int>(center_point.x) + global_offset.x;
-			Y = static_cast<int>(center_point.y) + global_offset.y;
+			target.X = static_cast<int>(center_point.x) + global_offset.x;
+			target.Y = static_cast<int>(center_point.y) + global_offset.y;
 
 			#ifdef DEBUG
 			std::cout << "Width:" << armor_rectangle.width << " Height:" << armor_rectangle.height << std::endl;
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "../Frames/Frame.hpp"
+#include "../Pipelines/Slots.hpp"
+
 #include <list>
 #include <tuple>
 #include <tbb/tbb.h>
@@ -18,28 +21,10 @@ namespace RoboPioneers::Prometheus::Core
 	class ArmorSelector
 	{
 	public:
-		/// 装甲板列表
-		tbb::concurrent_vector<std::tuple<cv::RotatedRect, cv::RotatedRect>>* Armors;
-		/// 位置偏移量
-		cv::Point2i* PositionOffset;
-
-		/// 是否找到目标
-		bool Found {false};
-
-		/// 装甲板中心点横坐标
-		int X {};
-		/// 装甲板中心点纵坐标
-		int Y {};
-		/**
-		 * @brief 根据高度和比例系数估算的距离
-		 * @details
-		 *  ~ 单位为厘米，但精度是米级。
-		 *  ~ 估算函数是个一元二次函数，所有系数都是经验值。
-		 */
-		int Distance {};
-
-		/// 兴趣区域
-		cv::Rect InterestedArea;
+		/// 输入槽
+		using InputSlots = SlotList<Slots::Armors, Slots::PositionOffset, Slots::PreviousTarget>;
+		/// 输出槽
+		using OutputSlots = SlotList<Slots::Target>;
 
 	public:
 		/// 屏幕宽度
@@ -57,9 +42,9 @@ namespace RoboPioneers::Prometheus::Core
 		/// 找到目标后，追踪框的高度扩张比例
 		double HeightExpandRatio {1.0f};
 
-		/// 距离高度二次系数 d=Ae^(-Bh)+C
+		/// 距离高度系数A d=Ae^(-Bh)+C
 		double DistanceHeightAFactor {1008.28f};
-		/// 距离高度一次系数 d=Ae^(-Bh)+C
+		/// 距离高度系数B d=Ae^(-Bh)+C
 		double DistanceHeightBFactor {0.08f};
 		/// 距离高度常数项 d=Ae^(-Bh)+C
 		double DistanceHeightConstantItem {74.43f};
@@ -67,11 +52,12 @@ namespace RoboPioneers::Prometheus::Core
 	protected:
 		/**
 		 * @brief 计算装甲板的得分
-		 * @param position_offset 当前处理的画面相对于全屏的位置偏移量
 		 * @param armor 装甲板灯条元组
+		 * @param position_offset 当前处理的画面相对于全屏的位置偏移量
 		 * @return 该装甲板得分
 		 */
-		[[nodiscard]] double GetArmorScore(const std::tuple<cv::RotatedRect, cv::RotatedRect>& armor) const;
+		[[nodiscard]] double GetArmorScore(const std::tuple<cv::RotatedRect, cv::RotatedRect>& armor,
+									 const cv::Point& position_offset) const;
 		/**
 		 * @brief 获取粗略估计的距离
 		 * @param height 灯条高度
@@ -84,8 +70,10 @@ namespace RoboPioneers::Prometheus::Core
 		/**
 		 * @brief 执行
 		 * @details
-		 *  ~ 若找到了目标，则更新目标的坐标等信息，并更新兴趣区，若未找到，则只更新Found为false，不修改其他信息。
+		 *  ~ 若找到了目标，则更新目标的坐标等信息，并更新兴趣区；
+		 *    若未找到，则沿用上一帧的目标信息，只将Found置为false。
+		 *  ~ 距离的估算函数是个指数函数，所有系数都是经验值。
 		 */
-		void Execute();
+		void Execute(Frame& frame);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,11 @@
+#include "BayerConverter.hpp"
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/// 执行方法
+	void BayerConverter::Execute(Frame &frame)
+	{
+		// 目标缓冲区尺寸与原始图像一致时，转换不会重新分配内存
+		cv::cvtColor(frame.RawPicture, frame.OriginalPicture, cv::COLOR_BayerBG2BGR);
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "../Frames/Frame.hpp"
+#include "../Pipelines/Slots.hpp"
+
+#include <opencv4/opencv2/opencv.hpp>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/**
+	 * @brief Bayer转换器
+	 * @author Vincent
+	 * @details
+	 *  ~ 该阶段将相机输出的BayerBG原始图像转换为BGR图像，写入帧上预分配的原始图像缓冲区。
+	 */
+	class BayerConverter
+	{
+	public:
+		/// 输入槽
+		using InputSlots = SlotList<Slots::RawPicture>;
+		/// 输出槽
+		using OutputSlots = SlotList<Slots::OriginalPicture>;
+
+		/// 执行
+		void Execute(Frame& frame);
+	};
+}
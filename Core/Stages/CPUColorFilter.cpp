@@ -0,0 +1,36 @@
+#include "CPUColorFilter.hpp"
+
+#include "../Modules/PictureBufferModule.hpp"
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/// 预分配缓冲区
+	void CPUColorFilter::Reserve(const cv::Size &max_size)
+	{
+		BlurredBuffer.create(max_size, CV_8UC3);
+		HSVBuffer.create(max_size, CV_8UC3);
+	}
+
+	/// 执行方法
+	void CPUColorFilter::Execute(Frame &frame)
+	{
+		using Modules::PictureBufferModule;
+
+		const auto size = frame.CuttingPicture.size();
+
+		auto blurred_picture = PictureBufferModule::GetView(BlurredBuffer, size, CV_8UC3);
+		cv::GaussianBlur(frame.CuttingPicture, blurred_picture, cv::Size(3,3), 0.8);
+
+		auto hsv_picture = PictureBufferModule::GetView(HSVBuffer, size, CV_8UC3);
+		cv::cvtColor(blurred_picture, hsv_picture, cv::COLOR_BGR2HSV);
+
+		// ColorFilter中的二值化保留的范围为(Min, Max]，故此处下界加一以保持一致
+		frame.BinaryPicture = PictureBufferModule::GetView(frame.BinaryBuffer, size, CV_8UC1);
+		cv::inRange(hsv_picture,
+			  cv::Scalar(MinHue + 1, MinSaturation + 1, MinValue + 1),
+			  cv::Scalar(MaxHue, MaxSaturation, MaxValue),
+			  frame.BinaryPicture);
+
+		cv::morphologyEx(frame.BinaryPicture, frame.BinaryPicture, cv::MORPH_CLOSE, CloseKernel);
+	}
+}
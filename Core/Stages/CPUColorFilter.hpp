@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../Frames/Frame.hpp"
+#include "../Pipelines/Slots.hpp"
+
+#include <opencv4/opencv2/opencv.hpp>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/**
+	 * @brief CPU蒙版过滤器
+	 * @author Vincent
+	 * @details
+	 *  ~ 该过滤器是ColorFilter在CPU上的实现，直接处理内存中的裁剪图像，
+	 *    用于没有CUDA设备的环境，如回放与基准测试。
+	 *  ~ 处理步骤与ColorFilter一致：高斯滤波、转换至HSV、按阈值过滤、闭运算。
+	 */
+	class CPUColorFilter
+	{
+	public:
+		/// 输入槽
+		using InputSlots = SlotList<Slots::CuttingPicture>;
+		/// 输出槽
+		using OutputSlots = SlotList<Slots::BinaryPicture>;
+
+	protected:
+		/// 闭运算结构元素
+		cv::Mat CloseKernel {cv::getStructuringElement(cv::MORPH_RECT, cv::Size(3,3))};
+
+		/// 滤波后的图像缓冲区
+		cv::Mat BlurredBuffer;
+		/// HSV图像缓冲区
+		cv::Mat HSVBuffer;
+
+	public:
+		/// 最小色调
+		int MinHue {};
+		/// 最大色调
+		int MaxHue {};
+		/// 最小饱和度
+		int MinSaturation {};
+		/// 最大饱和度
+		int MaxSaturation {};
+		/// 最小亮度
+		int MinValue {};
+		/// 最大亮度
+		int MaxValue {};
+
+	public:
+		/**
+		 * @brief 按照最大输入尺寸预分配缓冲区
+		 * @param max_size 最大输入尺寸
+		 */
+		void Reserve(const cv::Size& max_size);
+
+		/// 执行
+		void Execute(Frame& frame);
+	};
+}
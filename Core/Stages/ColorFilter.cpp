@@ -1,39 +1,66 @@
 #include "ColorFilter.hpp"
+#include "../Modules/PictureBufferModule.hpp"
 #include <opencv4/opencv2/cudaarithm.hpp>
 #include <opencv4/opencv2/cudaimgproc.hpp>
 namespace RoboPioneers::Prometheus::Core
 {
+	/// 预分配缓冲区
+	void ColorFilter::Reserve(const cv::Size &max_size)
+	{
+		HSVBuffer.create(max_size, CV_8UC3);
+		for (auto& buffer : ChannelBuffers) buffer.create(max_size, CV_8UC1);
+		for (auto& buffer : ThresholdBuffers) buffer.create(max_size, CV_8UC1);
+		for (auto& buffer : ChannelMaskBuffers) buffer.create(max_size, CV_8UC1);
+		MaskBuffer.create(max_size, CV_8UC1);
+	}
+
 	/// 执行方法
-	void ColorFilter::Execute()
+	void ColorFilter::Execute(Frame& frame)
 	{
-		GaussFilter->apply(*BGRPicture, *BGRPicture, Stream);
+		using Modules::PictureBufferModule;
+
+		auto& bgr_picture = frame.GpuPicture;
+		const auto size = bgr_picture.size();
+
+		GaussFilter->apply(bgr_picture, bgr_picture, Stream);
 
-		cv::cuda::GpuMat hsv_picture(BGRPicture->size(), CV_8UC3, cv::Scalar(0,0,0));
-		cv::cuda::cvtColor(*BGRPicture, hsv_picture, cv::COLOR_BGR2HSV, 0, Stream);
+		auto hsv_picture = PictureBufferModule::GetView(HSVBuffer, size, CV_8UC3);
+		cv::cuda::cvtColor(bgr_picture, hsv_picture, cv::COLOR_BGR2HSV, 0, Stream);
 
-		cv::cuda::GpuMat channels[3], hue_masks[2], saturation_masks[2], value_masks[2],
-			mask(BGRPicture->size(),CV_8UC1, cv::Scalar(0,0,0));
+		cv::cuda::GpuMat channels[3], thresholds[6], channel_masks[3];
+		for (int index = 0; index < 3; ++index)
+		{
+			channels[index] = PictureBufferModule::GetView(ChannelBuffers[index], size, CV_8UC1);
+			channel_masks[index] = PictureBufferModule::GetView(ChannelMaskBuffers[index], size, CV_8UC1);
+		}
+		for (int index = 0; index < 6; ++index)
+		{
+			thresholds[index] = PictureBufferModule::GetView(ThresholdBuffers[index], size, CV_8UC1);
+		}
+		auto mask = PictureBufferModule::GetView(MaskBuffer, size, CV_8UC1);
+		// 带蒙版的按位与不会写入蒙版外的像素，故需要预先清零
+		mask.setTo(cv::Scalar::all(0), Stream);
 
 		cv::cuda::split(hsv_picture, channels, Stream);
 
-		cv::cuda::threshold(channels[0], hue_masks[0], MinHue, 255, cv::THRESH_BINARY, Stream);
-		cv::cuda::threshold(channels[0], hue_masks[1], MaxHue, 255, cv::THRESH_BINARY_INV, Stream);
-		cv::cuda::threshold(channels[1], saturation_masks[0], MinSaturation, 255, cv::THRESH_BINARY, Stream);
-		cv::cuda::threshold(channels[1], saturation_masks[1], MaxSaturation, 255, cv::THRESH_BINARY_INV, Stream);
-		cv::cuda::threshold(channels[2], value_masks[0], MinValue, 255, cv::THRESH_BINARY, Stream);
-		cv::cuda::threshold(channels[2], value_masks[1], MaxValue, 255, cv::THRESH_BINARY_INV, Stream);
+		cv::cuda::threshold(channels[0], thresholds[0], MinHue, 255, cv::THRESH_BINARY, Stream);
+		cv::cuda::threshold(channels[0], thresholds[1], MaxHue, 255, cv::THRESH_BINARY_INV, Stream);
+		cv::cuda::threshold(channels[1], thresholds[2], MinSaturation, 255, cv::THRESH_BINARY, Stream);
+		cv::cuda::threshold(channels[1], thresholds[3], MaxSaturation, 255, cv::THRESH_BINARY_INV, Stream);
+		cv::cuda::threshold(channels[2], thresholds[4], MinValue, 255, cv::THRESH_BINARY, Stream);
+		cv::cuda::threshold(channels[2], thresholds[5], MaxValue, 255, cv::THRESH_BINARY_INV, Stream);
 
-		cv::cuda::GpuMat hue_mask, saturation_mask, value_mask;
-		cv::cuda::bitwise_and(hue_masks[0], hue_masks[1], hue_mask, cv::noArray(), Stream);
-		cv::cuda::bitwise_and(saturation_masks[0], saturation_masks[1], saturation_mask, cv::noArray(), Stream);
-		cv::cuda::bitwise_and(value_masks[0], value_masks[1], value_mask, cv::noArray(), Stream);
+		cv::cuda::bitwise_and(thresholds[0], thresholds[1], channel_masks[0], cv::noArray(), Stream);
+		cv::cuda::bitwise_and(thresholds[2], thresholds[3], channel_masks[1], cv::noArray(), Stream);
+		cv::cuda::bitwise_and(thresholds[4], thresholds[5], channel_masks[2], cv::noArray(), Stream);
 
-		cv::cuda::bitwise_and(hue_mask, saturation_mask, mask, value_mask, Stream);
+		cv::cuda::bitwise_and(channel_masks[0], channel_masks[1], mask, channel_masks[2], Stream);
 
 		CloseFilter->apply(mask, mask, Stream);
 
-		mask.download(BinaryPicture, Stream);
+		frame.BinaryPicture = PictureBufferModule::GetView(frame.BinaryBuffer, size, CV_8UC1);
+		mask.download(frame.BinaryPicture, Stream);
 
 		Stream.waitForCompletion();
 	}
-}
\ No newline at end of file
+}
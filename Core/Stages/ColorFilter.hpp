@@ -1,5 +1,8 @@
 #pragma once
 
+#include "../Frames/Frame.hpp"
+#include "../Pipelines/Slots.hpp"
+
 #include <memory>
 #include <opencv4/opencv2/opencv.hpp>
 #include <opencv4/opencv2/cudafilters.hpp>
@@ -12,20 +15,38 @@ namespace RoboPioneers::Prometheus::Core
 	 * @author Vincent
 	 * @details
 	 *  ~ 该过滤器用于从原始HSV输入图像上过滤出敌对颜色的区域蒙版，并进行预处理以增强。
+	 *  ~ 中间结果均存放于预分配的缓冲区上，调用Reserve后稳态下不会发生堆分配。
 	 */
 	class ColorFilter
 	{
 	public:
-		/// 输入的原始图像
-		cv::cuda::GpuMat* BGRPicture{};
-		/// 输出的蒙版图像
-		cv::Mat BinaryPicture;
+		/// 输入槽
+		using InputSlots = SlotList<Slots::GpuPicture>;
+		/// 输出槽
+		using OutputSlots = SlotList<Slots::BinaryPicture>;
+
 		/// 工作流
 		cv::cuda::Stream Stream;
 
 	protected:
 		cv::Ptr<cv::cuda::Filter> CloseFilter;
 		cv::Ptr<cv::cuda::Filter> GaussFilter;
+
+		//==============================
+		// 缓冲区部分
+		//==============================
+
+		/// HSV图像缓冲区
+		cv::cuda::GpuMat HSVBuffer;
+		/// 通道缓冲区
+		cv::cuda::GpuMat ChannelBuffers[3];
+		/// 上下限阈值蒙版缓冲区，依次为色调、饱和度、亮度的下限与上限
+		cv::cuda::GpuMat ThresholdBuffers[6];
+		/// 单通道蒙版缓冲区，依次为色调、饱和度、亮度
+		cv::cuda::GpuMat ChannelMaskBuffers[3];
+		/// 合成蒙版缓冲区
+		cv::cuda::GpuMat MaskBuffer;
+
 	public:
 		/// 最小色调
 		int MinHue {};
@@ -51,7 +72,23 @@ namespace RoboPioneers::Prometheus::Core
 												cv::Size(3,3), 0.8);
 		}
 
+		/**
+		 * @brief 按照最大输入尺寸预分配缓冲区
+		 * @param max_size 最大输入尺寸
+		 */
+		void Reserve(const cv::Size& max_size);
+
 		/// 执行
-		void Execute();
+		void Execute(Frame& frame);
+
+		/**
+		 * @brief 重置工作流
+		 * @details
+		 *  ~ CUDA调用失败后原工作流可能残留错误状态，以新的工作流替换；缓冲区保留，不会重新分配。
+		 */
+		inline void Reset()
+		{
+			Stream = cv::cuda::Stream();
+		}
 	};
-}
\ No newline at end of file
+}
@@ -1,24 +1,27 @@
 #include "LightBarDetector.hpp"
 
 #include "../Modules/GeometryFeatureModule.hpp"
+#include "../Diagnostics/TraceRecorder.hpp"
+#include "../Diagnostics/AllocationAccounting.hpp"
 #include <vector>
 
 namespace RoboPioneers::Prometheus::Core
 {
 	/// 执行方法
-	void LightBarDetector::Execute()
+	void LightBarDetector::Execute(Frame& frame)
 	{
-		// 查找轮廓
-		std::vector<std::vector<cv::Point>> contours;
-		cv::findContours(*BinaryPicture, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_NONE);
-
-		LightBars.clear();
-		LightBars.reserve(contours.size());
-
-		tbb::parallel_for_each(contours, [light_bars = &this->LightBars,
-									min_area = &this->MinArea,
-									min_filling_ratio = &this->MinFillingRatio]
-									(const std::vector<cv::Point>& contour){
+		// 查找轮廓，轮廓缓冲区在帧间复用，其已有的容量不会被释放
+		cv::findContours(frame.BinaryPicture, Contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_NONE);
+
+		// 并发向量的清空不会释放内存
+		frame.LightBars.clear();
+		frame.LightBars.reserve(Contours.size());
+
+		// 判断单个轮廓
+		auto detect_contour = [light_bars = &frame.LightBars,
+							   min_area = &this->MinArea,
+							   min_filling_ratio = &this->MinFillingRatio]
+							   (const std::vector<cv::Point>& contour){
 			auto area = cv::contourArea(contour);
 
 			if (area < *min_area) return;
@@ -31,6 +34,19 @@ namespace RoboPioneers::Prometheus::Core
 			if (geometry_feature.Angle < 20 || geometry_feature.Angle > 160) return;
 
 			light_bars->push_back(rotated_rectangle);
+		};
+
+		// 每个任务区间只记录一个追踪事件，以免轮廓较多时追踪事件淹没阶段的起止事件；
+		// 工作线程上的分配以发起线程的阶段统计
+		tbb::parallel_for(tbb::blocked_range<std::size_t>(0, Contours.size()),
+			[this, &detect_contour, frame_index = frame.Index,
+			 allocation_stage = AllocationAccounting::GetCurrentStage()](const tbb::blocked_range<std::size_t>& range){
+				AllocationAccounting::StageScope allocation_scope(allocation_stage);
+				TraceScope trace_scope("DetectTask", frame_index);
+				for (auto index = range.begin(); index != range.end(); ++index)
+				{
+					detect_contour(Contours[index]);
+				}
 		});
 	}
 }
\ No newline at end of file
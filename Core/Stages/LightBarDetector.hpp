@@ -1,7 +1,11 @@
 #pragma once
 
+#include "../Frames/Frame.hpp"
+#include "../Pipelines/Slots.hpp"
+
 #include <opencv4/opencv2/opencv.hpp>
 #include <list>
+#include <vector>
 #include <tbb/tbb.h>
 
 namespace RoboPioneers::Prometheus::Core
@@ -12,10 +16,14 @@ namespace RoboPioneers::Prometheus::Core
 	class LightBarDetector
 	{
 	public:
-		/// 输入的二值蒙版图
-		cv::Mat* BinaryPicture;
-		/// 输出的可能的灯条矩形
-		tbb::concurrent_vector<cv::RotatedRect> LightBars;
+		/// 输入槽
+		using InputSlots = SlotList<Slots::BinaryPicture>;
+		/// 输出槽
+		using OutputSlots = SlotList<Slots::LightBars>;
+
+	protected:
+		/// 轮廓缓冲区，跨帧复用以保留容量
+		std::vector<std::vector<cv::Point>> Contours;
 
 	public:
 		/// 最小面积
@@ -25,6 +33,6 @@ namespace RoboPioneers::Prometheus::Core
 
 	public:
 		/// 执行方法
-		void Execute();
+		void Execute(Frame& frame);
 	};
 }
\ No newline at end of file
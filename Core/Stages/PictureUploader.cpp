@@ -0,0 +1,21 @@
+#include "PictureUploader.hpp"
+
+#include "../Modules/PictureBufferModule.hpp"
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/// 执行方法
+	void PictureUploader::Execute(Frame &frame)
+	{
+		frame.GpuPicture = Modules::PictureBufferModule::GetView(
+				frame.GpuBuffer, frame.CuttingPicture.size(), frame.CuttingPicture.type());
+		if (Stream)
+		{
+			frame.GpuPicture.upload(frame.CuttingPicture, *Stream);
+		}
+		else
+		{
+			frame.GpuPicture.upload(frame.CuttingPicture);
+		}
+	}
+}
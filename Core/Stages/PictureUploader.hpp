@@ -0,0 +1,32 @@
+#pragma once
+
+#include "../Frames/Frame.hpp"
+#include "../Pipelines/Slots.hpp"
+
+#include <opencv4/opencv2/opencv.hpp>
+#include <opencv4/opencv2/core/cuda.hpp>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/**
+	 * @brief 图像上传器
+	 * @author Vincent
+	 * @details
+	 *  ~ 该阶段将裁剪后的图像上传至帧上预分配的显存缓冲区。
+	 *  ~ 上传在颜色过滤阶段的工作流上异步进行，由颜色过滤阶段最后的同步等待一并完成，不单独阻塞。
+	 */
+	class PictureUploader
+	{
+	public:
+		/// 输入槽
+		using InputSlots = SlotList<Slots::CuttingPicture>;
+		/// 输出槽
+		using OutputSlots = SlotList<Slots::GpuPicture>;
+
+		/// 上传所用的工作流，应为颜色过滤阶段的工作流；为空时同步上传
+		cv::cuda::Stream* Stream {nullptr};
+
+		/// 执行
+		void Execute(Frame& frame);
+	};
+}
@@ -0,0 +1,93 @@
+#include "TargetPredictor.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/// 以观测值重置模型
+	void TargetPredictor::ResetModel(const std::array<double, AxisCount>& observation,
+	                                 std::chrono::steady_clock::time_point time)
+	{
+		for (std::size_t axis = 0; axis < AxisCount; ++axis)
+		{
+			Axes[axis] = AxisState {observation[axis], 0.0, 0.0};
+		}
+		LastObservationTime = time;
+		Initialized = true;
+	}
+
+	/// 以观测值更新模型
+	void TargetPredictor::UpdateModel(const std::array<double, AxisCount>& observation, double interval)
+	{
+		for (std::size_t axis = 0; axis < AxisCount; ++axis)
+		{
+			auto& state = Axes[axis];
+
+			// 预测至观测时刻
+			auto predicted_position = state.Position + state.Velocity * interval +
+					0.5 * state.Acceleration * interval * interval;
+			auto predicted_velocity = state.Velocity + state.Acceleration * interval;
+
+			// 以残差修正
+			auto residual = observation[axis] - predicted_position;
+			state.Position = predicted_position + Alpha * residual;
+			state.Velocity = predicted_velocity + Beta * residual / interval;
+			if (Gamma > 0.0)
+			{
+				state.Acceleration += 2.0 * Gamma * residual / (interval * interval);
+			}
+			else
+			{
+				state.Acceleration = 0.0;
+			}
+		}
+	}
+
+	/// 执行预测
+	void TargetPredictor::Execute(Frame& frame)
+	{
+		auto& prediction = frame.PredictedTarget;
+		prediction = frame.Target;
+		frame.PredictedTime = frame.ReceiveTime;
+
+		if (!Enabled || !frame.Target.Found) return;
+
+		std::array<double, AxisCount> observation {
+			static_cast<double>(frame.Target.X),
+			static_cast<double>(frame.Target.Y),
+			static_cast<double>(frame.Target.Distance)
+		};
+		auto observation_time = frame.ReceiveTime;
+
+		if (!Initialized || observation_time - LastObservationTime > LostTimeout ||
+		    std::hypot(observation[AxisX] - Axes[AxisX].Position,
+		               observation[AxisY] - Axes[AxisY].Position) > ResetDistance)
+		{
+			ResetModel(observation, observation_time);
+		}
+		else
+		{
+			auto interval = std::chrono::duration<double>(observation_time - LastObservationTime).count();
+			// 时间不前进时无法估计速度，只保留模型
+			if (interval <= 0.0) return;
+			UpdateModel(observation, interval);
+			LastObservationTime = observation_time;
+		}
+
+		// 外推时长为该帧至今的实测延迟加上执行延迟
+		auto prediction_time = std::clamp<std::chrono::steady_clock::duration>(
+				std::chrono::steady_clock::now() - observation_time + ActuationDelay,
+				std::chrono::steady_clock::duration::zero(), MaxPredictionTime);
+		auto lead = std::chrono::duration<double>(prediction_time).count();
+		frame.PredictedTime = observation_time + prediction_time;
+
+		auto extrapolate = [this, lead](Axis axis){
+			const auto& state = Axes[axis];
+			return state.Position + state.Velocity * lead + 0.5 * state.Acceleration * lead * lead;
+		};
+		prediction.X = std::clamp(static_cast<int>(std::lround(extrapolate(AxisX))), 0, ScreenWidth - 1);
+		prediction.Y = std::clamp(static_cast<int>(std::lround(extrapolate(AxisY))), 0, ScreenHeight - 1);
+		prediction.Distance = std::max(0, static_cast<int>(std::lround(extrapolate(AxisDistance))));
+	}
+}
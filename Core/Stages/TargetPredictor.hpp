@@ -0,0 +1,104 @@
+#pragma once
+
+#include "../Frames/Frame.hpp"
+#include "../Pipelines/Slots.hpp"
+
+#include <array>
+#include <chrono>
+
+namespace RoboPioneers::Prometheus::Core
+{
+	/**
+	 * @brief 目标预测器
+	 * @author Vincent
+	 * @details
+	 *  ~ 该类在装甲板选择之后，为选中的目标维护图像坐标与距离上的运动模型，
+	 *    并将目标外推至结果预计被执行的时刻，以抵消处理流水线的延迟。
+	 *  ~ 运动模型为逐轴的alpha-beta滤波器，Gamma大于零时为alpha-beta-gamma滤波器，额外估计加速度。
+	 *  ~ 观测时刻取帧的采集回调时间；外推时长为该帧至今已经经过的处理时间加上ActuationDelay，
+	 *    即使用实测的流水线延迟，而不是固定的补偿量。
+	 *  ~ 目标跳变超过ResetDistance或丢失超过LostTimeout时，视为新目标并重置模型。
+	 *  ~ 未开启或未找到目标时，输出与选择器的输出相同。
+	 *  ~ 外推的目标时刻写入PredictedTime，未外推时为采集回调时间；发送结果时以该时刻打时间戳，
+	 *    下位机只需补偿该时刻之后的剩余延迟，不会重复补偿。
+	 */
+	class TargetPredictor
+	{
+	public:
+		/// 输入槽
+		using InputSlots = SlotList<Slots::Target>;
+		/// 输出槽
+		using OutputSlots = SlotList<Slots::PredictedTarget>;
+
+	public:
+		/// 是否开启预测
+		bool Enabled {false};
+
+		/// 位置修正系数
+		double Alpha {0.5};
+		/// 速度修正系数
+		double Beta {0.1};
+		/// 加速度修正系数，为零则不估计加速度
+		double Gamma {0.0};
+
+		/// 结果写入串口后至下位机执行所需的额外时间
+		std::chrono::microseconds ActuationDelay {5000};
+		/// 最大外推时长，超过则截断，避免延迟异常时输出离谱的位置
+		std::chrono::microseconds MaxPredictionTime {100000};
+
+		/// 目标跳变超过该像素距离时重置模型
+		double ResetDistance {150.0};
+		/// 目标丢失超过该时间时重置模型
+		std::chrono::microseconds LostTimeout {200000};
+
+		/// 屏幕宽度，外推结果被限制在屏幕内
+		int ScreenWidth {1280};
+		/// 屏幕高度，外推结果被限制在屏幕内
+		int ScreenHeight {1024};
+
+	protected:
+		/// 单轴的运动状态
+		struct AxisState
+		{
+			/// 位置
+			double Position {0.0};
+			/// 速度，单位为每秒
+			double Velocity {0.0};
+			/// 加速度，单位为每二次方秒
+			double Acceleration {0.0};
+		};
+
+		/// 模型的轴：横坐标、纵坐标、距离
+		enum Axis : std::size_t
+		{
+			AxisX, AxisY, AxisDistance, AxisCount
+		};
+
+		/// 各轴的运动状态
+		std::array<AxisState, AxisCount> Axes {};
+		/// 模型是否已经初始化
+		bool Initialized {false};
+		/// 最近一次观测的时间
+		std::chrono::steady_clock::time_point LastObservationTime;
+
+		/// 以观测值重置模型
+		void ResetModel(const std::array<double, AxisCount>& observation, std::chrono::steady_clock::time_point time);
+
+		/// 以观测值更新模型
+		void UpdateModel(const std::array<double, AxisCount>& observation, double interval);
+
+	public:
+		/**
+		 * @brief 执行
+		 * @details
+		 *  ~ 找到目标时以其更新运动模型，并将外推后的坐标与距离写入PredictedTarget。
+		 */
+		void Execute(Frame& frame);
+
+		/// 丢弃运动模型，下一次找到目标时重新初始化
+		inline void Reset() noexcept
+		{
+			Initialized = false;
+		}
+	};
+}
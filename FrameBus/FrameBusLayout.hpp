@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace RoboPioneers::Prometheus::FrameBus
+{
+	/// 共享内存的识别码，即"FBUS"
+	constexpr std::uint32_t BusMagic = 0x53554246;
+	/// 布局版本，布局变化时递增，读取端拒绝附加到版本不同的总线
+	constexpr std::uint32_t BusVersion = 1;
+	/// 默认的共享内存名称
+	constexpr const char* DefaultBusName = "/prometheus_frames";
+
+	static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+			"Frame bus requires lock-free 64-bit atomics to be shared between processes.");
+
+	/// 图像平面
+	enum Plane : std::size_t
+	{
+		/// 原始Bayer图像
+		RawPlane,
+		/// 颜色蒙版图像
+		MaskPlane,
+		/// 平面数量，不是有效的平面
+		PlaneCount
+	};
+
+	/**
+	 * @brief 目标结果
+	 * @details
+	 *  ~ 与Core::TargetInformation对应，使用定长整数，以便不依赖OpenCV的进程读取。
+	 */
+	struct TargetResult
+	{
+		/// 是否找到目标
+		std::uint32_t Found;
+		/// 装甲板中心点横坐标
+		std::int32_t X;
+		/// 装甲板中心点纵坐标
+		std::int32_t Y;
+		/// 估算的距离，单位为厘米
+		std::int32_t Distance;
+		/// 兴趣区域
+		std::int32_t AreaX, AreaY, AreaWidth, AreaHeight;
+	};
+
+	/**
+	 * @brief 单帧的处理结果
+	 * @details
+	 *  ~ 时间均为单调时钟（CLOCK_MONOTONIC）的纳秒数，同一台机器上的进程可以直接比较。
+	 */
+	struct FrameResult
+	{
+		/// 帧序号
+		std::uint64_t FrameIndex;
+		/// 相机给出的帧号
+		std::uint64_t SensorFrameID;
+		/// 相机给出的时间戳
+		std::uint64_t SensorTimeStamp;
+		/// 采集回调被触发的时间
+		std::int64_t ReceiveTime;
+		/// 开始处理的时间
+		std::int64_t ProcessBeginTime;
+		/// 发布的时间
+		std::int64_t PublishTime;
+
+		/// 裁剪图像相对于全屏的横向偏移
+		std::int32_t OffsetX;
+		/// 裁剪图像相对于全屏的纵向偏移
+		std::int32_t OffsetY;
+		/// 灯条数量
+		std::uint32_t LightBarCount;
+		/// 装甲板数量
+		std::uint32_t ArmorCount;
+
+		/// 选择的目标
+		TargetResult Target;
+		/// 外推后的目标
+		TargetResult PredictedTarget;
+	};
+
+	/// 图像平面描述，平面数据按行连续存放，每个像素一个字节
+	struct PlaneHeader
+	{
+		/// 宽度
+		std::uint32_t Width;
+		/// 高度
+		std::uint32_t Height;
+		/// 字节数，为零表示该帧没有该平面
+		std::uint64_t Size;
+	};
+
+	/**
+	 * @brief 槽头
+	 * @details
+	 *  ~ Sequence为顺序锁的序号：写入前加一变为奇数，写入后再加一变为偶数。
+	 *    读取端在拷贝前后读取序号，两次相同且为偶数，则拷贝的数据完整。
+	 *  ~ 槽头之后依次为各平面的数据区，容量由总线头给出。
+	 */
+	struct alignas(64) SlotHeader
+	{
+		/// 顺序锁序号
+		std::atomic<std::uint64_t> Sequence;
+		/// 该槽中的帧的发布编号，从1开始
+		std::uint64_t Number;
+		/// 处理结果
+		FrameResult Result;
+		/// 图像平面
+		PlaneHeader Planes[PlaneCount];
+	};
+
+	/**
+	 * @brief 总线头
+	 * @details
+	 *  ~ 总线头之后为SlotCount个槽，每个槽占用SlotSize字节，槽的起始地址按页对齐。
+	 *  ~ Magic在布局初始化完成后最后写入，读取端据此判断总线是否可用。
+	 */
+	struct alignas(64) BusHeader
+	{
+		/// 识别码
+		std::atomic<std::uint32_t> Magic;
+		/// 布局版本
+		std::uint32_t Version;
+		/// 槽数量
+		std::uint32_t SlotCount;
+		/// 发布者的进程号
+		std::int32_t WriterProcess;
+		/// 各平面的容量
+		std::uint64_t PlaneCapacity[PlaneCount];
+		/// 总线头所占用的字节数
+		std::uint64_t HeaderSize;
+		/// 每个槽所占用的字节数
+		std::uint64_t SlotSize;
+
+		/// 已发布的帧数，独占一个缓存行，读取端轮询该值
+		alignas(64) std::atomic<std::uint64_t> PublishedCount;
+	};
+
+	/// 页大小，槽按页对齐
+	constexpr std::size_t PageSize = 4096;
+
+	/// 向上对齐至页大小
+	constexpr std::size_t AlignToPage(std::size_t size) noexcept
+	{
+		return (size + PageSize - 1) / PageSize * PageSize;
+	}
+
+	/// 计算槽所占用的字节数
+	constexpr std::size_t GetSlotSize(const std::uint64_t (&plane_capacity)[PlaneCount]) noexcept
+	{
+		std::size_t size = sizeof(SlotHeader);
+		for (auto capacity : plane_capacity)
+		{
+			size += capacity;
+		}
+		return AlignToPage(size);
+	}
+}
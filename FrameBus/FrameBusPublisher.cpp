@@ -0,0 +1,165 @@
+#include "FrameBusPublisher.hpp"
+
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace RoboPioneers::Prometheus::FrameBus
+{
+	/// 获取单调时钟的纳秒数
+	static std::int64_t GetMonotonicTime() noexcept
+	{
+		timespec time {};
+		clock_gettime(CLOCK_MONOTONIC, &time);
+		return static_cast<std::int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+	}
+
+	/// 析构并关闭
+	FrameBusPublisher::~FrameBusPublisher()
+	{
+		Close();
+	}
+
+	/// 获取槽头
+	SlotHeader* FrameBusPublisher::GetSlot(std::size_t slot_index) const noexcept
+	{
+		return reinterpret_cast<SlotHeader*>(Memory + Header->HeaderSize + slot_index * Header->SlotSize);
+	}
+
+	/// 创建共享内存并开启总线
+	void FrameBusPublisher::Open(const std::string &name, std::uint32_t slot_count,
+	                             std::size_t raw_capacity, std::size_t mask_capacity)
+	{
+		if (slot_count == 0)
+		{
+			throw std::invalid_argument("[FrameBusPublisher::Open] Slot Count Must be Positive.");
+		}
+		Close();
+
+		const std::uint64_t plane_capacity[PlaneCount] {raw_capacity, mask_capacity};
+		const auto header_size = AlignToPage(sizeof(BusHeader));
+		const auto slot_size = GetSlotSize(plane_capacity);
+		const auto memory_size = header_size + slot_size * slot_count;
+
+		// 删除旧的同名共享内存而不是复用，仍附加在旧内存上的读取端不会看到布局变化
+		shm_unlink(name.c_str());
+		auto descriptor = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+		if (descriptor < 0)
+		{
+			throw std::runtime_error("[FrameBusPublisher::Open] Failed to Create Shared Memory: " + name);
+		}
+		if (ftruncate(descriptor, static_cast<off_t>(memory_size)) != 0)
+		{
+			close(descriptor);
+			shm_unlink(name.c_str());
+			throw std::runtime_error("[FrameBusPublisher::Open] Failed to Resize Shared Memory: " + name);
+		}
+
+		// 预先填充页表，发布时不会发生缺页
+		auto* memory = mmap(nullptr, memory_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, descriptor, 0);
+		close(descriptor);
+		if (memory == MAP_FAILED)
+		{
+			shm_unlink(name.c_str());
+			throw std::runtime_error("[FrameBusPublisher::Open] Failed to Map Shared Memory: " + name);
+		}
+
+		Name = name;
+		Memory = static_cast<unsigned char*>(memory);
+		MemorySize = memory_size;
+		PublishedCount = 0;
+
+		auto* header = new (Memory) BusHeader;
+		header->Version = BusVersion;
+		header->SlotCount = slot_count;
+		header->WriterProcess = static_cast<std::int32_t>(getpid());
+		header->PlaneCapacity[RawPlane] = raw_capacity;
+		header->PlaneCapacity[MaskPlane] = mask_capacity;
+		header->HeaderSize = header_size;
+		header->SlotSize = slot_size;
+		header->PublishedCount.store(0, std::memory_order_relaxed);
+		Header = header;
+
+		for (std::size_t slot_index = 0; slot_index < slot_count; ++slot_index)
+		{
+			auto* slot = new (GetSlot(slot_index)) SlotHeader;
+			slot->Sequence.store(0, std::memory_order_relaxed);
+			slot->Number = 0;
+		}
+
+		// 布局初始化完成后才写入识别码
+		header->Magic.store(BusMagic, std::memory_order_release);
+	}
+
+	/// 关闭总线
+	void FrameBusPublisher::Close()
+	{
+		if (Memory)
+		{
+			munmap(Memory, MemorySize);
+			shm_unlink(Name.c_str());
+		}
+		Memory = nullptr;
+		MemorySize = 0;
+		Header = nullptr;
+	}
+
+	/// 发布一帧
+	void FrameBusPublisher::Publish(const FrameResult &result, const PlaneView &raw, const PlaneView &mask) noexcept
+	{
+		if (!Header) return;
+
+		const auto number = PublishedCount + 1;
+		auto* slot = GetSlot((number - 1) % Header->SlotCount);
+		auto* data = reinterpret_cast<unsigned char*>(slot) + sizeof(SlotHeader);
+
+		// 序号变为奇数，此后的写入不得被重排到其之前
+		const auto sequence = slot->Sequence.load(std::memory_order_relaxed);
+		slot->Sequence.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		slot->Number = number;
+		slot->Result = result;
+		slot->Result.PublishTime = GetMonotonicTime();
+
+		const PlaneView* planes[PlaneCount] {&raw, &mask};
+		for (std::size_t plane_index = 0; plane_index < PlaneCount; ++plane_index)
+		{
+			const auto& plane = *planes[plane_index];
+			auto& plane_header = slot->Planes[plane_index];
+			const std::uint64_t size = static_cast<std::uint64_t>(plane.Width) * plane.Height;
+
+			if (!plane.Data || size == 0 || size > Header->PlaneCapacity[plane_index])
+			{
+				plane_header = PlaneHeader {0, 0, 0};
+			}
+			else
+			{
+				plane_header = PlaneHeader {plane.Width, plane.Height, size};
+				// 连续的平面整块拷贝，视图上的平面逐行拷贝
+				if (plane.Step == plane.Width)
+				{
+					std::memcpy(data, plane.Data, size);
+				}
+				else
+				{
+					const auto* source = static_cast<const unsigned char*>(plane.Data);
+					for (std::uint32_t row = 0; row < plane.Height; ++row)
+					{
+						std::memcpy(data + row * plane.Width, source + row * plane.Step, plane.Width);
+					}
+				}
+			}
+			data += Header->PlaneCapacity[plane_index];
+		}
+
+		// 序号变为偶数，数据完整
+		slot->Sequence.store(sequence + 2, std::memory_order_release);
+		Header->PublishedCount.store(number, std::memory_order_release);
+		PublishedCount = number;
+	}
+}
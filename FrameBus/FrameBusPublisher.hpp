@@ -0,0 +1,94 @@
+#pragma once
+
+#include "FrameBusLayout.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace RoboPioneers::Prometheus::FrameBus
+{
+	/// 待发布的图像平面，每个像素一个字节，行之间可以有间隔
+	struct PlaneView
+	{
+		/// 数据指针，为空表示不发布该平面
+		const void* Data {nullptr};
+		/// 宽度
+		std::uint32_t Width {0};
+		/// 高度
+		std::uint32_t Height {0};
+		/// 行字节数
+		std::size_t Step {0};
+	};
+
+	/**
+	 * @brief 帧总线发布者
+	 * @author Vincent
+	 * @details
+	 *  ~ 发布者创建一块POSIX共享内存，将其划分为若干个槽组成的环，每帧轮转写入一个槽。
+	 *  ~ 每帧的图像只拷贝一次到共享内存中，任意数量的读取端以只读方式映射同一块内存，
+	 *    发布者不知道读取端的存在，读取端的数量与快慢都不会影响发布者。
+	 *  ~ 槽以顺序锁保护：发布者从不等待，读取端在拷贝后检查序号，被覆盖的数据将被丢弃并重试。
+	 *  ~ 共享内存在开启时预先分配并写入，发布时不会发生缺页或系统调用。
+	 *  ~ 只能由一个线程发布。
+	 */
+	class FrameBusPublisher
+	{
+	protected:
+		/// 共享内存名称
+		std::string Name;
+		/// 映射的起始地址
+		unsigned char* Memory {nullptr};
+		/// 映射的字节数
+		std::size_t MemorySize {0};
+
+		/// 总线头
+		BusHeader* Header {nullptr};
+		/// 已发布的帧数
+		std::uint64_t PublishedCount {0};
+
+		/// 获取槽头
+		[[nodiscard]] SlotHeader* GetSlot(std::size_t slot_index) const noexcept;
+
+	public:
+		/// 析构，若已开启则关闭
+		~FrameBusPublisher();
+
+		/**
+		 * @brief 创建共享内存并开启总线
+		 * @param name 共享内存名称，以'/'开头，已存在的同名共享内存将被删除
+		 * @param slot_count 槽数量，即读取端最多可以落后的帧数
+		 * @param raw_capacity 原始图像平面的容量
+		 * @param mask_capacity 蒙版图像平面的容量
+		 * @throw std::invalid_argument 当槽数量为零
+		 * @throw std::runtime_error 当无法创建或映射共享内存
+		 */
+		void Open(const std::string& name, std::uint32_t slot_count,
+		          std::size_t raw_capacity, std::size_t mask_capacity);
+
+		/// 解除映射并删除共享内存，已附加的读取端保留其映射，但不会再收到新的帧
+		void Close();
+
+		/// 是否已开启
+		[[nodiscard]] inline bool IsOpened() const noexcept
+		{
+			return Header != nullptr;
+		}
+
+		/// 获取已发布的帧数
+		[[nodiscard]] inline std::uint64_t GetPublishedCount() const noexcept
+		{
+			return PublishedCount;
+		}
+
+		/**
+		 * @brief 发布一帧
+		 * @param result 处理结果，其PublishTime将被填写
+		 * @param raw 原始图像平面
+		 * @param mask 蒙版图像平面
+		 * @details
+		 *  ~ 超出容量的平面不会被发布，其字节数记为零。
+		 */
+		void Publish(const FrameResult& result, const PlaneView& raw, const PlaneView& mask) noexcept;
+	};
+}
@@ -0,0 +1,176 @@
+#include "FrameBusReader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace RoboPioneers::Prometheus::FrameBus
+{
+	/// 析构并解除映射
+	FrameBusReader::~FrameBusReader()
+	{
+		Close();
+	}
+
+	/// 获取槽头
+	const SlotHeader* FrameBusReader::GetSlot(std::size_t slot_index) const noexcept
+	{
+		return reinterpret_cast<const SlotHeader*>(Memory + Header->HeaderSize + slot_index * Header->SlotSize);
+	}
+
+	/// 附加到总线
+	void FrameBusReader::Open(const std::string &name)
+	{
+		Close();
+
+		auto descriptor = shm_open(name.c_str(), O_RDONLY, 0);
+		if (descriptor < 0)
+		{
+			throw std::runtime_error("[FrameBusReader::Open] Frame Bus not Found: " + name);
+		}
+
+		struct stat status {};
+		if (fstat(descriptor, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(BusHeader))
+		{
+			close(descriptor);
+			throw std::runtime_error("[FrameBusReader::Open] Frame Bus is not Initialized: " + name);
+		}
+
+		const auto memory_size = static_cast<std::size_t>(status.st_size);
+		auto* memory = mmap(nullptr, memory_size, PROT_READ, MAP_SHARED, descriptor, 0);
+		close(descriptor);
+		if (memory == MAP_FAILED)
+		{
+			throw std::runtime_error("[FrameBusReader::Open] Failed to Map Frame Bus: " + name);
+		}
+
+		const auto* header = static_cast<const BusHeader*>(memory);
+		if (header->Magic.load(std::memory_order_acquire) != BusMagic || header->Version != BusVersion ||
+		    header->SlotCount == 0 || header->HeaderSize + header->SlotSize * header->SlotCount > memory_size)
+		{
+			munmap(memory, memory_size);
+			throw std::runtime_error("[FrameBusReader::Open] Incompatible or Uninitialized Frame Bus: " + name);
+		}
+
+		Memory = static_cast<const unsigned char*>(memory);
+		MemorySize = memory_size;
+		Header = header;
+		// 从附加时最新的帧开始读取，此前的帧不计入跳过的帧数
+		LastNumber = GetPublishedCount();
+		MissedCount = 0;
+	}
+
+	/// 解除映射
+	void FrameBusReader::Close()
+	{
+		if (Memory)
+		{
+			munmap(const_cast<unsigned char*>(Memory), MemorySize);
+		}
+		Memory = nullptr;
+		MemorySize = 0;
+		Header = nullptr;
+	}
+
+	/// 发布者进程是否仍然存在
+	bool FrameBusReader::IsWriterAlive() const noexcept
+	{
+		return Header && kill(Header->WriterProcess, 0) == 0;
+	}
+
+	/// 获取已发布的帧数
+	std::uint64_t FrameBusReader::GetPublishedCount() const noexcept
+	{
+		return Header ? Header->PublishedCount.load(std::memory_order_acquire) : 0;
+	}
+
+	/// 获取平面容量
+	std::uint64_t FrameBusReader::GetPlaneCapacity(Plane plane) const noexcept
+	{
+		return Header && plane < PlaneCount ? Header->PlaneCapacity[plane] : 0;
+	}
+
+	/// 拷贝指定发布编号所在的槽
+	bool FrameBusReader::CopySlot(std::uint64_t number, FrameSample &sample)
+	{
+		const auto* slot = GetSlot((number - 1) % Header->SlotCount);
+		const auto sequence = slot->Sequence.load(std::memory_order_acquire);
+		if (sequence & 1) return false;
+
+		sample.Number = slot->Number;
+		sample.Result = slot->Result;
+
+		const auto* data = reinterpret_cast<const unsigned char*>(slot) + sizeof(SlotHeader);
+		for (std::size_t plane_index = 0; plane_index < PlaneCount; ++plane_index)
+		{
+			const auto capacity = Header->PlaneCapacity[plane_index];
+			auto& plane = sample.Planes[plane_index];
+			plane = slot->Planes[plane_index];
+			// 拷贝期间读到的字节数可能已被改写，以容量为界，校验失败后整帧丢弃
+			const auto size = static_cast<std::size_t>(std::min<std::uint64_t>(plane.Size, capacity));
+
+			auto& buffer = sample.PlaneData[plane_index];
+			if (buffer.size() < size)
+			{
+				buffer.resize(capacity);
+			}
+			std::memcpy(buffer.data(), data, size);
+			data += capacity;
+		}
+
+		// 拷贝的读取不得被重排到序号的再次读取之后
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return slot->Sequence.load(std::memory_order_relaxed) == sequence && sample.Number == number;
+	}
+
+	/// 读取最新发布的帧
+	bool FrameBusReader::ReadLatest(FrameSample &sample)
+	{
+		// 被发布者连续覆盖时的最大重试次数，避免在发布者极快时一直无法完成读取
+		constexpr int max_attempts = 4;
+
+		if (!Header) return false;
+
+		for (int attempt = 0; attempt < max_attempts; ++attempt)
+		{
+			const auto latest = Header->PublishedCount.load(std::memory_order_acquire);
+			if (latest <= LastNumber) return false;
+			if (!CopySlot(latest, sample)) continue;
+
+			MissedCount += sample.Number - LastNumber - 1;
+			LastNumber = sample.Number;
+			return true;
+		}
+		return false;
+	}
+
+	/// 按发布顺序读取下一帧
+	bool FrameBusReader::ReadNext(FrameSample &sample)
+	{
+		// 被发布者连续覆盖时的最大重试次数，每次重试都以最新的发布编号重新计算最旧的帧
+		constexpr int max_attempts = 4;
+
+		if (!Header) return false;
+
+		for (int attempt = 0; attempt < max_attempts; ++attempt)
+		{
+			const auto latest = Header->PublishedCount.load(std::memory_order_acquire);
+			if (latest <= LastNumber) return false;
+
+			// 环中只保留最近的SlotCount帧，更早的帧已被覆盖
+			const auto oldest = latest > Header->SlotCount ? latest - Header->SlotCount + 1 : 1;
+			const auto number = std::max(LastNumber + 1, oldest);
+			if (!CopySlot(number, sample)) continue;
+
+			MissedCount += number - LastNumber - 1;
+			LastNumber = number;
+			return true;
+		}
+		return false;
+	}
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "FrameBusLayout.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace RoboPioneers::Prometheus::FrameBus
+{
+	/// 读取端取得的一帧
+	struct FrameSample
+	{
+		/// 发布编号
+		std::uint64_t Number {0};
+		/// 处理结果
+		FrameResult Result {};
+		/// 图像平面描述
+		PlaneHeader Planes[PlaneCount] {};
+		/// 图像平面数据，按行连续存放，容量在首次读取后保持不变
+		std::vector<unsigned char> PlaneData[PlaneCount];
+	};
+
+	/**
+	 * @brief 帧总线读取端
+	 * @author Vincent
+	 * @details
+	 *  ~ 读取端以只读方式映射发布者创建的共享内存，不会对其做任何写入，因而不会影响发布者。
+	 *  ~ ReadLatest读取最新发布的帧，落后于发布者的帧不会被补读；
+	 *    ReadNext按发布顺序读取上一次读取之后的帧，只有已被发布者覆盖的帧才会被跳过。跳过的帧数均记入GetMissedCount。
+	 *  ~ 拷贝后以顺序锁的序号校验，拷贝期间被覆盖的数据将被丢弃并重试。
+	 */
+	class FrameBusReader
+	{
+	protected:
+		/// 映射的起始地址
+		const unsigned char* Memory {nullptr};
+		/// 映射的字节数
+		std::size_t MemorySize {0};
+		/// 总线头
+		const BusHeader* Header {nullptr};
+
+		/// 最近读取的帧的发布编号
+		std::uint64_t LastNumber {0};
+		/// 跳过的帧数
+		std::uint64_t MissedCount {0};
+
+		/// 获取槽头
+		[[nodiscard]] const SlotHeader* GetSlot(std::size_t slot_index) const noexcept;
+
+		/**
+		 * @brief 拷贝指定发布编号所在的槽
+		 * @retval true 当拷贝完整，且槽中的帧确为该编号
+		 * @retval false 当槽正在被写入、拷贝期间被覆盖或已被更新的帧取代
+		 */
+		bool CopySlot(std::uint64_t number, FrameSample& sample);
+
+	public:
+		/// 析构，若已附加则解除映射
+		~FrameBusReader();
+
+		/**
+		 * @brief 附加到总线
+		 * @param name 共享内存名称
+		 * @throw std::runtime_error 当共享内存不存在、尚未初始化或版本不同
+		 */
+		void Open(const std::string& name = DefaultBusName);
+
+		/// 解除映射
+		void Close();
+
+		/// 是否已附加
+		[[nodiscard]] inline bool IsOpened() const noexcept
+		{
+			return Header != nullptr;
+		}
+
+		/**
+		 * @brief 发布者进程是否仍然存在
+		 * @details
+		 *  ~ 发布者重新开启总线后，原有的共享内存不会再收到新的帧，读取端应当重新附加。
+		 */
+		[[nodiscard]] bool IsWriterAlive() const noexcept;
+
+		/// 获取发布者已发布的帧数
+		[[nodiscard]] std::uint64_t GetPublishedCount() const noexcept;
+
+		/// 获取跳过的帧数
+		[[nodiscard]] inline std::uint64_t GetMissedCount() const noexcept
+		{
+			return MissedCount;
+		}
+
+		/// 获取平面容量
+		[[nodiscard]] std::uint64_t GetPlaneCapacity(Plane plane) const noexcept;
+
+		/**
+		 * @brief 读取最新发布的帧
+		 * @param sample 用于接收帧的对象，其缓冲区可以在多次读取之间复用
+		 * @retval true 当读取到比上一次更新的完整的帧
+		 * @retval false 当没有新的帧，或多次重试后依然无法读取到完整的帧
+		 */
+		bool ReadLatest(FrameSample& sample);
+
+		/**
+		 * @brief 按发布顺序读取上一次读取之后的帧
+		 * @param sample 用于接收帧的对象，其缓冲区可以在多次读取之间复用
+		 * @retval true 当读取到下一帧
+		 * @retval false 当没有新的帧，或多次重试后依然无法读取到完整的帧
+		 * @details
+		 *  ~ 只要读取端落后于发布者不超过槽数量，就不会跳过任何帧；
+		 *    落后更多时，已被覆盖的帧无法补读，从环中仍然保留的最旧的帧继续读取。
+		 */
+		bool ReadNext(FrameSample& sample);
+	};
+}
@@ -0,0 +1,6 @@
+#include "FrameBusLayout.hpp"
+#include "FrameBusPublisher.hpp"
+#include "FrameBusReader.hpp"
+
+namespace RoboPioneers::Prometheus::FrameBus
+{}
@@ -0,0 +1,484 @@
+#include "BayerCodec.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Bayer codec assumes a little-endian host.");
+
+namespace RoboPioneers::Prometheus::Recording
+{
+	namespace
+	{
+		/// 一元码的最大长度，达到该长度时改为转义码：该长度的零位之后跟随8位原始残差
+		constexpr unsigned int EscapeLength = 16;
+		/// 单个像素编码后的最大位数
+		constexpr unsigned int MaxSymbolBits = EscapeLength + 8;
+		/// 编码头的字节数：识别码、宽度、高度、带行数、带数量
+		constexpr std::size_t HeaderSize = 5 * sizeof(std::uint32_t);
+		/// 带字节数中表示以原始数据存储的标志位
+		constexpr std::uint32_t RawBandFlag = 0x80000000u;
+
+		/**
+		 * @brief Rice参数的自适应上下文
+		 * @details
+		 *  ~ 累计残差之和与个数，选择使个数乘以2^k不小于残差之和的最小k，即k约为log2(平均残差)；
+		 *    个数达到ResetCount时二者减半，使参数能够跟随图像内容的变化。
+		 */
+		struct RiceContext
+		{
+			/// 计数减半的阈值
+			static constexpr std::uint32_t ResetCount = 64;
+
+			/// 残差之和
+			std::uint32_t Sum {4};
+			/// 残差个数
+			std::uint32_t Count {1};
+
+			/// 获取Rice参数
+			[[nodiscard]] inline unsigned int GetParameter() const noexcept
+			{
+				// 由二者的最高位之差估计，至多需要再加一，避免逐位试探的分支；
+				// 连续的零残差会使Sum减半至零，而零的前导零个数未定义，故置最低位
+				int parameter = __builtin_clz(Count) - __builtin_clz(Sum | 1u);
+				parameter = std::max(parameter, 0);
+				parameter += (Count << parameter) < Sum;
+				return static_cast<unsigned int>(std::min(parameter, 7));
+			}
+
+			/// 以映射后的残差更新
+			inline void Update(std::uint32_t value) noexcept
+			{
+				Sum += value;
+				++Count;
+				// 个数只会增长至ResetCount，此时移位量为一，以移位代替分支
+				const auto halve = Count / ResetCount;
+				Sum >>= halve;
+				Count >>= halve;
+			}
+		};
+
+		/**
+		 * @brief 中值边缘检测预测器
+		 * @details
+		 *  ~ 即left、up与left+up-up_left三者的中值，等价于将平面预测值限制在left与up之间，
+		 *    以条件传送代替分支，噪声较大的图像上不会频繁地预测失败。
+		 */
+		inline int PredictMED(int left, int up, int up_left) noexcept
+		{
+			// std::clamp返回引用，会被编译为分支，此处逐个以值比较
+			const int minimum = left < up ? left : up;
+			const int maximum = left < up ? up : left;
+			int prediction = left + up - up_left;
+			prediction = prediction < minimum ? minimum : prediction;
+			return prediction > maximum ? maximum : prediction;
+		}
+
+		/// 获取同色邻居给出的预测值，行与列均为带内的坐标
+		inline int Predict(const unsigned char* row, const unsigned char* previous_row,
+		                   std::uint32_t band_row, std::uint32_t column) noexcept
+		{
+			if (band_row < 2)
+			{
+				return column < 2 ? 0 : row[column - 2];
+			}
+			if (column < 2)
+			{
+				return previous_row[column];
+			}
+			return PredictMED(row[column - 2], previous_row[column], previous_row[column - 2]);
+		}
+
+		/// 将残差折叠映射为无符号数：0, -1, 1, -2, 2 ...
+		inline std::uint32_t MapResidual(int pixel, int prediction) noexcept
+		{
+			// 以无符号数运算，避免对负数左移
+			const std::uint32_t residual = static_cast<std::uint8_t>(pixel - prediction);
+			return ((residual << 1) ^ (0u - (residual >> 7))) & 0xFF;
+		}
+
+		/// 还原映射后的残差并加上预测值
+		inline unsigned char UnmapResidual(std::uint32_t value, int prediction) noexcept
+		{
+			const auto residual = static_cast<int>(value >> 1) ^ -static_cast<int>(value & 1);
+			return static_cast<unsigned char>(prediction + residual);
+		}
+
+		/// 低位先行的位写入器，调用者须保证输出缓冲区足够大
+		struct BitWriter
+		{
+			unsigned char* Output;
+			std::uint64_t Bits {0};
+			unsigned int Count {0};
+
+			explicit BitWriter(unsigned char* output) noexcept : Output(output)
+			{}
+
+			/// 写入不超过32位
+			inline void Put(std::uint32_t value, unsigned int bits) noexcept
+			{
+				Bits |= static_cast<std::uint64_t>(value) << Count;
+				Count += bits;
+				// 总是写出低32位，但只在其已满时前移，以免每几个像素一次的分支预测失败
+				const auto word = static_cast<std::uint32_t>(Bits);
+				std::memcpy(Output, &word, sizeof(word));
+				const auto flushed = Count & 32;
+				Output += flushed >> 3;
+				Bits >>= flushed;
+				Count -= flushed;
+			}
+
+			/// 写出剩余的位，返回写出位置
+			inline unsigned char* Finish() noexcept
+			{
+				while (Count > 0)
+				{
+					*Output++ = static_cast<unsigned char>(Bits);
+					Bits >>= 8;
+					Count = Count > 8 ? Count - 8 : 0;
+				}
+				return Output;
+			}
+		};
+
+		/// 低位先行的位读取器
+		struct BitReader
+		{
+			const unsigned char* Position;
+			const unsigned char* End;
+			std::uint64_t Bits {0};
+			unsigned int Count {0};
+
+			BitReader(const unsigned char* data, std::size_t size) noexcept : Position(data), End(data + size)
+			{}
+
+			/// 使缓冲的位数不少于56，数据结束时尽可能多地读取
+			inline void Refill() noexcept
+			{
+				if (End - Position >= 8)
+				{
+					// 读取8个字节，只前移完整装入的字节数，其余字节下次重新读取
+					std::uint64_t word;
+					std::memcpy(&word, Position, sizeof(word));
+					Bits |= word << Count;
+					Position += (63 - Count) >> 3;
+					Count |= 56;
+				}
+				else
+				{
+					while (Count <= 56 && Position < End)
+					{
+						Bits |= static_cast<std::uint64_t>(*Position++) << Count;
+						Count += 8;
+					}
+				}
+			}
+
+			/// 丢弃已经读取的位
+			inline void Consume(unsigned int bits) noexcept
+			{
+				Bits >>= bits;
+				Count -= bits;
+			}
+		};
+
+		/// 编码一个映射后的残差
+		inline void EncodeSymbol(BitWriter& writer, RiceContext& context, std::uint32_t value) noexcept
+		{
+			const auto parameter = context.GetParameter();
+			const auto quotient = value >> parameter;
+			if (quotient < EscapeLength)
+			{
+				// 一元码为quotient个零位与一个一位，随后为parameter位的余数
+				writer.Put((1u << quotient) | ((value & ((1u << parameter) - 1)) << (quotient + 1)),
+				           quotient + 1 + parameter);
+			}
+			else
+			{
+				writer.Put(value << EscapeLength, MaxSymbolBits);
+			}
+			context.Update(value);
+		}
+
+		/// 解码一个映射后的残差
+		inline std::uint32_t DecodeSymbol(BitReader& reader, RiceContext& context)
+		{
+			reader.Refill();
+
+			std::uint32_t value;
+			const auto unary = static_cast<std::uint32_t>(reader.Bits & ((1u << EscapeLength) - 1));
+			if (unary == 0)
+			{
+				if (reader.Count < MaxSymbolBits)
+				{
+					throw std::runtime_error("[BayerCodec::Decode] Truncated Band.");
+				}
+				value = static_cast<std::uint32_t>(reader.Bits >> EscapeLength) & 0xFF;
+				reader.Consume(MaxSymbolBits);
+			}
+			else
+			{
+				const auto parameter = context.GetParameter();
+				const auto quotient = static_cast<unsigned int>(__builtin_ctz(unary));
+				const auto bits = quotient + 1 + parameter;
+				if (reader.Count < bits)
+				{
+					throw std::runtime_error("[BayerCodec::Decode] Truncated Band.");
+				}
+				value = ((quotient << parameter) |
+				         (static_cast<std::uint32_t>(reader.Bits >> (quotient + 1)) & ((1u << parameter) - 1))) & 0xFF;
+				reader.Consume(bits);
+			}
+			context.Update(value);
+			return value;
+		}
+
+		/// 读取小端序的32位整数
+		inline std::uint32_t ReadWord(const unsigned char* data) noexcept
+		{
+			std::uint32_t value;
+			std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		/// 写入小端序的32位整数
+		inline void WriteWord(unsigned char* data, std::uint32_t value) noexcept
+		{
+			std::memcpy(data, &value, sizeof(value));
+		}
+	}
+
+	/// 构造编解码器
+	BayerCodec::BayerCodec(int concurrency) : Arena(std::max(concurrency, 1))
+	{}
+
+	/// 设置每个带的行数
+	void BayerCodec::SetBandRows(std::uint32_t band_rows)
+	{
+		if (band_rows == 0 || band_rows % 2 != 0)
+		{
+			throw std::invalid_argument("[BayerCodec::SetBandRows] Band Rows Must be a Positive Even Number.");
+		}
+		BandRows = band_rows;
+	}
+
+	/// 编码单个带
+	std::size_t BayerCodec::EncodeBand(const unsigned char *data, std::uint32_t width, std::uint32_t rows,
+	                                   std::size_t step, unsigned char *output) noexcept
+	{
+		// 四个颜色平面各自的上下文，索引为行的奇偶乘以2再加上列的奇偶
+		RiceContext contexts[4];
+		BitWriter writer(output);
+
+		for (std::uint32_t band_row = 0; band_row < rows; ++band_row)
+		{
+			const auto* row = data + band_row * step;
+			const auto* previous_row = band_row >= 2 ? row - 2 * step : row;
+			auto* row_contexts = contexts + (band_row & 1) * 2;
+
+			if (band_row < 2)
+			{
+				for (std::uint32_t column = 0; column < width; ++column)
+				{
+					EncodeSymbol(writer, row_contexts[column & 1],
+					             MapResidual(row[column], Predict(row, previous_row, band_row, column)));
+				}
+				continue;
+			}
+
+			EncodeSymbol(writer, row_contexts[0], MapResidual(row[0], previous_row[0]));
+			EncodeSymbol(writer, row_contexts[1], MapResidual(row[1], previous_row[1]));
+			// 宽度为偶数，每次处理一对相邻的异色像素，上下文的选择不需要逐像素计算
+			for (std::uint32_t column = 2; column < width; column += 2)
+			{
+				EncodeSymbol(writer, row_contexts[0], MapResidual(row[column], PredictMED(
+						row[column - 2], previous_row[column], previous_row[column - 2])));
+				EncodeSymbol(writer, row_contexts[1], MapResidual(row[column + 1], PredictMED(
+						row[column - 1], previous_row[column + 1], previous_row[column - 1])));
+			}
+		}
+		return static_cast<std::size_t>(writer.Finish() - output);
+	}
+
+	/// 解码单个带
+	void BayerCodec::DecodeBand(const unsigned char *data, std::size_t size, std::uint32_t width, std::uint32_t rows,
+	                            unsigned char *picture)
+	{
+		RiceContext contexts[4];
+		BitReader reader(data, size);
+
+		for (std::uint32_t band_row = 0; band_row < rows; ++band_row)
+		{
+			auto* row = picture + static_cast<std::size_t>(band_row) * width;
+			const auto* previous_row = band_row >= 2 ? row - 2 * static_cast<std::size_t>(width) : row;
+			auto* row_contexts = contexts + (band_row & 1) * 2;
+
+			if (band_row < 2)
+			{
+				for (std::uint32_t column = 0; column < width; ++column)
+				{
+					row[column] = UnmapResidual(DecodeSymbol(reader, row_contexts[column & 1]),
+					                            Predict(row, previous_row, band_row, column));
+				}
+				continue;
+			}
+
+			row[0] = UnmapResidual(DecodeSymbol(reader, row_contexts[0]), previous_row[0]);
+			row[1] = UnmapResidual(DecodeSymbol(reader, row_contexts[1]), previous_row[1]);
+			for (std::uint32_t column = 2; column < width; column += 2)
+			{
+				row[column] = UnmapResidual(DecodeSymbol(reader, row_contexts[0]), PredictMED(
+						row[column - 2], previous_row[column], previous_row[column - 2]));
+				row[column + 1] = UnmapResidual(DecodeSymbol(reader, row_contexts[1]), PredictMED(
+						row[column - 1], previous_row[column + 1], previous_row[column - 1]));
+			}
+		}
+	}
+
+	/// 编码
+	void BayerCodec::Encode(const unsigned char *data, std::uint32_t width, std::uint32_t height, std::size_t step,
+	                        std::vector<unsigned char> &output)
+	{
+		if (width == 0 || height == 0 || width % 2 != 0 || height % 2 != 0)
+		{
+			throw std::invalid_argument("[BayerCodec::Encode] Picture Size Must be Positive and Even.");
+		}
+
+		const auto band_rows = BandRows;
+		const std::size_t band_count = (height + band_rows - 1) / band_rows;
+		// 最坏情况下每个像素占用MaxSymbolBits位，另留出位写入器末尾的余量
+		const std::size_t band_capacity = static_cast<std::size_t>(band_rows) * width * MaxSymbolBits / 8 + 8;
+
+		if (BandBuffers.size() < band_count)
+		{
+			BandBuffers.resize(band_count);
+		}
+		BandSizes.resize(band_count);
+
+		Arena.execute([&]{
+			tbb::parallel_for(tbb::blocked_range<std::size_t>(0, band_count, 1),
+			                  [&](const tbb::blocked_range<std::size_t>& range){
+				for (auto band = range.begin(); band != range.end(); ++band)
+				{
+					const auto first_row = static_cast<std::uint32_t>(band * band_rows);
+					const auto rows = std::min(band_rows, height - first_row);
+					const auto* band_data = data + first_row * step;
+					auto& buffer = BandBuffers[band];
+					if (buffer.size() < band_capacity)
+					{
+						buffer.resize(band_capacity);
+					}
+
+					auto size = EncodeBand(band_data, width, rows, step, buffer.data());
+					// 噪声过大而无法压缩的带以原始数据存储
+					const std::size_t raw_size = static_cast<std::size_t>(rows) * width;
+					if (size >= raw_size)
+					{
+						for (std::uint32_t row = 0; row < rows; ++row)
+						{
+							std::memcpy(buffer.data() + row * width, band_data + row * step, width);
+						}
+						BandSizes[band] = static_cast<std::uint32_t>(raw_size) | RawBandFlag;
+					}
+					else
+					{
+						BandSizes[band] = static_cast<std::uint32_t>(size);
+					}
+				}
+			});
+		});
+
+		std::size_t total_size = HeaderSize + band_count * sizeof(std::uint32_t);
+		for (auto band_size : BandSizes)
+		{
+			total_size += band_size & ~RawBandFlag;
+		}
+		output.resize(total_size);
+
+		auto* position = output.data();
+		WriteWord(position, Magic);
+		WriteWord(position + 4, width);
+		WriteWord(position + 8, height);
+		WriteWord(position + 12, band_rows);
+		WriteWord(position + 16, static_cast<std::uint32_t>(band_count));
+		position += HeaderSize;
+		for (auto band_size : BandSizes)
+		{
+			WriteWord(position, band_size);
+			position += sizeof(std::uint32_t);
+		}
+		for (std::size_t band = 0; band < band_count; ++band)
+		{
+			const auto size = BandSizes[band] & ~RawBandFlag;
+			std::memcpy(position, BandBuffers[band].data(), size);
+			position += size;
+		}
+	}
+
+	/// 解码
+	void BayerCodec::Decode(const unsigned char *data, std::size_t size, std::vector<unsigned char> &picture,
+	                        std::uint32_t &width, std::uint32_t &height)
+	{
+		if (size < HeaderSize || ReadWord(data) != Magic)
+		{
+			throw std::runtime_error("[BayerCodec::Decode] Not a Bayer Codec Stream.");
+		}
+
+		const auto picture_width = ReadWord(data + 4);
+		const auto picture_height = ReadWord(data + 8);
+		const auto band_rows = ReadWord(data + 12);
+		const std::size_t band_count = ReadWord(data + 16);
+		// 带数以64位计算，过大的带行数在32位下回绕后可能使带数为0，从而跳过全部解码
+		if (picture_width == 0 || picture_height == 0 || picture_width % 2 != 0 || picture_height % 2 != 0 ||
+		    band_rows == 0 || band_rows % 2 != 0 ||
+		    band_count != (std::uint64_t {picture_height} + band_rows - 1) / band_rows ||
+		    size < HeaderSize + band_count * sizeof(std::uint32_t))
+		{
+			throw std::runtime_error("[BayerCodec::Decode] Corrupted Header.");
+		}
+
+		// 由带表计算各带的起始位置，并核对其总和
+		std::vector<std::size_t> offsets(band_count + 1);
+		offsets[0] = HeaderSize + band_count * sizeof(std::uint32_t);
+		for (std::size_t band = 0; band < band_count; ++band)
+		{
+			offsets[band + 1] = offsets[band] + (ReadWord(data + HeaderSize + band * sizeof(std::uint32_t)) & ~RawBandFlag);
+		}
+		if (offsets[band_count] > size)
+		{
+			throw std::runtime_error("[BayerCodec::Decode] Truncated Stream.");
+		}
+
+		picture.resize(static_cast<std::size_t>(picture_width) * picture_height);
+		width = picture_width;
+		height = picture_height;
+
+		Arena.execute([&]{
+			tbb::parallel_for(tbb::blocked_range<std::size_t>(0, band_count, 1),
+			                  [&](const tbb::blocked_range<std::size_t>& range){
+				for (auto band = range.begin(); band != range.end(); ++band)
+				{
+					const auto first_row = static_cast<std::uint32_t>(band * band_rows);
+					const auto rows = std::min(band_rows, picture_height - first_row);
+					const auto band_size = offsets[band + 1] - offsets[band];
+					auto* band_picture = picture.data() + static_cast<std::size_t>(first_row) * picture_width;
+
+					if (ReadWord(data + HeaderSize + band * sizeof(std::uint32_t)) & RawBandFlag)
+					{
+						if (band_size != static_cast<std::size_t>(rows) * picture_width)
+						{
+							throw std::runtime_error("[BayerCodec::Decode] Corrupted Raw Band.");
+						}
+						std::memcpy(band_picture, data + offsets[band], band_size);
+					}
+					else
+					{
+						DecodeBand(data + offsets[band], band_size, picture_width, rows, band_picture);
+					}
+				}
+			});
+		});
+	}
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <tbb/task_arena.h>
+
+namespace RoboPioneers::Prometheus::Recording
+{
+	/**
+	 * @brief Bayer图像无损编解码器
+	 * @author Vincent
+	 * @details
+	 *  ~ 输入为8位单通道的Bayer原始图像。同一颜色的像素在横纵方向上均间隔一个像素，
+	 *    故预测只使用同一颜色平面上的邻居：左侧、上方与左上方相隔两个像素的同色像素，
+	 *    以中值边缘检测（MED，即LOCO-I的预测器）给出预测值。
+	 *  ~ 残差经过折叠映射为无符号数后，以自适应的Golomb-Rice码编码：四个颜色平面各自统计残差的均值，
+	 *    以此选择Rice参数；过长的一元码以转义码代替，单个像素最多占用24位。
+	 *  ~ 图像按行划分为若干个带，每个带独立预测与编码，带之间没有依赖，在TBB的任务区中并行处理；
+	 *    任务区的并发数在构造时指定，以免录制占满全部核心。
+	 *  ~ 编码后大于原始数据的带直接以原始数据存储，故编码结果不会比原始图像大出带表以外的空间。
+	 *  ~ 编码结果中的整数均以小端序存储。
+	 */
+	class BayerCodec
+	{
+	public:
+		/// 编码结果的识别码，即"BYR1"
+		static constexpr std::uint32_t Magic = 0x31525942;
+
+	protected:
+		/// 任务区
+		tbb::task_arena Arena;
+		/// 每个带的行数，为偶数
+		std::uint32_t BandRows {64};
+
+		/// 各个带的编码缓冲区，在多次编码之间复用
+		std::vector<std::vector<unsigned char>> BandBuffers;
+		/// 各个带的编码字节数，最高位表示以原始数据存储
+		std::vector<std::uint32_t> BandSizes;
+
+		/// 编码单个带，返回编码字节数
+		static std::size_t EncodeBand(const unsigned char* data, std::uint32_t width, std::uint32_t rows,
+		                              std::size_t step, unsigned char* output) noexcept;
+
+		/// 解码单个带
+		static void DecodeBand(const unsigned char* data, std::size_t size, std::uint32_t width, std::uint32_t rows,
+		                       unsigned char* picture);
+
+	public:
+		/**
+		 * @brief 构造编解码器
+		 * @param concurrency 编解码时使用的最大线程数
+		 */
+		explicit BayerCodec(int concurrency = 2);
+
+		/**
+		 * @brief 设置每个带的行数
+		 * @param band_rows 行数，须为正偶数，以保证每个带的颜色排列相同
+		 * @throw std::invalid_argument 当行数为零或为奇数
+		 */
+		void SetBandRows(std::uint32_t band_rows);
+
+		/// 获取每个带的行数
+		[[nodiscard]] inline std::uint32_t GetBandRows() const noexcept
+		{
+			return BandRows;
+		}
+
+		/**
+		 * @brief 编码
+		 * @param data 图像数据
+		 * @param width 宽度，须为偶数
+		 * @param height 高度，须为偶数
+		 * @param step 行字节数
+		 * @param output 编码结果，其容量在多次编码之间复用
+		 * @throw std::invalid_argument 当图像尺寸为零或不是偶数
+		 */
+		void Encode(const unsigned char* data, std::uint32_t width, std::uint32_t height, std::size_t step,
+		            std::vector<unsigned char>& output);
+
+		/**
+		 * @brief 解码
+		 * @param data 编码结果
+		 * @param size 编码结果的字节数
+		 * @param picture 解码后的图像，按行连续存放
+		 * @param width 解码后的图像宽度
+		 * @param height 解码后的图像高度
+		 * @throw std::runtime_error 当编码结果不完整或已损坏
+		 */
+		void Decode(const unsigned char* data, std::size_t size, std::vector<unsigned char>& picture,
+		            std::uint32_t& width, std::uint32_t& height);
+	};
+}
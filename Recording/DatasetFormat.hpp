@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace RoboPioneers::Prometheus::Recording
+{
+	/**
+	 * @brief 数据集文件格式
+	 * @details
+	 *  ~ 文件依次由文件头、若干条帧记录、帧索引与文件尾组成，整数均以小端序存储：
+	 *    | FileHeader | RecordHeader 载荷 元数据 | ... | IndexEntry × FrameCount | FileTrailer |
+	 *  ~ 每条帧记录以记录头开始，其后为载荷（按CodecType编码的图像）与可选的元数据，
+	 *    元数据与下一条记录均按8字节对齐，故映射后可直接按结构体访问。
+	 *  ~ 帧索引为定长项组成的数组，读取端映射文件后可按帧号直接定位；文件尾位于文件末尾，给出索引的位置。
+	 *  ~ 录制中断而没有写入索引与文件尾时，读取端可以依次扫描记录头重建索引。
+	 */
+	namespace DatasetFormat
+	{
+		/// 文件头识别码，即"PRDS"
+		constexpr std::uint32_t FileMagic = 0x53445250;
+		/// 记录头识别码，即"PRFR"
+		constexpr std::uint32_t RecordMagic = 0x52465250;
+		/// 文件尾识别码，即"PRDT"
+		constexpr std::uint32_t TrailerMagic = 0x54445250;
+		/// 格式版本
+		constexpr std::uint32_t Version = 1;
+		/// 帧记录的对齐字节数
+		constexpr std::size_t RecordAlignment = 8;
+
+		/// 向上对齐至记录对齐字节数
+		constexpr std::uint64_t AlignRecord(std::uint64_t size) noexcept
+		{
+			return (size + RecordAlignment - 1) / RecordAlignment * RecordAlignment;
+		}
+
+		/// 元数据相对记录头的偏移
+		constexpr std::uint64_t GetMetadataOffset(std::uint64_t payload_size) noexcept;
+
+		/// 整条记录的字节数，含末尾的对齐填充
+		constexpr std::uint64_t GetRecordSize(std::uint64_t payload_size, std::uint64_t metadata_size) noexcept;
+	}
+
+	/// 载荷编码方式
+	enum class CodecType : std::uint32_t
+	{
+		/// 按行连续存放的原始图像
+		Raw = 0,
+		/// BayerCodec编码的图像
+		Bayer = 1
+	};
+
+	/// 元数据类型
+	enum class MetadataType : std::uint32_t
+	{
+		/// 没有元数据
+		None = 0,
+		/// 帧总线上的FrameResult，即录制时的处理结果
+		FrameResult = 1
+	};
+
+	/// 文件头
+	struct FileHeader
+	{
+		/// 识别码
+		std::uint32_t Magic;
+		/// 格式版本
+		std::uint32_t Version;
+		/// 图像宽度
+		std::uint32_t Width;
+		/// 图像高度
+		std::uint32_t Height;
+		/// 开始录制的时间，为系统时钟的纳秒数
+		std::int64_t CreationTime;
+		/// 保留
+		std::uint8_t Reserved[36];
+		/// 以上各字段的CRC32C校验码
+		std::uint32_t CheckSum;
+	};
+
+	/// 帧的描述，同时出现在记录头与索引中
+	struct FrameDescription
+	{
+		/// 录制时的帧序号
+		std::uint64_t FrameIndex;
+		/// 相机给出的帧号
+		std::uint64_t SensorFrameID;
+		/// 相机给出的时间戳
+		std::uint64_t SensorTimeStamp;
+		/// 采集时间，为单调时钟的纳秒数
+		std::int64_t TimeStamp;
+		/// 载荷编码方式
+		CodecType Codec;
+		/// 元数据类型
+		MetadataType Metadata;
+	};
+
+	/// 记录头，位于每条帧记录的开头
+	struct RecordHeader
+	{
+		/// 识别码
+		std::uint32_t Magic;
+		/// 载荷的CRC32C校验码
+		std::uint32_t PayloadCheckSum;
+		/// 载荷字节数
+		std::uint32_t PayloadSize;
+		/// 元数据字节数
+		std::uint32_t MetadataSize;
+		/// 帧的描述
+		FrameDescription Description;
+	};
+
+	/// 索引项
+	struct IndexEntry
+	{
+		/// 记录头在文件中的偏移
+		std::uint64_t Offset;
+		/// 载荷的CRC32C校验码
+		std::uint32_t PayloadCheckSum;
+		/// 载荷字节数
+		std::uint32_t PayloadSize;
+		/// 元数据字节数
+		std::uint32_t MetadataSize;
+		/// 保留
+		std::uint32_t Reserved;
+		/// 帧的描述
+		FrameDescription Description;
+	};
+
+	/// 文件尾
+	struct FileTrailer
+	{
+		/// 识别码
+		std::uint32_t Magic;
+		/// 索引的CRC32C校验码
+		std::uint32_t IndexCheckSum;
+		/// 帧数
+		std::uint64_t FrameCount;
+		/// 索引在文件中的偏移
+		std::uint64_t IndexOffset;
+		/// 以上各字段的CRC32C校验码
+		std::uint32_t CheckSum;
+		/// 保留
+		std::uint32_t Reserved;
+	};
+
+	/// 元数据相对记录头的偏移
+	constexpr std::uint64_t DatasetFormat::GetMetadataOffset(std::uint64_t payload_size) noexcept
+	{
+		return sizeof(RecordHeader) + AlignRecord(payload_size);
+	}
+
+	/// 整条记录的字节数，含末尾的对齐填充
+	constexpr std::uint64_t DatasetFormat::GetRecordSize(std::uint64_t payload_size, std::uint64_t metadata_size) noexcept
+	{
+		return GetMetadataOffset(payload_size) + AlignRecord(metadata_size);
+	}
+
+	static_assert(std::is_trivially_copyable_v<FileHeader> && sizeof(FileHeader) == 64,
+			"Dataset file header layout changed.");
+	static_assert(sizeof(FrameDescription) == 40, "Dataset frame description layout changed.");
+	static_assert(sizeof(RecordHeader) == 56 && sizeof(RecordHeader) % DatasetFormat::RecordAlignment == 0,
+			"Dataset record header layout changed.");
+	static_assert(sizeof(IndexEntry) == 64, "Dataset index entry layout changed.");
+	static_assert(sizeof(FileTrailer) == 32, "Dataset file trailer layout changed.");
+}
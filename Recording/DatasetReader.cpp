@@ -0,0 +1,196 @@
+#include "DatasetReader.hpp"
+
+#include <SerialPortUtilities/CRCTool.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace RoboPioneers::Prometheus::Recording
+{
+	using SerialPort::Utilities::CRCTool;
+
+	/// 析构并关闭
+	DatasetReader::~DatasetReader()
+	{
+		Close();
+	}
+
+	/// 映射数据集文件
+	void DatasetReader::Open(const std::string &path)
+	{
+		Close();
+
+		int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (descriptor < 0)
+		{
+			throw std::runtime_error("[DatasetReader::Open] Failed to Open " + path + ".");
+		}
+		struct stat status {};
+		if (::fstat(descriptor, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(FileHeader))
+		{
+			::close(descriptor);
+			throw std::runtime_error("[DatasetReader::Open] " + path + " is not a Dataset.");
+		}
+		MappingSize = static_cast<std::size_t>(status.st_size);
+		void* mapping = ::mmap(nullptr, MappingSize, PROT_READ, MAP_SHARED, descriptor, 0);
+		::close(descriptor);
+		if (mapping == MAP_FAILED)
+		{
+			MappingSize = 0;
+			throw std::runtime_error("[DatasetReader::Open] Failed to Map " + path + ".");
+		}
+		Mapping = static_cast<const unsigned char*>(mapping);
+
+		Header = reinterpret_cast<const FileHeader*>(Mapping);
+		if (Header->Magic != DatasetFormat::FileMagic ||
+			Header->CheckSum != CRCTool::GetCRC32CCheckSum(Header, offsetof(FileHeader, CheckSum)))
+		{
+			Close();
+			throw std::runtime_error("[DatasetReader::Open] " + path + " is not a Dataset.");
+		}
+		if (Header->Version != DatasetFormat::Version)
+		{
+			Close();
+			throw std::runtime_error("[DatasetReader::Open] Unsupported Dataset Version of " + path + ".");
+		}
+
+		if (!LoadIndex())
+		{
+			RecoverIndex();
+		}
+	}
+
+	/// 解除映射
+	void DatasetReader::Close() noexcept
+	{
+		if (Mapping)
+		{
+			::munmap(const_cast<unsigned char*>(Mapping), MappingSize);
+		}
+		Mapping = nullptr;
+		MappingSize = 0;
+		Header = nullptr;
+		Index = nullptr;
+		FrameCount = 0;
+		RecoveredIndex.clear();
+	}
+
+	/// 读取文件尾中的索引
+	bool DatasetReader::LoadIndex()
+	{
+		// 正常关闭的文件总是对齐的
+		if (MappingSize < sizeof(FileHeader) + sizeof(FileTrailer) ||
+			MappingSize % DatasetFormat::RecordAlignment != 0)
+		{
+			return false;
+		}
+
+		const auto* trailer = reinterpret_cast<const FileTrailer*>(Mapping + MappingSize - sizeof(FileTrailer));
+		if (trailer->Magic != DatasetFormat::TrailerMagic ||
+			trailer->CheckSum != CRCTool::GetCRC32CCheckSum(trailer, offsetof(FileTrailer, CheckSum)))
+		{
+			return false;
+		}
+		// 索引须恰好位于记录与文件尾之间
+		const std::uint64_t index_limit = MappingSize - sizeof(FileTrailer);
+		if (trailer->IndexOffset < sizeof(FileHeader) || trailer->IndexOffset > index_limit ||
+			trailer->FrameCount != (index_limit - trailer->IndexOffset) / sizeof(IndexEntry) ||
+			(index_limit - trailer->IndexOffset) % sizeof(IndexEntry) != 0 ||
+			trailer->IndexOffset % DatasetFormat::RecordAlignment != 0)
+		{
+			return false;
+		}
+		const auto* index = reinterpret_cast<const IndexEntry*>(Mapping + trailer->IndexOffset);
+		const std::size_t frame_count = trailer->FrameCount;
+		if (trailer->IndexCheckSum != CRCTool::GetCRC32CCheckSum(index, frame_count * sizeof(IndexEntry)))
+		{
+			return false;
+		}
+		// 索引项所指的记录须位于索引之前，此后访问载荷无需再检查边界；
+		// 先比较偏移再比较剩余长度，以免损坏的偏移与记录长度相加后回绕而通过检查
+		for (std::size_t frame = 0; frame < frame_count; ++frame)
+		{
+			const auto& entry = index[frame];
+			if (entry.Offset < sizeof(FileHeader) || entry.Offset > trailer->IndexOffset ||
+				DatasetFormat::GetRecordSize(entry.PayloadSize, entry.MetadataSize) > trailer->IndexOffset - entry.Offset)
+			{
+				return false;
+			}
+		}
+
+		Index = index;
+		FrameCount = frame_count;
+		return true;
+	}
+
+	/// 扫描记录头重建索引
+	void DatasetReader::RecoverIndex()
+	{
+		RecoveredIndex.clear();
+		std::uint64_t offset = sizeof(FileHeader);
+		while (offset + sizeof(RecordHeader) <= MappingSize)
+		{
+			const auto* header = reinterpret_cast<const RecordHeader*>(Mapping + offset);
+			if (header->Magic != DatasetFormat::RecordMagic) break;
+
+			const std::uint64_t end = offset + DatasetFormat::GetRecordSize(header->PayloadSize, header->MetadataSize);
+			// 最后一条记录可能只写入了一部分
+			if (end > MappingSize) break;
+			const auto* payload = Mapping + offset + sizeof(RecordHeader);
+			if (header->PayloadCheckSum != CRCTool::GetCRC32CCheckSum(payload, header->PayloadSize)) break;
+
+			IndexEntry entry {};
+			entry.Offset = offset;
+			entry.PayloadCheckSum = header->PayloadCheckSum;
+			entry.PayloadSize = header->PayloadSize;
+			entry.MetadataSize = header->MetadataSize;
+			entry.Description = header->Description;
+			RecoveredIndex.push_back(entry);
+
+			offset = end;
+		}
+		Index = RecoveredIndex.data();
+		FrameCount = RecoveredIndex.size();
+	}
+
+	/// 获取帧
+	DatasetReader::FrameView DatasetReader::GetFrame(std::size_t frame) const
+	{
+		if (frame >= FrameCount)
+		{
+			throw std::out_of_range("[DatasetReader::GetFrame] Frame Number is out of Range.");
+		}
+		const auto& entry = Index[frame];
+		FrameView view;
+		view.Description = &entry.Description;
+		view.Payload = Mapping + entry.Offset + sizeof(RecordHeader);
+		view.PayloadSize = entry.PayloadSize;
+		if (entry.MetadataSize != 0)
+		{
+			view.Metadata = Mapping + entry.Offset + DatasetFormat::GetMetadataOffset(entry.PayloadSize);
+			view.MetadataSize = entry.MetadataSize;
+		}
+		return view;
+	}
+
+	/// 按采集时间查找帧
+	std::size_t DatasetReader::FindByTime(std::int64_t time_stamp) const noexcept
+	{
+		const auto* found = std::partition_point(Index, Index + FrameCount,
+			[time_stamp](const IndexEntry& entry){
+				return entry.Description.TimeStamp < time_stamp;
+		});
+		return static_cast<std::size_t>(found - Index);
+	}
+
+	/// 校验帧的载荷
+	bool DatasetReader::VerifyFrame(std::size_t frame) const
+	{
+		auto view = GetFrame(frame);
+		return Index[frame].PayloadCheckSum == CRCTool::GetCRC32CCheckSum(view.Payload, view.PayloadSize);
+	}
+}
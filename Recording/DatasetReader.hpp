@@ -0,0 +1,140 @@
+#pragma once
+
+#include "DatasetFormat.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace RoboPioneers::Prometheus::Recording
+{
+	/**
+	 * @brief 数据集读取器
+	 * @author Vincent
+	 * @details
+	 *  ~ 以只读方式映射整个文件，载荷与元数据直接指向映射区域，读取不产生拷贝。
+	 *  ~ 文件尾完整时直接使用文件中的索引，按帧号定位为O(1)，按时间定位为二分查找。
+	 *  ~ 文件尾缺失或校验失败时（录制被中断），依次扫描记录头重建索引，并丢弃最后一条不完整的记录。
+	 *  ~ 多个读取器可以同时映射同一文件，以便分片并行处理。
+	 */
+	class DatasetReader
+	{
+	public:
+		/// 帧视图，指针指向映射区域，在关闭前有效
+		struct FrameView
+		{
+			/// 帧的描述
+			const FrameDescription* Description {nullptr};
+			/// 载荷
+			const unsigned char* Payload {nullptr};
+			/// 载荷字节数
+			std::size_t PayloadSize {0};
+			/// 元数据，没有时为空
+			const unsigned char* Metadata {nullptr};
+			/// 元数据字节数
+			std::size_t MetadataSize {0};
+		};
+
+	protected:
+		/// 映射区域
+		const unsigned char* Mapping {nullptr};
+		/// 映射区域字节数
+		std::size_t MappingSize {0};
+
+		/// 文件头
+		const FileHeader* Header {nullptr};
+		/// 索引，指向映射区域或重建的索引
+		const IndexEntry* Index {nullptr};
+		/// 帧数
+		std::size_t FrameCount {0};
+
+		/// 重建的索引
+		std::vector<IndexEntry> RecoveredIndex;
+
+		/// 读取文件尾中的索引，文件尾不可用时返回false
+		bool LoadIndex();
+		/// 扫描记录头重建索引
+		void RecoverIndex();
+
+	public:
+		/// 析构，若已开启则关闭
+		~DatasetReader();
+
+		/**
+		 * @brief 映射数据集文件
+		 * @param path 文件路径
+		 * @throw std::runtime_error 当文件无法打开、映射，或文件头无效
+		 */
+		void Open(const std::string& path);
+
+		/// 解除映射
+		void Close() noexcept;
+
+		/// 是否已开启
+		[[nodiscard]] inline bool IsOpened() const noexcept
+		{
+			return Mapping != nullptr;
+		}
+
+		/// 索引是否由扫描重建，即文件未经正常关闭
+		[[nodiscard]] inline bool IsRecovered() const noexcept
+		{
+			return Index != nullptr && Index == RecoveredIndex.data();
+		}
+
+		/// 获取帧数
+		[[nodiscard]] inline std::size_t GetFrameCount() const noexcept
+		{
+			return FrameCount;
+		}
+
+		/// 获取图像宽度
+		[[nodiscard]] inline std::uint32_t GetWidth() const noexcept
+		{
+			return Header ? Header->Width : 0;
+		}
+
+		/// 获取图像高度
+		[[nodiscard]] inline std::uint32_t GetHeight() const noexcept
+		{
+			return Header ? Header->Height : 0;
+		}
+
+		/// 获取开始录制的时间
+		[[nodiscard]] inline std::int64_t GetCreationTime() const noexcept
+		{
+			return Header ? Header->CreationTime : 0;
+		}
+
+		/// 获取索引项，不检查帧号
+		[[nodiscard]] inline const IndexEntry& GetEntry(std::size_t frame) const noexcept
+		{
+			return Index[frame];
+		}
+
+		/**
+		 * @brief 获取帧
+		 * @param frame 帧号
+		 * @return 帧视图
+		 * @throw std::out_of_range 当帧号超出范围
+		 */
+		[[nodiscard]] FrameView GetFrame(std::size_t frame) const;
+
+		/**
+		 * @brief 按采集时间查找帧
+		 * @param time_stamp 采集时间，为单调时钟的纳秒数
+		 * @return 采集时间不早于给定时间的第一帧的帧号，没有时返回帧数
+		 */
+		[[nodiscard]] std::size_t FindByTime(std::int64_t time_stamp) const noexcept;
+
+		/**
+		 * @brief 校验帧的载荷
+		 * @param frame 帧号
+		 * @retval true 载荷的校验码与记录时一致
+		 * @retval false 载荷已损坏
+		 * @throw std::out_of_range 当帧号超出范围
+		 */
+		[[nodiscard]] bool VerifyFrame(std::size_t frame) const;
+	};
+}
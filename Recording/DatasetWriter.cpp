@@ -0,0 +1,136 @@
+#include "DatasetWriter.hpp"
+
+#include <SerialPortUtilities/CRCTool.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace RoboPioneers::Prometheus::Recording
+{
+	using SerialPort::Utilities::CRCTool;
+
+	/// 写入缓冲区大小，足以容纳数帧编码后的图像
+	static constexpr std::size_t WriteBufferSize = 4 << 20;
+
+	/// 析构并关闭
+	DatasetWriter::~DatasetWriter()
+	{
+		if (File)
+		{
+			try
+			{
+				Close();
+			}
+			catch (...)
+			{}
+		}
+	}
+
+	/// 写入数据
+	void DatasetWriter::Write(const void *data, std::size_t size)
+	{
+		if (size != 0 && std::fwrite(data, 1, size, File) != size)
+		{
+			throw std::runtime_error("[DatasetWriter::Write] Failed to Write " + Path + ".");
+		}
+		Offset += size;
+	}
+
+	/// 创建数据集文件
+	void DatasetWriter::Open(const std::string &path, std::uint32_t width, std::uint32_t height,
+	                         std::size_t expected_frame_count)
+	{
+		if (File)
+		{
+			Close();
+		}
+
+		File = std::fopen(path.c_str(), "wb");
+		if (!File)
+		{
+			throw std::runtime_error("[DatasetWriter::Open] Failed to Create " + path + ".");
+		}
+		std::setvbuf(File, nullptr, _IOFBF, WriteBufferSize);
+		Path = path;
+		Offset = 0;
+		Index.clear();
+		Index.reserve(expected_frame_count);
+
+		FileHeader header {};
+		header.Magic = DatasetFormat::FileMagic;
+		header.Version = DatasetFormat::Version;
+		header.Width = width;
+		header.Height = height;
+		header.CreationTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::system_clock::now().time_since_epoch()).count();
+		header.CheckSum = CRCTool::GetCRC32CCheckSum(&header, offsetof(FileHeader, CheckSum));
+		Write(&header, sizeof(header));
+	}
+
+	/// 追加一帧
+	void DatasetWriter::Append(const FrameDescription &description, const void *payload, std::size_t payload_size,
+	                           const void *metadata, std::size_t metadata_size)
+	{
+		if (!File)
+		{
+			throw std::runtime_error("[DatasetWriter::Append] Dataset is not Opened.");
+		}
+		if (!metadata)
+		{
+			metadata_size = 0;
+		}
+
+		IndexEntry entry {};
+		entry.Offset = Offset;
+		entry.PayloadCheckSum = CRCTool::GetCRC32CCheckSum(payload, payload_size);
+		entry.PayloadSize = static_cast<std::uint32_t>(payload_size);
+		entry.MetadataSize = static_cast<std::uint32_t>(metadata_size);
+		entry.Description = description;
+		if (metadata_size == 0)
+		{
+			entry.Description.Metadata = MetadataType::None;
+		}
+
+		RecordHeader header {};
+		header.Magic = DatasetFormat::RecordMagic;
+		header.PayloadCheckSum = entry.PayloadCheckSum;
+		header.PayloadSize = entry.PayloadSize;
+		header.MetadataSize = entry.MetadataSize;
+		header.Description = entry.Description;
+
+		// 载荷与元数据之后均以零填充至对齐位置
+		static constexpr unsigned char padding[DatasetFormat::RecordAlignment] {};
+		Write(&header, sizeof(header));
+		Write(payload, payload_size);
+		Write(padding, DatasetFormat::AlignRecord(payload_size) - payload_size);
+		Write(metadata, metadata_size);
+		Write(padding, DatasetFormat::AlignRecord(metadata_size) - metadata_size);
+
+		Index.push_back(entry);
+	}
+
+	/// 写入索引与文件尾并关闭文件
+	void DatasetWriter::Close()
+	{
+		if (!File) return;
+
+		FileTrailer trailer {};
+		trailer.Magic = DatasetFormat::TrailerMagic;
+		trailer.FrameCount = Index.size();
+		trailer.IndexOffset = Offset;
+		trailer.IndexCheckSum = CRCTool::GetCRC32CCheckSum(Index.data(), Index.size() * sizeof(IndexEntry));
+		trailer.CheckSum = CRCTool::GetCRC32CCheckSum(&trailer, offsetof(FileTrailer, CheckSum));
+
+		auto* file = File;
+		File = nullptr;
+		bool succeeded = std::fwrite(Index.data(), sizeof(IndexEntry), Index.size(), file) == Index.size() &&
+		                 std::fwrite(&trailer, sizeof(trailer), 1, file) == 1;
+		succeeded = std::fclose(file) == 0 && succeeded;
+		if (!succeeded)
+		{
+			throw std::runtime_error("[DatasetWriter::Close] Failed to Write Index of " + Path + ".");
+		}
+		Offset += Index.size() * sizeof(IndexEntry) + sizeof(trailer);
+	}
+}
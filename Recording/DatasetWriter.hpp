@@ -0,0 +1,87 @@
+#pragma once
+
+#include "DatasetFormat.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace RoboPioneers::Prometheus::Recording
+{
+	/**
+	 * @brief 数据集写入器
+	 * @author Vincent
+	 * @details
+	 *  ~ 帧记录依次追加到文件中，索引保存在内存里，关闭时写在所有记录之后，最后写入文件尾。
+	 *  ~ 写入经过较大的用户态缓冲区，每帧只有一次拷贝；载荷的CRC32C校验码在追加时计算，优先使用硬件指令。
+	 *  ~ 未经关闭而中断的文件缺少索引，读取端将扫描记录头重建索引。
+	 */
+	class DatasetWriter
+	{
+	protected:
+		/// 文件
+		std::FILE* File {nullptr};
+		/// 文件路径
+		std::string Path;
+		/// 下一条记录的偏移
+		std::uint64_t Offset {0};
+		/// 帧索引
+		std::vector<IndexEntry> Index;
+
+		/// 写入数据，失败时抛出异常
+		void Write(const void* data, std::size_t size);
+
+	public:
+		/// 析构，若已开启则关闭
+		~DatasetWriter();
+
+		/**
+		 * @brief 创建数据集文件并写入文件头
+		 * @param path 文件路径，已存在的文件将被覆盖
+		 * @param width 图像宽度
+		 * @param height 图像高度
+		 * @param expected_frame_count 预计的帧数，用于预留索引的空间
+		 * @throw std::runtime_error 当无法创建文件
+		 */
+		void Open(const std::string& path, std::uint32_t width, std::uint32_t height,
+		          std::size_t expected_frame_count = 0);
+
+		/**
+		 * @brief 追加一帧
+		 * @param description 帧的描述
+		 * @param payload 载荷，即按照description.Codec编码的图像
+		 * @param payload_size 载荷字节数
+		 * @param metadata 元数据，可以为空
+		 * @param metadata_size 元数据字节数
+		 * @throw std::runtime_error 当未开启或写入失败
+		 */
+		void Append(const FrameDescription& description, const void* payload, std::size_t payload_size,
+		            const void* metadata = nullptr, std::size_t metadata_size = 0);
+
+		/**
+		 * @brief 写入索引与文件尾并关闭文件
+		 * @throw std::runtime_error 当写入失败
+		 */
+		void Close();
+
+		/// 是否已开启
+		[[nodiscard]] inline bool IsOpened() const noexcept
+		{
+			return File != nullptr;
+		}
+
+		/// 获取已写入的帧数
+		[[nodiscard]] inline std::size_t GetFrameCount() const noexcept
+		{
+			return Index.size();
+		}
+
+		/// 获取已写入的字节数
+		[[nodiscard]] inline std::uint64_t GetSize() const noexcept
+		{
+			return Offset;
+		}
+	};
+}
@@ -0,0 +1,7 @@
+#include "BayerCodec.hpp"
+#include "DatasetFormat.hpp"
+#include "DatasetWriter.hpp"
+#include "DatasetReader.hpp"
+
+namespace RoboPioneers::Prometheus::Recording
+{}
@@ -0,0 +1,6 @@
+#include "SceneDescription.hpp"
+#include "SceneGenerator.hpp"
+#include "SceneStream.hpp"
+
+namespace RoboPioneers::Prometheus::Simulation
+{}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <vector>
+#include <opencv4/opencv2/opencv.hpp>
+
+namespace RoboPioneers::Prometheus::Simulation
+{
+	/// 灯条颜色类型
+	enum class LightColor
+	{
+		Red, Blue
+	};
+
+	/**
+	 * @brief 装甲板摆放
+	 * @details
+	 *  ~ 装甲板的尺寸由其类型与距离按照针孔模型决定。
+	 */
+	struct ArmorPlacement
+	{
+		/// 装甲板中心在图像中的位置，单位为像素
+		cv::Point2f Center;
+		/// 距离，单位为毫米
+		float Distance {3000.0f};
+		/// 横滚角，即装甲板在图像平面内的倾斜角度，单位为度
+		float Roll {0.0f};
+		/// 偏航角，决定两灯条间距的透视缩短，单位为度
+		float Yaw {0.0f};
+		/// 是否为大装甲板
+		bool Big {false};
+		/// 在图像中的运动速度，单位为像素每帧
+		cv::Point2f Velocity {0.0f, 0.0f};
+	};
+
+	/**
+	 * @brief 场景描述
+	 * @details
+	 *  ~ 描述一帧或一个序列的全部可控因素；相同的描述与种子总是生成相同的图像。
+	 */
+	struct SceneDescription
+	{
+		/// 图像尺寸
+		cv::Size PictureSize {1280, 1024};
+		/// 焦距，单位为像素
+		float FocalLength {1200.0f};
+		/// 灯条颜色
+		LightColor Color {LightColor::Blue};
+
+		/// 装甲板
+		std::vector<ArmorPlacement> Armors;
+
+		/// 干扰灯条数量，干扰灯条与真实灯条颜色相同，但位置与朝向随机
+		int DistractorCount {0};
+		/// 噪点数量，噪点为随机颜色与亮度的小圆斑
+		int NoiseSpeckCount {0};
+		/// 传感器高斯噪声的标准差，单位为灰度值
+		float SensorNoise {0.0f};
+
+		/// 运动模糊长度，单位为像素，小于等于1时不模糊
+		int MotionBlurLength {0};
+		/// 运动模糊方向，单位为度
+		float MotionBlurAngle {0.0f};
+
+		/// 随机数种子，决定干扰灯条的布局，并与帧序号共同决定噪点与传感器噪声
+		unsigned int Seed {0};
+	};
+
+	/**
+	 * @brief 装甲板真值
+	 * @details
+	 *  ~ 记录一块装甲板在图像中实际被绘制的位置。
+	 */
+	struct ArmorTruth
+	{
+		/// 装甲板中心，单位为像素
+		cv::Point2f Center;
+		/// 距离，单位为毫米
+		float Distance {0.0f};
+		/// 是否为大装甲板
+		bool Big {false};
+		/// 左侧灯条
+		cv::RotatedRect LeftLightBar;
+		/// 右侧灯条
+		cv::RotatedRect RightLightBar;
+	};
+
+	/// 一帧的真值
+	struct GroundTruth
+	{
+		/// 帧号
+		unsigned long long FrameID {0};
+		/// 场景中完整可见的装甲板
+		std::vector<ArmorTruth> Armors;
+		/// 干扰灯条数量
+		int DistractorCount {0};
+	};
+}
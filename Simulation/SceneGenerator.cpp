@@ -0,0 +1,235 @@
+#include "SceneGenerator.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+namespace RoboPioneers::Prometheus::Simulation
+{
+	namespace
+	{
+		/// 角度转弧度
+		inline float ToRadian(float degree)
+		{
+			return degree * static_cast<float>(CV_PI) / 180.0f;
+		}
+
+		/// 获取灯条颜色
+		cv::Scalar GetLightColor(LightColor color)
+		{
+			// 蓝色在HSV空间中约为(104, 165, 255)，红色约为(0, 165, 255)
+			return color == LightColor::Blue ? cv::Scalar(255, 190, 90) : cv::Scalar(90, 90, 255);
+		}
+
+		/// 绘制实心旋转矩形
+		void DrawRotatedRectangle(cv::Mat& picture, const cv::RotatedRect& rectangle, const cv::Scalar& color)
+		{
+			std::array<cv::Point2f, 4> vertices;
+			rectangle.points(vertices.data());
+
+			std::array<cv::Point, 4> points;
+			std::transform(vertices.begin(), vertices.end(), points.begin(), [](const cv::Point2f& vertex){
+				return cv::Point(cvRound(vertex.x), cvRound(vertex.y));
+			});
+			cv::fillConvexPoly(picture, points.data(), static_cast<int>(points.size()), color, cv::LINE_AA);
+		}
+
+		/// 判断旋转矩形是否完全位于图像内
+		bool IsInside(const cv::RotatedRect& rectangle, const cv::Size& size)
+		{
+			auto bounding = rectangle.boundingRect();
+			return bounding.x >= 0 && bounding.y >= 0 &&
+				bounding.x + bounding.width <= size.width && bounding.y + bounding.height <= size.height;
+		}
+	}
+
+	/// 生成随机场景描述
+	SceneDescription SceneGenerator::MakeRandomDescription(const cv::Size &picture_size, int armor_count,
+														  double big_armor_ratio, int distractor_count,
+														  int noise_speck_count, unsigned int seed)
+	{
+		SceneDescription description;
+		description.PictureSize = picture_size;
+		description.DistractorCount = distractor_count;
+		description.NoiseSpeckCount = noise_speck_count;
+		description.Seed = seed;
+
+		std::mt19937 random_engine(seed);
+		std::uniform_real_distribution<float> x_distribution(0.1f * picture_size.width, 0.9f * picture_size.width);
+		std::uniform_real_distribution<float> y_distribution(0.1f * picture_size.height, 0.9f * picture_size.height);
+		std::uniform_real_distribution<float> distance_distribution(1000.0f, 6000.0f);
+		std::uniform_real_distribution<float> angle_distribution(-20.0f, 20.0f);
+		std::uniform_real_distribution<float> velocity_distribution(-8.0f, 8.0f);
+		std::bernoulli_distribution big_distribution(std::clamp(big_armor_ratio, 0.0, 1.0));
+
+		description.Armors.reserve(armor_count);
+		for (int index = 0; index < armor_count; ++index)
+		{
+			ArmorPlacement placement;
+			placement.Center = cv::Point2f(x_distribution(random_engine), y_distribution(random_engine));
+			placement.Distance = distance_distribution(random_engine);
+			placement.Roll = angle_distribution(random_engine);
+			placement.Yaw = angle_distribution(random_engine);
+			placement.Big = big_distribution(random_engine);
+			placement.Velocity = cv::Point2f(velocity_distribution(random_engine), velocity_distribution(random_engine));
+			description.Armors.push_back(placement);
+		}
+
+		return description;
+	}
+
+	/// 计算装甲板在图像中的灯条
+	ArmorTruth SceneGenerator::ProjectArmor(const SceneDescription &description, const ArmorPlacement &placement)
+	{
+		const auto scale = description.FocalLength / placement.Distance;
+		const auto span = (placement.Big ? BigArmorSpan : SmallArmorSpan) * scale * std::cos(ToRadian(placement.Yaw));
+		const cv::Size2f bar_size(std::max(LightBarWidth * scale, 1.0f), LightBarLength * scale);
+
+		// 灯条沿装甲板的水平方向分布于中心两侧
+		const cv::Point2f half_span(0.5f * span * std::cos(ToRadian(placement.Roll)),
+							  0.5f * span * std::sin(ToRadian(placement.Roll)));
+
+		ArmorTruth truth;
+		truth.Center = placement.Center;
+		truth.Distance = placement.Distance;
+		truth.Big = placement.Big;
+		truth.LeftLightBar = cv::RotatedRect(placement.Center - half_span, bar_size, placement.Roll);
+		truth.RightLightBar = cv::RotatedRect(placement.Center + half_span, bar_size, placement.Roll);
+		return truth;
+	}
+
+	/// 绘制BGR图像
+	const cv::Mat& SceneGenerator::RenderColor(const SceneDescription &description, GroundTruth &truth,
+	                                           unsigned long long frame_index)
+	{
+		ColorBuffer.create(description.PictureSize, CV_8UC3);
+		ColorBuffer.setTo(cv::Scalar(20, 20, 20));
+
+		truth.Armors.clear();
+		truth.DistractorCount = description.DistractorCount;
+
+		const auto light_color = GetLightColor(description.Color);
+		// 干扰灯条属于场景，只由种子决定；噪点与传感器噪声由种子与帧序号共同决定，逐帧变化且可以复现
+		std::mt19937 random_engine(description.Seed);
+		std::seed_seq noise_seed {description.Seed, static_cast<unsigned int>(frame_index),
+		                          static_cast<unsigned int>(frame_index >> 32)};
+		std::mt19937 noise_engine(noise_seed);
+
+		//==============================
+		// 装甲板
+		//==============================
+
+		for (const auto& placement : description.Armors)
+		{
+			auto armor = ProjectArmor(description, placement);
+			DrawRotatedRectangle(ColorBuffer, armor.LeftLightBar, light_color);
+			DrawRotatedRectangle(ColorBuffer, armor.RightLightBar, light_color);
+
+			// 仅记录完整可见的装甲板
+			if (IsInside(armor.LeftLightBar, description.PictureSize) &&
+				IsInside(armor.RightLightBar, description.PictureSize))
+			{
+				truth.Armors.push_back(armor);
+			}
+		}
+
+		//==============================
+		// 干扰灯条
+		//==============================
+
+		std::uniform_real_distribution<float> x_distribution(0.0f, static_cast<float>(description.PictureSize.width));
+		std::uniform_real_distribution<float> y_distribution(0.0f, static_cast<float>(description.PictureSize.height));
+		std::uniform_real_distribution<float> length_distribution(10.0f, 80.0f);
+		std::uniform_real_distribution<float> angle_distribution(0.0f, 180.0f);
+
+		for (int index = 0; index < description.DistractorCount; ++index)
+		{
+			auto length = length_distribution(random_engine);
+			cv::RotatedRect bar(cv::Point2f(x_distribution(random_engine), y_distribution(random_engine)),
+					   cv::Size2f(std::max(length / 4.5f, 1.0f), length), angle_distribution(random_engine));
+			DrawRotatedRectangle(ColorBuffer, bar, light_color);
+		}
+
+		//==============================
+		// 噪点
+		//==============================
+
+		std::uniform_int_distribution<int> radius_distribution(1, 3);
+		std::uniform_int_distribution<int> channel_distribution(0, 255);
+
+		for (int index = 0; index < description.NoiseSpeckCount; ++index)
+		{
+			cv::Point center(static_cast<int>(x_distribution(noise_engine)),
+					static_cast<int>(y_distribution(noise_engine)));
+			cv::Scalar color(channel_distribution(noise_engine), channel_distribution(noise_engine),
+					channel_distribution(noise_engine));
+			cv::circle(ColorBuffer, center, radius_distribution(noise_engine), color, cv::FILLED);
+		}
+
+		//==============================
+		// 运动模糊
+		//==============================
+
+		if (description.MotionBlurLength > 1)
+		{
+			const auto length = description.MotionBlurLength;
+			cv::Mat kernel = cv::Mat::zeros(length, length, CV_32F);
+			const cv::Point2f center(0.5f * (length - 1), 0.5f * (length - 1));
+			const cv::Point2f direction(std::cos(ToRadian(description.MotionBlurAngle)),
+							   std::sin(ToRadian(description.MotionBlurAngle)));
+			cv::line(kernel, center - direction * (0.5f * (length - 1)), center + direction * (0.5f * (length - 1)),
+				cv::Scalar(1.0), 1, cv::LINE_AA);
+			kernel /= cv::sum(kernel)[0];
+
+			cv::filter2D(ColorBuffer, BlurBuffer, -1, kernel);
+			std::swap(ColorBuffer, BlurBuffer);
+		}
+
+		//==============================
+		// 传感器噪声
+		//==============================
+
+		if (description.SensorNoise > 0.0f)
+		{
+			NoiseBuffer.create(description.PictureSize, CV_16SC3);
+			std::uint64_t noise_state = noise_engine();
+			noise_state = (noise_state << 32) | noise_engine();
+			cv::RNG noise_generator(noise_state);
+			noise_generator.fill(NoiseBuffer, cv::RNG::NORMAL, 0.0, description.SensorNoise);
+			cv::add(ColorBuffer, NoiseBuffer, ColorBuffer, cv::noArray(), CV_8UC3);
+		}
+
+		return ColorBuffer;
+	}
+
+	/// 生成BayerBG原始图像
+	void SceneGenerator::RenderBayer(const SceneDescription &description, GroundTruth &truth, cv::Mat &bayer_picture,
+	                                 unsigned long long frame_index)
+	{
+		Mosaic(RenderColor(description, truth, frame_index), bayer_picture);
+	}
+
+	/// 将BGR图像采样为BayerBG原始图像
+	void SceneGenerator::Mosaic(const cv::Mat &color_picture, cv::Mat &bayer_picture)
+	{
+		CV_Assert(color_picture.type() == CV_8UC3);
+		bayer_picture.create(color_picture.size(), CV_8UC1);
+
+		for (int row = 0; row < color_picture.rows; ++row)
+		{
+			const auto* source = color_picture.ptr<cv::Vec3b>(row);
+			auto* target = bayer_picture.ptr<unsigned char>(row);
+
+			for (int column = 0; column < color_picture.cols; ++column)
+			{
+				// BGR通道索引：偶数行偶数列取红色，奇数行奇数列取蓝色，其余取绿色
+				int channel = 1;
+				if ((row & 1) == 0 && (column & 1) == 0) channel = 2;
+				else if ((row & 1) == 1 && (column & 1) == 1) channel = 0;
+
+				target[column] = source[column][channel];
+			}
+		}
+	}
+}
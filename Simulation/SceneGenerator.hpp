@@ -0,0 +1,91 @@
+#pragma once
+
+#include "SceneDescription.hpp"
+
+#include <random>
+#include <opencv4/opencv2/opencv.hpp>
+
+namespace RoboPioneers::Prometheus::Simulation
+{
+	/**
+	 * @brief 场景生成器
+	 * @author Vincent
+	 * @details
+	 *  ~ 生成器按照场景描述绘制BGR图像，并将其按照BayerBG格式采样为单通道的原始图像，
+	 *    与相机输出的数据格式一致。
+	 *  ~ 装甲板与灯条的物理尺寸采用比赛规则中的尺寸，经针孔模型投影到图像上。
+	 *  ~ 生成器持有绘制所需的缓冲区，在图像尺寸不变时重复生成不会重新分配内存。
+	 */
+	class SceneGenerator
+	{
+	public:
+		/// 灯条长度，单位为毫米
+		static constexpr float LightBarLength = 55.0f;
+		/// 灯条宽度，单位为毫米
+		static constexpr float LightBarWidth = 12.0f;
+		/// 小装甲板灯条间距，单位为毫米
+		static constexpr float SmallArmorSpan = 135.0f;
+		/// 大装甲板灯条间距，单位为毫米
+		static constexpr float BigArmorSpan = 230.0f;
+
+	protected:
+		/// BGR绘制缓冲区
+		cv::Mat ColorBuffer;
+		/// 模糊缓冲区
+		cv::Mat BlurBuffer;
+		/// 噪声缓冲区
+		cv::Mat NoiseBuffer;
+
+		/**
+		 * @brief 计算装甲板在图像中的灯条
+		 * @param description 场景描述
+		 * @param placement 装甲板摆放
+		 * @return 装甲板真值
+		 */
+		static ArmorTruth ProjectArmor(const SceneDescription& description, const ArmorPlacement& placement);
+
+	public:
+		/**
+		 * @brief 生成随机场景描述
+		 * @param picture_size 图像尺寸
+		 * @param armor_count 装甲板数量
+		 * @param big_armor_ratio 大装甲板所占比例，取值为[0,1]
+		 * @param distractor_count 干扰灯条数量
+		 * @param noise_speck_count 噪点数量
+		 * @param seed 随机数种子
+		 * @return 场景描述，装甲板的距离在1米至6米之间，横滚角与偏航角均在正负20度之间
+		 */
+		static SceneDescription MakeRandomDescription(const cv::Size& picture_size, int armor_count,
+												 double big_armor_ratio, int distractor_count,
+												 int noise_speck_count, unsigned int seed);
+
+		/**
+		 * @brief 绘制BGR图像
+		 * @param description 场景描述
+		 * @param truth 输出的真值
+		 * @param frame_index 帧序号，与场景的随机数种子共同决定噪点与传感器噪声，干扰灯条的布局与其无关
+		 * @return BGR图像，为内部缓冲区，在下一次生成前有效
+		 */
+		const cv::Mat& RenderColor(const SceneDescription& description, GroundTruth& truth,
+		                           unsigned long long frame_index = 0);
+
+		/**
+		 * @brief 生成BayerBG原始图像
+		 * @param description 场景描述
+		 * @param truth 输出的真值
+		 * @param bayer_picture 输出的单通道BayerBG图像，尺寸与类型正确时不会重新分配
+		 * @param frame_index 帧序号，与场景的随机数种子共同决定噪点与传感器噪声
+		 */
+		void RenderBayer(const SceneDescription& description, GroundTruth& truth, cv::Mat& bayer_picture,
+		                 unsigned long long frame_index = 0);
+
+		/**
+		 * @brief 将BGR图像采样为BayerBG原始图像
+		 * @param color_picture BGR图像
+		 * @param bayer_picture 输出的单通道图像
+		 * @details
+		 *  ~ 采样方式与OpenCV中的COLOR_BayerBG2BGR相对应：偶数行偶数列为红色，奇数行奇数列为蓝色，其余为绿色。
+		 */
+		static void Mosaic(const cv::Mat& color_picture, cv::Mat& bayer_picture);
+	};
+}
@@ -0,0 +1,107 @@
+#include "SceneStream.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace RoboPioneers::Prometheus::Simulation
+{
+	/// 构造并指定初始场景
+	SceneStream::SceneStream(SceneDescription description) : Description(std::move(description))
+	{}
+
+	/// 析构并关闭真值记录文件
+	SceneStream::~SceneStream()
+	{
+		if (TruthFile)
+		{
+			std::fclose(TruthFile);
+		}
+	}
+
+	/// 将每帧的真值记录到文件
+	void SceneStream::RecordGroundTruth(const std::string &path)
+	{
+		if (TruthFile)
+		{
+			std::fclose(TruthFile);
+		}
+		TruthFile = std::fopen(path.c_str(), "w");
+		if (!TruthFile)
+		{
+			throw std::runtime_error("[SceneStream::RecordGroundTruth] Failed to Open File: " + path);
+		}
+	}
+
+	/// 按照速度移动装甲板
+	void SceneStream::Advance()
+	{
+		const auto width = static_cast<float>(Description.PictureSize.width);
+		const auto height = static_cast<float>(Description.PictureSize.height);
+
+		for (auto& armor : Description.Armors)
+		{
+			armor.Center += armor.Velocity;
+
+			if (armor.Center.x < 0.0f || armor.Center.x >= width)
+			{
+				armor.Velocity.x = -armor.Velocity.x;
+				armor.Center.x = std::clamp(armor.Center.x, 0.0f, width - 1.0f);
+			}
+			if (armor.Center.y < 0.0f || armor.Center.y >= height)
+			{
+				armor.Velocity.y = -armor.Velocity.y;
+				armor.Center.y = std::clamp(armor.Center.y, 0.0f, height - 1.0f);
+			}
+		}
+	}
+
+	/// 生成下一帧
+	Cameras::Galaxy::RawPicture SceneStream::Next()
+	{
+		if (FrameCount > 0)
+		{
+			Advance();
+		}
+
+		auto& bayer_picture = SwapChain[FrameCount % SwapChainLength];
+		Generator.RenderBayer(Description, CurrentTruth, bayer_picture, FrameCount);
+
+		++FrameCount;
+		CurrentTruth.FrameID = FrameCount;
+		WriteTruth();
+
+		Cameras::Galaxy::RawPicture picture(bayer_picture.data, bayer_picture.cols, bayer_picture.rows);
+		picture.Size = static_cast<int>(bayer_picture.total());
+		picture.FrameID = FrameCount;
+		picture.TimeStamp = static_cast<unsigned long long>(FrameInterval.count()) * FrameCount;
+		picture.ReceiveTime = std::chrono::steady_clock::now();
+		return picture;
+	}
+
+	/// 将最近一帧的真值写入记录文件
+	void SceneStream::WriteTruth()
+	{
+		if (!TruthFile) return;
+
+		auto write_light_bar = [this](const cv::RotatedRect& light_bar){
+			std::fprintf(TruthFile, "[%.2f,%.2f,%.2f,%.2f,%.2f]", light_bar.center.x, light_bar.center.y,
+				light_bar.size.width, light_bar.size.height, light_bar.angle);
+		};
+
+		std::fprintf(TruthFile, "{\"frame\":%llu,\"distractors\":%d,\"armors\":[",
+			   CurrentTruth.FrameID, CurrentTruth.DistractorCount);
+		for (std::size_t index = 0; index < CurrentTruth.Armors.size(); ++index)
+		{
+			const auto& armor = CurrentTruth.Armors[index];
+			std::fprintf(TruthFile, "%s{\"x\":%.2f,\"y\":%.2f,\"distance\":%.1f,\"big\":%s,\"left\":",
+				index == 0 ? "" : ",", armor.Center.x, armor.Center.y, armor.Distance,
+				armor.Big ? "true" : "false");
+			write_light_bar(armor.LeftLightBar);
+			std::fputs(",\"right\":", TruthFile);
+			write_light_bar(armor.RightLightBar);
+			std::fputc('}', TruthFile);
+		}
+		std::fputs("]}\n", TruthFile);
+	}
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "SceneDescription.hpp"
+#include "SceneGenerator.hpp"
+
+#include <GalaxyCamera/RawPicture.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <opencv4/opencv2/opencv.hpp>
+
+namespace RoboPioneers::Prometheus::Simulation
+{
+	/**
+	 * @brief 场景流
+	 * @author Vincent
+	 * @details
+	 *  ~ 场景流以相机的形式逐帧输出合成的BayerBG原始图像，每帧中装甲板按照其速度移动，遇到图像边缘时反弹。
+	 *  ~ 与大恒相机的驱动相同，原始图像存储在交换链中，返回的数据指针将在数帧后被复用。
+	 *  ~ 合成相机的时间戳以纳秒计数，即时间戳频率为1GHz。
+	 */
+	class SceneStream
+	{
+	public:
+		/// 交换链长度
+		static constexpr std::size_t SwapChainLength = 3;
+		/// 合成相机的时间戳频率
+		static constexpr unsigned long long TimeStampTickFrequency = 1000000000ull;
+
+	protected:
+		/// 场景生成器
+		SceneGenerator Generator;
+		/// 当前的场景描述
+		SceneDescription Description;
+
+		/// 原始图像交换链
+		std::array<cv::Mat, SwapChainLength> SwapChain;
+		/// 已生成的帧数
+		unsigned long long FrameCount {0};
+		/// 最近一帧的真值
+		GroundTruth CurrentTruth;
+
+		/// 真值记录文件，为空则不记录
+		std::FILE* TruthFile {nullptr};
+
+		/// 按照速度移动装甲板
+		void Advance();
+		/// 将最近一帧的真值写入记录文件
+		void WriteTruth();
+
+	public:
+		/// 帧间隔，用于生成时间戳
+		std::chrono::nanoseconds FrameInterval {std::chrono::nanoseconds(1000000000 / 200)};
+
+		/**
+		 * @brief 构造并指定初始场景
+		 * @param description 初始场景描述
+		 */
+		explicit SceneStream(SceneDescription description);
+
+		/// 析构并关闭真值记录文件
+		~SceneStream();
+
+		SceneStream(const SceneStream&) = delete;
+		SceneStream& operator=(const SceneStream&) = delete;
+
+		/**
+		 * @brief 将每帧的真值记录到文件
+		 * @param path 文件路径，每行为一帧的JSON对象
+		 */
+		void RecordGroundTruth(const std::string& path);
+
+		/**
+		 * @brief 生成下一帧
+		 * @return 原始图像，其数据在交换链轮转一周前有效
+		 */
+		Cameras::Galaxy::RawPicture Next();
+
+		/// 获取最近一帧的真值
+		[[nodiscard]] inline const GroundTruth& GetGroundTruth() const noexcept
+		{
+			return CurrentTruth;
+		}
+
+		/// 获取当前的场景描述，可在帧间修改
+		[[nodiscard]] inline SceneDescription& GetDescription() noexcept
+		{
+			return Description;
+		}
+	};
+}
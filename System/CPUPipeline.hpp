@@ -0,0 +1,27 @@
+#pragma once
+
+#include <Core/PrometheusCoreCPU.hpp>
+
+#include "./Stages/CuttingChooser.hpp"
+
+namespace RoboPioneers::Prometheus
+{
+	/// 相机数据源提供的槽：原始图像，以及帧池提供的上一帧目标信息
+	using CameraSourceSlots = Core::SlotList<Core::Slots::RawPicture, Core::Slots::PreviousTarget>;
+
+	/**
+	 * @brief CPU处理流水线
+	 * @tparam Hook 阶段钩子类型
+	 * @details
+	 *  ~ 全部阶段均在CPU上执行，用于没有CUDA设备的环境，如回放与基准测试。
+	 *  ~ 仅依赖CPU核心库，可以在没有CUDA的环境中构建。
+	 */
+	template<typename Hook = Core::NullHook>
+	using CPUPipeline = Core::Pipeline<CameraSourceSlots, Hook,
+		Core::BayerConverter,
+		CuttingChooser,
+		Core::CPUColorFilter,
+		Core::LightBarDetector,
+		Core::ArmorMatcher,
+		Core::ArmorSelector>;
+}
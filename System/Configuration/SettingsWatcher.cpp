@@ -0,0 +1,137 @@
+#include "SettingsWatcher.hpp"
+
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+namespace RoboPioneers::Prometheus
+{
+	/// 构造并绑定快照发布器
+	SettingsWatcher::SettingsWatcher(SnapshotPublisher<VisionParameters> &target, std::string file_path) :
+		Target(target), FilePath(std::move(file_path))
+	{}
+
+	/// 析构
+	SettingsWatcher::~SettingsWatcher()
+	{
+		Stop();
+	}
+
+	/// 读取配置文件并发布参数快照
+	bool SettingsWatcher::Reload()
+	{
+		if (!boost::filesystem::exists(FilePath)) return false;
+
+		try
+		{
+			boost::property_tree::ptree json_node;
+			boost::property_tree::read_json(FilePath, json_node);
+			Target.Publish(LoadVisionParameters(json_node));
+		}
+		catch (boost::property_tree::ptree_error& error)
+		{
+			FailureCount.fetch_add(1, std::memory_order_relaxed);
+			std::clog << "[Warning] Failed to Reload " << FilePath << ": " << error.what()
+			          << ", Previous Settings are Kept." << std::endl;
+			return false;
+		}
+
+		ReloadCount.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/// 启动监视
+	void SettingsWatcher::Start()
+	{
+		if (Worker.joinable()) return;
+
+		auto directory = boost::filesystem::absolute(FilePath).parent_path();
+
+		NotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (NotifyDescriptor < 0)
+		{
+			throw std::runtime_error("[SettingsWatcher::Start] Failed to Create Inotify Instance.");
+		}
+		if (inotify_add_watch(NotifyDescriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+		{
+			::close(NotifyDescriptor);
+			NotifyDescriptor = -1;
+			throw std::runtime_error("[SettingsWatcher::Start] Failed to Watch " + directory.string() + ".");
+		}
+
+		Running = true;
+		Worker = std::thread([this]{ Run(); });
+	}
+
+	/// 停止监视
+	void SettingsWatcher::Stop()
+	{
+		Running = false;
+		if (Worker.joinable())
+		{
+			Worker.join();
+		}
+		if (NotifyDescriptor >= 0)
+		{
+			::close(NotifyDescriptor);
+			NotifyDescriptor = -1;
+		}
+	}
+
+	/// 读取并丢弃全部待处理事件
+	bool SettingsWatcher::DrainEvents()
+	{
+		auto file_name = boost::filesystem::path(FilePath).filename().string();
+		bool matched = false;
+
+		alignas(inotify_event) std::array<char, 4096> buffer {};
+		while (true)
+		{
+			auto size = ::read(NotifyDescriptor, buffer.data(), buffer.size());
+			if (size <= 0) break;
+
+			for (long offset = 0; offset < size;)
+			{
+				inotify_event event {};
+				std::memcpy(&event, buffer.data() + offset, sizeof(event));
+				if (event.len > 0 && file_name == buffer.data() + offset + sizeof(inotify_event))
+				{
+					matched = true;
+				}
+				offset += static_cast<long>(sizeof(inotify_event) + event.len);
+			}
+		}
+		return matched;
+	}
+
+	/// 工作线程主循环
+	void SettingsWatcher::Run()
+	{
+		pollfd descriptor {NotifyDescriptor, POLLIN, 0};
+
+		while (Running)
+		{
+			// 等待设有超时，以便检查退出条件
+			if (::poll(&descriptor, 1, 100) <= 0 || !DrainEvents()) continue;
+
+			// 等待事件平息，避免读取到只写入了一半的文件
+			while (Running && ::poll(&descriptor, 1, static_cast<int>(SettleTime.count())) > 0)
+			{
+				DrainEvents();
+			}
+			if (!Running) break;
+
+			if (Reload())
+			{
+				std::clog << "[Message] Settings Reloaded from " << FilePath << "." << std::endl;
+			}
+		}
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "SnapshotPublisher.hpp"
+#include "VisionParameters.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace RoboPioneers::Prometheus
+{
+	/**
+	 * @brief 配置文件监视器
+	 * @author Vincent
+	 * @details
+	 *  ~ 在后台线程中通过inotify监视配置文件所在的目录，配置文件被写入或被替换后重新读取，
+	 *    并将新的视觉参数快照发布到快照发布器；解析在后台线程中完成，不占用处理线程。
+	 *  ~ 监视目录而非文件本身，以便覆盖编辑器先写临时文件再重命名的保存方式。
+	 *  ~ 一次保存往往产生多个事件，监视器在事件平息一段时间后才重新读取。
+	 *  ~ 新的配置文件无法解析时保留原有的快照，并记录失败次数。
+	 */
+	class SettingsWatcher
+	{
+	protected:
+		/// 参数快照发布器
+		SnapshotPublisher<VisionParameters>& Target;
+		/// 配置文件路径
+		std::string FilePath;
+
+		/// 事件平息的等待时间
+		std::chrono::milliseconds SettleTime {50};
+
+		/// 工作线程
+		std::thread Worker;
+		/// 是否运行
+		std::atomic_bool Running {false};
+		/// inotify文件描述符
+		int NotifyDescriptor {-1};
+
+		/// 成功重新读取的次数
+		std::atomic<std::uint64_t> ReloadCount {0};
+		/// 重新读取失败的次数
+		std::atomic<std::uint64_t> FailureCount {0};
+
+		/// 读取并丢弃全部待处理事件，返回其中是否有配置文件的事件
+		bool DrainEvents();
+
+		/// 工作线程主循环
+		void Run();
+
+	public:
+		/**
+		 * @brief 构造并绑定快照发布器
+		 * @param target 参数快照发布器
+		 * @param file_path 配置文件路径
+		 */
+		explicit SettingsWatcher(SnapshotPublisher<VisionParameters>& target, std::string file_path = "Settings.json");
+
+		/// 析构，若工作线程仍在运行则停止
+		~SettingsWatcher();
+
+		/**
+		 * @brief 读取配置文件并发布参数快照
+		 * @retval true 当读取并发布成功
+		 * @retval false 当配置文件不存在或无法解析，此时原有的快照保持不变
+		 */
+		bool Reload();
+
+		/**
+		 * @brief 启动监视
+		 * @throw std::runtime_error 当无法创建inotify实例或监视配置文件所在的目录
+		 */
+		void Start();
+
+		/// 停止监视
+		void Stop();
+
+		/// 获取成功重新读取的次数
+		[[nodiscard]] inline std::uint64_t GetReloadCount() const noexcept
+		{
+			return ReloadCount.load(std::memory_order_relaxed);
+		}
+
+		/// 获取重新读取失败的次数
+		[[nodiscard]] inline std::uint64_t GetFailureCount() const noexcept
+		{
+			return FailureCount.load(std::memory_order_relaxed);
+		}
+	};
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace RoboPioneers::Prometheus
+{
+	/**
+	 * @brief 快照发布器
+	 * @tparam Value 快照类型
+	 * @author Vincent
+	 * @details
+	 *  ~ 写入方构造新的不可变快照后以一次原子指针交换发布，读取方以原子指针读取当前快照，双方互不等待。
+	 *  ~ 被替换的旧快照不会立即释放：读取方在使用快照期间将其指针登记在风险指针中，
+	 *    写入方只释放未被登记的旧快照，仍被登记的旧快照留待下一次发布或析构时释放。
+	 *  ~ 仅支持一个读取线程；写入方之间以互斥量串行，不影响读取方。
+	 */
+	template<typename Value>
+	class SnapshotPublisher
+	{
+	protected:
+		/// 当前快照
+		std::atomic<const Value*> Current {nullptr};
+		/// 读取方正在使用的快照
+		std::atomic<const Value*> Hazard {nullptr};
+		/// 已发布的快照数量
+		std::atomic<std::uint64_t> Version {0};
+
+		/// 写入方互斥量
+		std::mutex WriterMutex;
+		/// 已被替换但尚未释放的快照
+		std::vector<std::unique_ptr<const Value>> Retired;
+
+		/// 释放未被读取方使用的旧快照，需持有写入方互斥量
+		void Reclaim()
+		{
+			auto hazard = Hazard.load(std::memory_order_seq_cst);
+			auto iterator = Retired.begin();
+			while (iterator != Retired.end())
+			{
+				if (iterator->get() != hazard)
+				{
+					iterator = Retired.erase(iterator);
+				}
+				else
+				{
+					++iterator;
+				}
+			}
+		}
+
+	public:
+		SnapshotPublisher() = default;
+		SnapshotPublisher(const SnapshotPublisher&) = delete;
+		SnapshotPublisher& operator=(const SnapshotPublisher&) = delete;
+
+		/// 析构，释放全部快照
+		~SnapshotPublisher()
+		{
+			delete Current.load(std::memory_order_acquire);
+		}
+
+		/**
+		 * @brief 发布新的快照
+		 * @param value 快照的值
+		 */
+		void Publish(Value value)
+		{
+			auto snapshot = std::make_unique<const Value>(std::move(value));
+
+			std::lock_guard lock(WriterMutex);
+			auto previous = Current.exchange(snapshot.release(), std::memory_order_seq_cst);
+			Version.fetch_add(1, std::memory_order_release);
+			if (previous != nullptr)
+			{
+				Retired.emplace_back(previous);
+			}
+			Reclaim();
+		}
+
+		/// 获取已发布的快照数量，可用于判断是否有新的快照
+		[[nodiscard]] inline std::uint64_t GetVersion() const noexcept
+		{
+			return Version.load(std::memory_order_acquire);
+		}
+
+		/**
+		 * @brief 获取当前快照，只能由读取线程调用
+		 * @return 当前快照，尚未发布时为空指针
+		 * @details 返回的快照在调用Release或下一次调用Acquire之前保持有效。
+		 */
+		const Value* Acquire() noexcept
+		{
+			auto snapshot = Current.load(std::memory_order_acquire);
+			while (true)
+			{
+				// 登记后再次确认快照仍为当前快照，此后写入方必然能看到登记
+				Hazard.store(snapshot, std::memory_order_seq_cst);
+				auto current = Current.load(std::memory_order_seq_cst);
+				if (current == snapshot) return snapshot;
+				snapshot = current;
+			}
+		}
+
+		/// 结束对快照的使用，只能由读取线程调用
+		void Release() noexcept
+		{
+			Hazard.store(nullptr, std::memory_order_release);
+		}
+
+		/**
+		 * @brief 若有新的快照，则以其调用访问函数，只能由读取线程调用
+		 * @param seen_version 读取方已处理的快照数量，处理后被更新
+		 * @param visitor 访问函数，参数为快照的常引用
+		 * @retval true 当有新的快照并已访问
+		 * @retval false 当没有新的快照
+		 * @details 没有新的快照时只有一次原子读取的开销，适合在每帧开始时调用。
+		 */
+		template<typename Visitor>
+		bool ConsumeUpdate(std::uint64_t& seen_version, Visitor&& visitor)
+		{
+			auto version = GetVersion();
+			if (version == seen_version) return false;
+
+			auto snapshot = Acquire();
+			if (snapshot != nullptr)
+			{
+				visitor(*snapshot);
+			}
+			Release();
+			seen_version = version;
+			return snapshot != nullptr;
+		}
+	};
+}
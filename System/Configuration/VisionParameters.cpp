@@ -0,0 +1,55 @@
+#include "VisionParameters.hpp"
+
+#include <string>
+
+namespace RoboPioneers::Prometheus
+{
+	/// 读取一种颜色的过滤阈值
+	static VisionParameters::ColorMask LoadColorMask(const boost::property_tree::ptree& json_node,
+	                                                 const std::string& mask)
+	{
+		VisionParameters::ColorMask color_mask;
+		color_mask.MinHue = json_node.get<int>(mask + ".Hue.Min");
+		color_mask.MaxHue = json_node.get<int>(mask + ".Hue.Max");
+		color_mask.MinSaturation = json_node.get<int>(mask + ".Saturation.Min");
+		color_mask.MaxSaturation = json_node.get<int>(mask + ".Saturation.Max");
+		color_mask.MinValue = json_node.get<int>(mask + ".Value.Min");
+		color_mask.MaxValue = json_node.get<int>(mask + ".Value.Max");
+		return color_mask;
+	}
+
+	/// 从配置文件的JSON节点读取视觉参数
+	VisionParameters LoadVisionParameters(const boost::property_tree::ptree& json_node)
+	{
+		VisionParameters parameters;
+
+		parameters.RedMask = LoadColorMask(json_node, "Mask.Red");
+		parameters.BlueMask = LoadColorMask(json_node, "Mask.Blue");
+
+		parameters.MinArea = json_node.get<int>("LightBar.MinArea");
+		parameters.MinFillingRatio = json_node.get<int>("LightBar.MinFillingRatio");
+
+		parameters.MaxAngleDifference = json_node.get<int>("LightBar.MaxAngleDifference");
+		parameters.MaxDeltaYHeightRatio = json_node.get<int>("LightBar.DeltaYHeightRatio.Max");
+
+		parameters.MinHeightDistanceRatioBigArmor = json_node.get<int>("BigArmor.HeightDistanceRatio.Min");
+		parameters.MaxHeightDistanceRatioBigArmor = json_node.get<int>("BigArmor.HeightDistanceRatio.Max");
+		parameters.MinWidthDistanceRatioBigArmor = json_node.get<int>("BigArmor.WidthDistanceRatio.Min");
+		parameters.MaxWidthDistanceRatioBigArmor = json_node.get<int>("BigArmor.WidthDistanceRatio.Max");
+
+		parameters.MinHeightDistanceRatioSmallArmor = json_node.get<int>("SmallArmor.HeightDistanceRatio.Min");
+		parameters.MaxHeightDistanceRatioSmallArmor = json_node.get<int>("SmallArmor.HeightDistanceRatio.Max");
+		parameters.MinWidthDistanceRatioSmallArmor = json_node.get<int>("SmallArmor.WidthDistanceRatio.Min");
+		parameters.MaxWidthDistanceRatioSmallArmor = json_node.get<int>("SmallArmor.WidthDistanceRatio.Max");
+
+		// 目标预测为可选项，未配置时不开启
+		parameters.PredictionEnabled = json_node.get<bool>("Prediction.Enabled", false);
+		parameters.PredictionAlpha = json_node.get<double>("Prediction.Alpha", parameters.PredictionAlpha);
+		parameters.PredictionBeta = json_node.get<double>("Prediction.Beta", parameters.PredictionBeta);
+		parameters.PredictionGamma = json_node.get<double>("Prediction.Gamma", parameters.PredictionGamma);
+		parameters.ActuationDelay = std::chrono::microseconds(static_cast<long>(
+				json_node.get<double>("Prediction.ActuationDelay", 5.0) * 1000));
+
+		return parameters;
+	}
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+#include <boost/property_tree/ptree.hpp>
+
+namespace RoboPioneers::Prometheus
+{
+	/**
+	 * @brief 视觉参数快照
+	 * @details
+	 *  ~ 包含Settings.json中可在运行中修改的阈值，各项与配置文件中的同名项含义一致。
+	 *  ~ 快照发布后不再修改，由处理线程在帧的边界上复制到各阶段。
+	 */
+	struct VisionParameters
+	{
+		/// 颜色过滤阈值
+		struct ColorMask
+		{
+			/// 色调下界
+			int MinHue {};
+			/// 色调上界
+			int MaxHue {};
+			/// 饱和度下界
+			int MinSaturation {};
+			/// 饱和度上界
+			int MaxSaturation {};
+			/// 亮度下界
+			int MinValue {};
+			/// 亮度上界
+			int MaxValue {};
+		};
+
+		/// 敌方为红色时的颜色过滤阈值
+		ColorMask RedMask;
+		/// 敌方为蓝色时的颜色过滤阈值
+		ColorMask BlueMask;
+
+		/// 灯条最小面积
+		int MinArea {};
+		/// 灯条最小填充比
+		int MinFillingRatio {};
+
+		/// 最大转角偏差值
+		int MaxAngleDifference {};
+		/// 最大Y坐标-高度比例，单位1%
+		int MaxDeltaYHeightRatio {};
+
+		/// 大装甲板的最小高度-距离比例，单位1%
+		int MinHeightDistanceRatioBigArmor {};
+		/// 大装甲板的最大高度-距离比例，单位1%
+		int MaxHeightDistanceRatioBigArmor {};
+		/// 大装甲板的最小宽度-距离比例，单位1%
+		int MinWidthDistanceRatioBigArmor {};
+		/// 大装甲板的最大宽度-距离比例，单位1%
+		int MaxWidthDistanceRatioBigArmor {};
+
+		/// 小装甲板的最小高度-距离比例，单位1%
+		int MinHeightDistanceRatioSmallArmor {};
+		/// 小装甲板的最大高度-距离比例，单位1%
+		int MaxHeightDistanceRatioSmallArmor {};
+		/// 小装甲板的最小宽度-距离比例，单位1%
+		int MinWidthDistanceRatioSmallArmor {};
+		/// 小装甲板的最大宽度-距离比例，单位1%
+		int MaxWidthDistanceRatioSmallArmor {};
+
+		/// 是否开启目标预测
+		bool PredictionEnabled {false};
+		/// 预测滤波器的位置增益
+		double PredictionAlpha {0.5};
+		/// 预测滤波器的速度增益
+		double PredictionBeta {0.1};
+		/// 预测滤波器的加速度增益
+		double PredictionGamma {0.0};
+		/// 执行机构延迟
+		std::chrono::microseconds ActuationDelay {5000};
+	};
+
+	/**
+	 * @brief 从配置文件的JSON节点读取视觉参数
+	 * @param json_node 配置文件的根节点
+	 * @return 视觉参数快照
+	 * @throw boost::property_tree::ptree_error 当缺少必需的项或项的格式错误
+	 * @details 目标预测的各项为可选项，缺省时使用默认值。
+	 */
+	VisionParameters LoadVisionParameters(const boost::property_tree::ptree& json_node);
+}
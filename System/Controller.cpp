@@ -6,12 +6,17 @@
 #include <pthread.h>
 #include <iostream>
 #include <thread>
+#include <future>
+#include <array>
+#include <algorithm>
+#include <stdexcept>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
 #include <boost/filesystem.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
 
-#include <SerialPortUtilities/CRCTool.hpp>
-#include <SerialPortUtilities/BytesAccessor.hpp>
+#include "./Protocol/ResultPacket.hpp"
 
 namespace RoboPioneers::Prometheus
 {
@@ -29,177 +34,460 @@ namespace RoboPioneers::Prometheus
 		sched_setaffinity(0, sizeof(mask), &mask);
 	}
 
-	/// 执行方法
-	void Controller::Launch()
+	/// 与下位机握手
+	Controller::ColorType Controller::ConnectSerial()
 	{
 		#ifndef DEBUG
 			SerialConnection.Open();
 		#endif
 
-		while (true)
+		// 读取下位机发送的颜色码，空读取或颜色码为0时继续等待；读取缓冲区在栈上，不分配内存
+		std::array<unsigned char, 64> team_data {};
+		unsigned long team_data_size = 0;
+		while (team_data_size == 0 || team_data[0] == 0)
 		{
-			std::vector<unsigned char> team_data;
-			while(true)
+			if (LaunchCancelled)
 			{
-				team_data = SerialConnection.ReadBytes(-1);
-				std::cout << "Color Code Receive: " << static_cast<unsigned int>(team_data[0]) << std::endl;
-				if (static_cast<unsigned int>(team_data[0]) != 0)
-				{
-					break;
-				}
+				throw std::runtime_error("[Controller::ConnectSerial] Launch is Cancelled.");
 			}
+			// 限时等待数据，以便定期检查启动是否已被取消；串口未开启时由ReadTo抛出异常
+			if (SerialConnection.IsOpened() && !SerialConnection.WaitForData(HandshakePollInterval)) continue;
 
-			if (team_data[0] <= 9)
+			team_data_size = SerialConnection.ReadTo(team_data.data(), team_data.size());
+			if (team_data_size > 0)
 			{
-				EnemyColor = ColorType::Blue;
-				std::cout << "Enemy Color: Blue" << std::endl;
+				std::cout << "Color Code Receive: " << static_cast<unsigned int>(team_data[0]) << std::endl;
+			}
+		}
+
+		ColorType enemy_color;
+		std::array<unsigned char, 3> response {0xFF, 0, 0xFF};
+		if (team_data[0] <= 9)
+		{
+			enemy_color = ColorType::Blue;
+			std::cout << "Enemy Color: Blue" << std::endl;
+			response[1] = 1;
+		}
+		else
+		{
+			enemy_color = ColorType::Red;
+			std::cout << "Enemy Color: Red" << std::endl;
+			response[1] = 2;
+		}
+		SerialConnection.Write(response.data(), response.size());
+
+		#ifndef DEBUG
+		// 握手完成后启用异步写入，视觉线程只提交结果包，未发出的旧结果将被新结果替换
+		SerialConnection.StartAsyncWriter(SerialPort::Port::AsyncWriteMode::Coalescing);
+		// 在后台与下位机同步时钟，时间同步请求经由不可合并的通道发送
+		ClockSync.Start();
+		#endif
 
-				std::vector<unsigned char> response;
-				response.push_back(0xFF);
-				response.push_back(1);
-				response.push_back(0xFF);
-				SerialConnection.Write(response);
+		return enemy_color;
+	}
 
-				break;
+	/// 开启相机
+	void Controller::OpenCamera()
+	{
+		// 开启失败后的重试间隔从较短的时间开始倍增，既能在相机上电后尽快开启，又不会频繁地枚举设备
+		auto retry_interval = CameraRetryInitialInterval;
+		while (!Camera.IsOpened() && !LaunchCancelled)
+		{
+			try
+			{
+				Camera.Open();
 			}
-			else
+			catch (std::exception& error)
 			{
-				EnemyColor = ColorType::Red;
-				std::cout << "Enemy Color: Red" << std::endl;
+				std::cout << "[Error] Failed to Open Camera: '" << error.what() << "', will Attempt in "
+				          << retry_interval.count() << " Milliseconds." << std::endl;
+				// 启动被取消时立即被唤醒
+				std::unique_lock lock(LaunchMutex);
+				LaunchCondition.wait_for(lock, retry_interval, [this]{ return LaunchCancelled.load(); });
+				retry_interval = std::min(retry_interval * 2, CameraRetryMaxInterval);
+			}
+		}
+	}
 
-				std::vector<unsigned char> response;
-				response.push_back(0xFF);
-				response.push_back(2);
-				response.push_back(0xFF);
-				SerialConnection.Write(response);
+	/// 处理帧的故障
+	void Controller::HandleFrameFault(Core::Frame &frame, const std::exception_ptr &error)
+	{
+		using PipelineType = decltype(Pipeline);
 
-				break;
+		auto stage_index = Pipeline.GetCurrentStage();
+		Pipeline.ClearCurrentStage();
+		if (stage_index >= PipelineType::StageCount)
+		{
+			stage_index = Core::FaultMonitor::OutsideStage;
+		}
+
+		auto type = Core::FaultMonitor::Classify(error);
+		auto action = Faults.RecordFailure(stage_index, type);
+
+		// 故障帧的结果不可信，下一帧不再沿用其目标，也不锁定其兴趣区
+		frame.Target.Found = false;
+		frame.PredictedTarget.Found = false;
+		frame.PredictedTime = frame.ReceiveTime;
+
+		// 持续的故障每帧都会发生，日志只在计数为2的幂时输出
+		auto count = Faults.GetCount(stage_index, type);
+		if ((count & (count - 1)) == 0)
+		{
+			std::string message;
+			try
+			{
+				std::rethrow_exception(error);
 			}
+			catch (std::exception& exception)
+			{
+				message = exception.what();
+			}
+			catch (...)
+			{
+				message = "Non-standard Exception";
+			}
+			std::clog << "[Warning] Frame Dropped by " << Core::FaultMonitor::GetTypeName(type) << " Fault in Stage "
+			          << Faults.GetStageName(stage_index) << " (" << count << " Times): " << message << std::endl;
+		}
+
+		switch (action)
+		{
+			case Core::FaultAction::ResetStage:
+				if (stage_index < PipelineType::StageCount && Pipeline.ResetStage(stage_index))
+				{
+					std::clog << "[Warning] Fault Budget Exceeded, Stage "
+					          << Faults.GetStageName(stage_index) << " has been Reset." << std::endl;
+					break;
+				}
+				// 该阶段没有跨帧保留的状态可以丢弃，重置不会改变其行为，直接请求重启
+				std::clog << "[Warning] Fault Budget Exceeded, Stage " << Faults.GetStageName(stage_index)
+				          << " can not be Reset, Restart Requested." << std::endl;
+				RestartRequested = true;
+				break;
+			case Core::FaultAction::Restart:
+				std::clog << "[Warning] Stage " << Faults.GetStageName(stage_index)
+				          << " did not Recover after Resetting, Restart Requested." << std::endl;
+				RestartRequested = true;
+				break;
+			default:
+				break;
 		}
+	}
 
-		OnInstall();
+	/// 取消启动
+	void Controller::CancelLaunch(std::future<void>& camera_ready, std::future<ColorType>& serial_ready)
+	{
+		{
+			std::lock_guard lock(LaunchMutex);
+			LaunchCancelled = true;
+		}
+		LaunchCondition.notify_all();
 
-	    std::this_thread::sleep_for(std::chrono::seconds(3));
+		// 已经取得结果的future不再有效，其线程已经退出
+		if (camera_ready.valid()) camera_ready.wait();
+		if (serial_ready.valid()) serial_ready.wait();
+	}
 
-		Cameras::Galaxy::RawPicture raw_picture;
+	/// 执行方法
+	int Controller::Launch()
+	{
+		const auto launch_time = std::chrono::steady_clock::now();
 
+		/*
+		 * 允许当前线程及子线程覆盖全部的CPU核心
+		 * 对于JetPack4.4而言，两个Denver大核因为执行延迟问题被单独隔离，需要手动指定在其上工作的线程
+		 * 须在创建启动线程之前设置，以便其继承该亲和度
+		 */
+		SetCurrentThreadCPUAffinity({0,1,2,3,4,5});
+
+		// 相机开启与串口握手互不依赖，均在后台线程中进行，当前线程同时完成配置加载与各阶段的预热
+		LaunchCancelled = false;
+		auto camera_ready = std::async(std::launch::async, [this]{ OpenCamera(); });
+		auto serial_ready = std::async(std::launch::async, [this]{ return ConnectSerial(); });
+
+		// 任何一步失败时，后台线程可能仍在等待相机或下位机，future的析构将无限期阻塞，故先取消并等待再抛出
 		try
-        {
-		    while (true)
-            {
-                #ifdef DEBUG
-                // 等待按下ASCII为27的键（ESC键），按下则终止程序
-                if (cv::waitKey(1) == 27)
-                {
-                    break;
-                }
-                #endif
-
-                /* 此处OpenCV可能会抛出异常，故加上该try块，以跳过因通信故障导致异常的帧
-                 */
-
-                raw_picture = Camera.GetCurrentPicture();
-
-                cv::Mat original_picture(cv::Size(raw_picture.Width, raw_picture.Height), CV_8UC1, raw_picture.Data);
-                cv::cvtColor(original_picture, original_picture, cv::COLOR_BayerBG2BGR);
-                CuttingStage.OriginalPicture = &original_picture;
-                CuttingStage.Execute();
-                #ifdef DEBUG
-                cv::imshow("Cutting Result", CuttingStage.CuttingPicture);
-                #endif
-                cv::cuda::GpuMat gpu_original_picture;
-                gpu_original_picture.upload(CuttingStage.CuttingPicture, ColorStage.Stream);
-                ColorStage.BGRPicture = &gpu_original_picture;
-                ColorStage.Execute();
-                #ifdef DEBUG
-                cv::imshow("Binary", ColorStage.BinaryPicture);
-                #endif
-                LightBarStage.Execute();
-                ArmorStage.Execute();
-                RecommendStage.Execute();
-                #ifdef DEBUG
-                if (RecommendStage.Found)
-                {
-                    // 输出坐标
-                    std::cout << "Found X:" << RecommendStage.X << " Y:" << RecommendStage.Y << " Distance:"
-                              << RecommendStage.Distance << "cm" << std::endl;
-                }
-                #endif
-                // 准备用于传输的字节包
-                std::vector<unsigned char> bytes;
-                bytes.resize(9);
-                SerialPort::Utilities::BytesAccessor accessor(bytes.data(), 9);
-                accessor.Access<unsigned char>(0) = 0xFF;
-                if (RecommendStage.Found)
-                {
-                    accessor.Access<unsigned char>(1) = 1;
-                } else
-                {
-                    accessor.Access<unsigned char>(1) = 0;
-                }
-                accessor.Access<unsigned short>(2) = static_cast<unsigned short>(RecommendStage.X);
-                accessor.Access<unsigned short>(4) = static_cast<unsigned short>(RecommendStage.Y);
-                accessor.Access<unsigned short>(6) = static_cast<unsigned short>(RecommendStage.Distance);
-                accessor.Access<unsigned char>(8) =
-                        SerialPort::Utilities::CRCTool::GetCRC8CheckSum(bytes.data(), 8);
-                #ifndef DEBUG
-                // 传输字节包
-                SerialConnection.Write(bytes);
-                #endif
-                FPSStage.Execute();
-            }
-        }
-        catch (cv::Exception& error)
-        {
-            std::cout << "Exception Occurs: " << error.what() << std::endl;
-        }
+		{
+			OnInstall();
+			EnemyColor = serial_ready.get();
+			camera_ready.get();
+		}
+		catch (...)
+		{
+			CancelLaunch(camera_ready, serial_ready);
+			throw;
+		}
+		// 敌方颜色在握手后才确定，令第一帧重新应用参数快照以选用对应的颜色阈值
+		AppliedParametersVersion = 0;
+
+		OnCameraOpened();
+		// 相机离线后由重连器在后台重新开启，处理线程与各阶段的状态保持不变
+		CameraWatchdog.SetRetryInterval(CameraRetryInitialInterval, CameraRetryMaxInterval);
+		CameraWatchdog.SetCallback([this](std::chrono::milliseconds reconnect_time){
+			Counters.OnCameraReconnected(reconnect_time.count());
+		});
+		CameraWatchdog.Start();
+
+		// 以第一张图片的到达作为相机就绪的标志，代替固定的等待时间
+		Cameras::Galaxy::RawPicture raw_picture;
+		unsigned long long picture_index = 0;
+		while (!Camera.WaitForNextPicture(raw_picture, picture_index, std::chrono::seconds(1)))
+		{
+			std::clog << "[Warning] Waiting for the First Picture from Camera." << std::endl;
+		}
+
+		std::clog << "[Message] Ready in " << std::chrono::duration_cast<std::chrono::milliseconds>(
+				std::chrono::steady_clock::now() - launch_time).count() << " Milliseconds." << std::endl;
+
+		#ifdef DEBUG
+		// 调试界面在独立线程中以自身节奏显示分接数据，不占用处理线程
+		Viewer.Start();
+		#endif
+
+		while (!RestartRequested)
+		{
+			#ifdef DEBUG
+			// 在调试界面中按下ESC键，则终止程序
+			if (Viewer.IsExitRequested())
+			{
+				break;
+			}
+			#endif
+
+			// 在帧的边界上应用新发布的参数快照，没有新快照时只有一次原子读取
+			Parameters.ConsumeUpdate(AppliedParametersVersion, [this](const VisionParameters& parameters){
+				ApplyParameters(parameters);
+			});
+
+			bool picture_received;
+			{
+				Core::LatencyScope capture_wait_scope(Statistics[Core::StageIdentifier::CaptureWait]);
+				Core::TraceScope capture_wait_trace("CaptureWait", Frames.GetNextIndex());
+				// 阻塞至新的图片到达，不会重复处理同一张图片
+				picture_received = Camera.WaitForNextPicture(raw_picture, picture_index, CaptureTimeout);
+			}
+			// 相机离线或重连期间等待超时，不取出帧，使下一帧的上一帧仍是最后处理过的帧
+			if (!picture_received)
+			{
+				Counters.OnCaptureTimeout();
+				continue;
+			}
+
+			// 从帧池中轮转取出预分配的帧，其缓冲区尺寸与全屏一致，各阶段均只在其上截取视图
+			auto& frame = Frames.Acquire();
+
+			/*
+			 * 每帧的处理单独捕获异常，任何阶段的故障只丢弃该帧，由故障监视器决定是否重置阶段或重启
+			 */
+			try
+			{
+				Core::LatencyScope end_to_end_scope(Statistics[Core::StageIdentifier::EndToEnd]);
+				Core::TraceScope end_to_end_trace("EndToEnd", frame.Index);
+
+				frame.RawPicture = cv::Mat(cv::Size(raw_picture.Width, raw_picture.Height), CV_8UC1, raw_picture.Data);
+				frame.SensorFrameID = raw_picture.FrameID;
+				frame.SensorTimeStamp = raw_picture.TimeStamp;
+				frame.ReceiveTime = raw_picture.ReceiveTime;
+				frame.ProcessBeginTime = std::chrono::steady_clock::now();
+				Latency.OnProcessBegin(frame);
+
+				Pipeline.Execute(frame);
+				Counters.OnFrameProcessed(frame);
+
+				// 无人订阅时，发布分接数据只有指针检查的开销
+				Taps.Publish(frame);
+				if (Bus.IsOpened())
+				{
+					PublishToBus(frame);
+				}
+
+				#ifdef DEBUG
+				if (frame.Target.Found)
+				{
+					// 输出坐标
+					std::cout << "Found X:" << frame.Target.X << " Y:" << frame.Target.Y << " Distance:"
+					          << frame.Target.Distance << "cm" << std::endl;
+				}
+				#endif
+				// 在帧持有的字节包上序列化结果，相机帧号的低16位用于下位机对齐结果与图像，
+				// 时间戳为外推后坐标所描述的时刻，下位机只补偿此后的剩余延迟，避免与预测器重复补偿
+				ResultPacket::Serialize(frame, ClockSync.ToMCUTime(frame.PredictedTime));
+				#ifndef DEBUG
+				// 提交字节包，由串口的输入输出线程异步发送，此处仅记录提交耗时
+				{
+					Core::LatencyScope serial_scope(Statistics[Core::StageIdentifier::Serial]);
+					Core::TraceScope serial_trace("Serial", frame.Index);
+					SerialConnection.WriteAsync(frame.Packet.data(), frame.Packet.size());
+				}
+				Latency.OnSerialWritten(frame);
+				Counters.OnSerialWritten();
+				#endif
+
+				Faults.RecordSuccess();
+			}
+			catch (...)
+			{
+				HandleFrameFault(frame, std::current_exception());
+			}
+		}
+		// 归还最后一张图片，重连线程中等待的Close才能回收其缓冲区，此后才能停止重连线程
+		Camera.ReleasePicture();
+		Viewer.Stop();
 		OnUninstall();
+
+		return RestartRequested ? RestartExitCode : 0;
 	}
 
 	/// 安装方法
 	void Controller::OnInstall()
 	{
 		OnLoadConfiguration();
-		/*
-		 * 允许当前线程及子线程覆盖全部的CPU核心
-		 * 对于JetPack4.4而言，两个Denver大核因为执行延迟问题被单独隔离，需要手动指定在其上工作的线程
-		 */
-		SetCurrentThreadCPUAffinity({0,1,2,3,4,5});
+		OnWarmUp();
+		OnBindStatistics();
 
-		while(!Camera.IsOpened())
+		if (!FrameBusName.empty())
 		{
-			try {
-				Camera.Open();
-			}catch(std::exception& error)
+			// 原始图像与蒙版均不超过全屏尺寸
+			const auto plane_capacity = static_cast<std::size_t>(RecommendStage.ScreenWidth) *
+					static_cast<std::size_t>(RecommendStage.ScreenHeight);
+			try
+			{
+				Bus.Open(FrameBusName, FrameBusSlotCount, plane_capacity, plane_capacity);
+				std::clog << "[Message] Publishing Frames to " << FrameBusName << "." << std::endl;
+			}
+			catch (std::exception& error)
+			{
+				std::clog << "[Warning] Failed to Open Frame Bus: " << error.what() << std::endl;
+			}
+		}
+
+		if (EnableHardwareCounters && !Core::HardwareCounterRegistry::GetInstance().Enable())
+		{
+			std::clog << "[Warning] Hardware Counters Unavailable, Check perf_event_paranoid." << std::endl;
+		}
+
+		if (!MetricsSocketPath.empty())
+		{
+			try
+			{
+				Metrics.Start(MetricsSocketPath);
+			}
+			catch (std::exception& error)
 			{
-				std::cout << "[Error] Failed to Open Camera: '" << error.what()
-				          << "', will Attempt in 10 Seconds." << std::endl;
-				std::this_thread::sleep_for(std::chrono::seconds(10));
+				std::clog << "[Warning] Failed to Start Metrics Server: " << error.what() << std::endl;
 			}
 		}
 
-		CuttingStage.InterestedArea = &RecommendStage.InterestedArea;
-		CuttingStage.Found = &RecommendStage.Found;
-		LightBarStage.BinaryPicture = &ColorStage.BinaryPicture;
-		ArmorStage.LightBars = &LightBarStage.LightBars;
-		RecommendStage.Armors = &ArmorStage.Armors;
-		RecommendStage.PositionOffset = &CuttingStage.PositionOffset;
-		FPSStage.Found = &RecommendStage.Found;
+		if (EnableHotReload)
+		{
+			try
+			{
+				SettingsReloader.Start();
+			}
+			catch (std::exception& error)
+			{
+				std::clog << "[Warning] Failed to Watch Settings: " << error.what() << std::endl;
+			}
+		}
+
+		if (!TracePath.empty())
+		{
+			Core::TraceRecorder::GetInstance().Start(TracePath, TraceDuration);
+			std::clog << "[Message] Tracing to " << TracePath << "." << std::endl;
+		}
+	}
+
+	/// 预热各阶段
+	void Controller::OnWarmUp()
+	{
+		// 按照全屏尺寸预分配帧与各阶段的缓冲区，首次分配显存时将初始化CUDA上下文
+		const cv::Size screen_size(RecommendStage.ScreenWidth, RecommendStage.ScreenHeight);
+		Frames.Reserve(screen_size);
+		ColorStage.Reserve(screen_size);
+		PredictStage.ScreenWidth = RecommendStage.ScreenWidth;
+		PredictStage.ScreenHeight = RecommendStage.ScreenHeight;
+
+		// 在全黑的图像上执行一次颜色过滤，使CUDA核函数的加载与滤波器的初始化在第一帧之前完成
+		Core::Frame warm_up_frame;
+		warm_up_frame.GpuPicture = cv::cuda::GpuMat(screen_size, CV_8UC3, cv::Scalar::all(0));
+		ColorStage.Execute(warm_up_frame);
+
+		// 启动TBB的工作线程，以免灯条检测与装甲板匹配在第一帧中等待线程创建
+		tbb::parallel_for(0, tbb::this_task_arena::max_concurrency(), [](int){});
+	}
+
+	/// 相机开启后的设置
+	void Controller::OnCameraOpened()
+	{
+		// 相机时间戳频率仅在相机开启后才能查询
+		auto tick_frequency = Camera.GetTimeStampTickFrequency();
+		Latency.SetTickFrequency(tick_frequency);
+		if (tick_frequency == 0)
+		{
+			std::clog << "[Warning] Camera Timestamp Frequency Unavailable, Capture Latency will not be Recorded."
+			          << std::endl;
+		}
+	}
+
+	/// 绑定统计直方图
+	void Controller::OnBindStatistics()
+	{
+		using Core::StageIdentifier;
+		using PipelineType = decltype(Pipeline);
+		static_assert(PipelineType::StageCount <= Core::FaultMonitor::MaxStageCount,
+				"Fault monitor can not record all stages of the pipeline.");
+
+		auto& statistics_hook = Pipeline.Hooks.Get<Core::StatisticsHook<>>();
+		auto& trace_hook = Pipeline.Hooks.Get<Core::TraceHook<>>();
+		auto& hardware_hook = Pipeline.Hooks.Get<Core::HardwareCounterHook<>>();
+
+		// 统计、追踪与硬件计数使用相同的阶段划分与名称
+		auto bind = [&](std::size_t stage_index, StageIdentifier stage){
+			statistics_hook.Bind(stage_index, &Statistics[stage]);
+			trace_hook.Bind(stage_index, Core::StageStatistics::GetName(stage));
+			hardware_hook.Bind(stage_index, &Hardware[stage]);
+			Faults.Bind(stage_index, Core::StageStatistics::GetName(stage));
+		};
+
+		bind(PipelineType::IndexOf<Core::BayerConverter>(), StageIdentifier::Debayer);
+		bind(PipelineType::IndexOf<CuttingChooser>(), StageIdentifier::Cut);
+		bind(PipelineType::IndexOf<Core::PictureUploader>(), StageIdentifier::Upload);
+		bind(PipelineType::IndexOf<Core::ColorFilter>(), StageIdentifier::Color);
+		bind(PipelineType::IndexOf<Core::LightBarDetector>(), StageIdentifier::Detect);
+		bind(PipelineType::IndexOf<Core::ArmorMatcher>(), StageIdentifier::Match);
+		bind(PipelineType::IndexOf<Core::ArmorSelector>(), StageIdentifier::Select);
+		bind(PipelineType::IndexOf<Core::TargetPredictor>(), StageIdentifier::Predict);
+		// 帧率计数器不参与延迟统计，仅为其故障命名
+		Faults.Bind(PipelineType::IndexOf<FPSCounter>(), "FPS");
+
+		FPSStage.Statistics = &Statistics;
+		FPSStage.Hardware = &Hardware;
 	}
 
 	/// 卸载方法
 	void Controller::OnUninstall()
 	{
+		Core::TraceRecorder::GetInstance().Stop();
+		Metrics.Stop();
+		Bus.Close();
+		SettingsReloader.Stop();
+
+		CameraWatchdog.Stop();
 		Camera.Close();
 
 		#ifndef DEBUG
+		ClockSync.Stop();
+		SerialConnection.StopAsyncWriter();
 		SerialConnection.Close();
 		#endif
 	}
 
 	/// 构造函数
-	Controller::Controller() : Camera(0), SerialConnection("/dev/ttyTHS2")
-	{}
+	Controller::Controller() : Camera(0), SerialConnection("/dev/ttyTHS2"), ClockSync(SerialConnection)
+	{
+		// 上传与颜色过滤在同一工作流上排队，颜色过滤结束时一并等待
+		Pipeline.Get<Core::PictureUploader>().Stream = &ColorStage.Stream;
+	}
 
 	/// 加载配置文件
 	void Controller::OnLoadConfiguration()
@@ -210,43 +498,114 @@ namespace RoboPioneers::Prometheus
 			boost::property_tree::ptree json_node;
 			boost::property_tree::read_json("Settings.json", json_node);
 
-			if (EnemyColor == ColorType::Red)
-			{
-				ColorStage.MinHue = json_node.get<int>("Mask.Red.Hue.Min");
-				ColorStage.MaxHue = json_node.get<int>("Mask.Red.Hue.Max");
-				ColorStage.MinSaturation = json_node.get<int>("Mask.Red.Saturation.Min");
-				ColorStage.MaxSaturation = json_node.get<int>("Mask.Red.Saturation.Max");
-				ColorStage.MinValue = json_node.get<int>("Mask.Red.Value.Min");
-				ColorStage.MaxValue = json_node.get<int>("Mask.Red.Value.Max");
-			}
-			else
-			{
-				ColorStage.MinHue = json_node.get<int>("Mask.Blue.Hue.Min");
-				ColorStage.MaxHue = json_node.get<int>("Mask.Blue.Hue.Max");
-				ColorStage.MinSaturation = json_node.get<int>("Mask.Blue.Saturation.Min");
-				ColorStage.MaxSaturation = json_node.get<int>("Mask.Blue.Saturation.Max");
-				ColorStage.MinValue = json_node.get<int>("Mask.Blue.Value.Min");
-				ColorStage.MaxValue = json_node.get<int>("Mask.Blue.Value.Max");
-			}
-
+			// 可在运行中修改的阈值以快照发布，与后续重新读取的快照经由同一路径应用到各阶段
+			Parameters.Publish(LoadVisionParameters(json_node));
+			Parameters.ConsumeUpdate(AppliedParametersVersion, [this](const VisionParameters& parameters){
+				ApplyParameters(parameters);
+			});
+
+			MetricsSocketPath = json_node.get<std::string>("Metrics.Socket", MetricsSocketPath);
+			EnableHardwareCounters = json_node.get<bool>("Performance.HardwareCounters", false);
+			EnableHotReload = json_node.get<bool>("Settings.HotReload", true);
+
+			// 帧总线为可选项，未配置时不开启
+			FrameBusName = json_node.get<std::string>("FrameBus.Name", "");
+			FrameBusSlotCount = json_node.get<unsigned int>("FrameBus.Slots", FrameBusSlotCount);
+
+			// 故障预算为可选项，未配置的项使用默认值
+			Core::FaultMonitor::Budget fault_budget;
+			fault_budget.WindowSize = json_node.get<std::size_t>("Faults.WindowSize", fault_budget.WindowSize);
+			fault_budget.MaxFailureRatio = json_node.get<double>("Faults.MaxFailureRatio",
+			                                                     fault_budget.MaxFailureRatio);
+			fault_budget.RecoveryFrames = json_node.get<std::uint64_t>("Faults.RecoveryFrames",
+			                                                           fault_budget.RecoveryFrames);
+			fault_budget.MaxConsecutiveResets = json_node.get<unsigned int>("Faults.MaxConsecutiveResets",
+			                                                                fault_budget.MaxConsecutiveResets);
+			Faults.SetBudget(fault_budget);
+
+			// 追踪为可选项，未配置时不开启
+			TracePath = json_node.get<std::string>("Trace.Path", "");
+			TraceDuration = std::chrono::milliseconds(
+					static_cast<long>(json_node.get<double>("Trace.Duration", 0.0) * 1000));
 
-			LightBarStage.MinArea = json_node.get<int>("LightBar.MinArea");
-			LightBarStage.MinFillingRatio = json_node.get<int>("LightBar.MinFillingRatio");
-
-			ArmorStage.MaxAngleDifference = json_node.get<int>("LightBar.MaxAngleDifference");
-			ArmorStage.MaxDeltaYHeightRatio = json_node.get<int>("LightBar.DeltaYHeightRatio.Max");
+			std::clog << "[Message] Using Settings in Settings.json." << std::endl;
+		}
+	}
 
-			ArmorStage.MinHeightDistanceRatioBigArmor = json_node.get<int>("BigArmor.HeightDistanceRatio.Min");
-			ArmorStage.MaxHeightDistanceRatioBigArmor = json_node.get<int>("BigArmor.HeightDistanceRatio.Max");
-			ArmorStage.MinWidthDistanceRatioBigArmor = json_node.get<int>("BigArmor.WidthDistanceRatio.Min");
-			ArmorStage.MaxWidthDistanceRatioBigArmor = json_node.get<int>("BigArmor.WidthDistanceRatio.Max");
+	/// 将目标信息转换为帧总线上的定长结构
+	static FrameBus::TargetResult ToTargetResult(const Core::TargetInformation& target)
+	{
+		return FrameBus::TargetResult {
+			target.Found ? 1u : 0u, target.X, target.Y, target.Distance,
+			target.InterestedArea.x, target.InterestedArea.y,
+			target.InterestedArea.width, target.InterestedArea.height};
+	}
 
-			ArmorStage.MinHeightDistanceRatioSmallArmor = json_node.get<int>("SmallArmor.HeightDistanceRatio.Min");
-			ArmorStage.MaxHeightDistanceRatioSmallArmor = json_node.get<int>("SmallArmor.HeightDistanceRatio.Max");
-			ArmorStage.MinWidthDistanceRatioSmallArmor = json_node.get<int>("SmallArmor.WidthDistanceRatio.Min");
-			ArmorStage.MaxWidthDistanceRatioSmallArmor = json_node.get<int>("SmallArmor.WidthDistanceRatio.Max");
+	/// 将处理完毕的帧发布到帧总线
+	void Controller::PublishToBus(const Core::Frame &frame)
+	{
+		// 稳定时钟即单调时钟，外部进程可以直接与CLOCK_MONOTONIC比较
+		auto to_nanoseconds = [](std::chrono::steady_clock::time_point time){
+			return static_cast<std::int64_t>(
+					std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+		};
+
+		FrameBus::FrameResult result {};
+		result.FrameIndex = frame.Index;
+		result.SensorFrameID = frame.SensorFrameID;
+		result.SensorTimeStamp = frame.SensorTimeStamp;
+		result.ReceiveTime = to_nanoseconds(frame.ReceiveTime);
+		result.ProcessBeginTime = to_nanoseconds(frame.ProcessBeginTime);
+		result.OffsetX = frame.PositionOffset.x;
+		result.OffsetY = frame.PositionOffset.y;
+		result.LightBarCount = static_cast<std::uint32_t>(frame.LightBars.size());
+		result.ArmorCount = static_cast<std::uint32_t>(frame.Armors.size());
+		result.Target = ToTargetResult(frame.Target);
+		result.PredictedTarget = ToTargetResult(frame.PredictedTarget);
+
+		// 原始图像为相机缓冲区上的视图，蒙版为蒙版缓冲区上的视图，均在发布时拷贝一次
+		FrameBus::PlaneView raw {frame.RawPicture.data,
+		                         static_cast<std::uint32_t>(frame.RawPicture.cols),
+		                         static_cast<std::uint32_t>(frame.RawPicture.rows),
+		                         frame.RawPicture.step[0]};
+		FrameBus::PlaneView mask {frame.BinaryPicture.data,
+		                          static_cast<std::uint32_t>(frame.BinaryPicture.cols),
+		                          static_cast<std::uint32_t>(frame.BinaryPicture.rows),
+		                          frame.BinaryPicture.step[0]};
+		Bus.Publish(result, raw, mask);
+	}
 
-			std::clog << "[Message] Using Settings in Settings.json." << std::endl;
-		}
+	/// 将视觉参数快照复制到各阶段
+	void Controller::ApplyParameters(const VisionParameters &parameters)
+	{
+		const auto& mask = EnemyColor == ColorType::Red ? parameters.RedMask : parameters.BlueMask;
+		ColorStage.MinHue = mask.MinHue;
+		ColorStage.MaxHue = mask.MaxHue;
+		ColorStage.MinSaturation = mask.MinSaturation;
+		ColorStage.MaxSaturation = mask.MaxSaturation;
+		ColorStage.MinValue = mask.MinValue;
+		ColorStage.MaxValue = mask.MaxValue;
+
+		LightBarStage.MinArea = parameters.MinArea;
+		LightBarStage.MinFillingRatio = parameters.MinFillingRatio;
+
+		ArmorStage.MaxAngleDifference = parameters.MaxAngleDifference;
+		ArmorStage.MaxDeltaYHeightRatio = parameters.MaxDeltaYHeightRatio;
+
+		ArmorStage.MinHeightDistanceRatioBigArmor = parameters.MinHeightDistanceRatioBigArmor;
+		ArmorStage.MaxHeightDistanceRatioBigArmor = parameters.MaxHeightDistanceRatioBigArmor;
+		ArmorStage.MinWidthDistanceRatioBigArmor = parameters.MinWidthDistanceRatioBigArmor;
+		ArmorStage.MaxWidthDistanceRatioBigArmor = parameters.MaxWidthDistanceRatioBigArmor;
+
+		ArmorStage.MinHeightDistanceRatioSmallArmor = parameters.MinHeightDistanceRatioSmallArmor;
+		ArmorStage.MaxHeightDistanceRatioSmallArmor = parameters.MaxHeightDistanceRatioSmallArmor;
+		ArmorStage.MinWidthDistanceRatioSmallArmor = parameters.MinWidthDistanceRatioSmallArmor;
+		ArmorStage.MaxWidthDistanceRatioSmallArmor = parameters.MaxWidthDistanceRatioSmallArmor;
+
+		PredictStage.Enabled = parameters.PredictionEnabled;
+		PredictStage.Alpha = parameters.PredictionAlpha;
+		PredictStage.Beta = parameters.PredictionBeta;
+		PredictStage.Gamma = parameters.PredictionGamma;
+		PredictStage.ActuationDelay = parameters.ActuationDelay;
 	}
 }
@@ -3,9 +3,25 @@
 #include <Core/PrometheusCore.hpp>
 #include <GalaxyCamera/GalaxyCamera.hpp>
 #include <SerialPort/SerialPort.hpp>
+#include <FrameBus/PrometheusFrameBus.hpp>
 
-#include "./Stages/CuttingChooser.hpp"
-#include "./Stages/FPSCounter.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <string>
+
+#include "./ProcessingPipelines.hpp"
+#include "./Debugging/DebugTaps.hpp"
+#include "./Debugging/DebugViewer.hpp"
+#include "./Monitoring/RuntimeCounters.hpp"
+#include "./Monitoring/MetricsServer.hpp"
+#include "./Protocol/ClockSynchronizer.hpp"
+#include "./Configuration/SnapshotPublisher.hpp"
+#include "./Configuration/VisionParameters.hpp"
+#include "./Configuration/SettingsWatcher.hpp"
 
 namespace RoboPioneers::Prometheus
 {
@@ -24,25 +40,101 @@ namespace RoboPioneers::Prometheus
 
 		/// 相机设备
 		Cameras::Galaxy::CameraDevice Camera;
+		/// 相机重连器，在相机离线或停止出图后于后台重新开启相机
+		Cameras::Galaxy::CameraReconnector CameraWatchdog {Camera};
 		/// 串口通信连接
 		SerialPort::Port SerialConnection;
+		/// 与下位机的时钟同步器
+		ClockSynchronizer ClockSync;
+
+		//==============================
+		// 帧
+		//==============================
+
+		/// 帧池，持有预分配的帧缓冲区并轮转复用
+		Core::FramePool<3> Frames;
 
 		//==============================
 		// 处理阶段
 		//==============================
 
-		/// 裁剪阶段
-		CuttingChooser CuttingStage;
+		/// 处理流水线，各阶段的耗时由统计钩子记录，起止时间由追踪钩子记录，硬件计数由硬件计数钩子记录
+		StandardPipeline<Core::HookGroup<Core::StatisticsHook<>, Core::TraceHook<>, Core::HardwareCounterHook<>>> Pipeline;
+
 		/// 颜色过滤阶段
-		Core::ColorFilter ColorStage;
+		Core::ColorFilter& ColorStage {Pipeline.Get<Core::ColorFilter>()};
 		/// 灯条检测阶段
-		Core::LightBarDetector LightBarStage;
+		Core::LightBarDetector& LightBarStage {Pipeline.Get<Core::LightBarDetector>()};
 		/// 装甲板匹配阶段
-		Core::ArmorMatcher ArmorStage;
+		Core::ArmorMatcher& ArmorStage {Pipeline.Get<Core::ArmorMatcher>()};
 		/// 推荐阶段
-		Core::ArmorSelector RecommendStage;
+		Core::ArmorSelector& RecommendStage {Pipeline.Get<Core::ArmorSelector>()};
+		/// 目标预测阶段
+		Core::TargetPredictor& PredictStage {Pipeline.Get<Core::TargetPredictor>()};
 		/// 帧率计数器
-		FPSCounter FPSStage;
+		FPSCounter& FPSStage {Pipeline.Get<FPSCounter>()};
+
+		//==============================
+		// 配置部分
+		//==============================
+
+		/// 视觉参数快照，由配置文件监视器发布，处理线程在每帧开始时读取
+		SnapshotPublisher<VisionParameters> Parameters;
+		/// 处理线程已应用的参数快照数量
+		std::uint64_t AppliedParametersVersion {0};
+		/// 配置文件监视器
+		SettingsWatcher SettingsReloader {Parameters};
+		/// 是否在配置文件修改后重新读取
+		bool EnableHotReload {true};
+
+		/// 将视觉参数快照复制到各阶段，只能由处理线程在帧的边界上调用
+		void ApplyParameters(const VisionParameters& parameters);
+
+		//==============================
+		// 统计部分
+		//==============================
+
+		/// 各阶段延迟统计
+		Core::StageStatistics Statistics;
+		/// 各阶段硬件计数统计
+		Core::HardwareStatistics Hardware;
+		/// 是否开启硬件计数
+		bool EnableHardwareCounters {false};
+		/// 采集至发送的延迟监视器
+		Core::LatencyMonitor Latency {Statistics};
+
+		/// 运行计数器
+		RuntimeCounters Counters;
+		/// 故障监视器，按阶段与类型统计处理失败的帧
+		Core::FaultMonitor Faults;
+		/// 指标服务
+		MetricsServer Metrics {Counters, FPSStage, Faults};
+		/// 指标服务的套接字路径，为空则不开启指标服务
+		std::string MetricsSocketPath {"/tmp/prometheus.sock"};
+
+		/// 追踪文件路径，为空则不开启追踪
+		std::string TracePath;
+		/// 追踪时长，为零则持续追踪至程序退出
+		std::chrono::milliseconds TraceDuration {0};
+
+		//==============================
+		// 调试部分
+		//==============================
+
+		/// 调试分接点
+		DebugTaps Taps;
+		/// 调试查看器，仅在DEBUG模式下启动
+		DebugViewer Viewer {Taps};
+
+		/// 帧总线，供录制、调参界面等外部进程读取原始图像、蒙版与处理结果
+		FrameBus::FrameBusPublisher Bus;
+		/// 帧总线的共享内存名称，为空则不开启帧总线
+		std::string FrameBusName;
+		/// 帧总线的槽数量
+		unsigned int FrameBusSlotCount {4};
+
+		/// 将处理完毕的帧发布到帧总线
+		void PublishToBus(const Core::Frame& frame);
 
 		//==============================
 		// 全局属性部分
@@ -59,7 +151,53 @@ namespace RoboPioneers::Prometheus
 		/// 敌对势力颜色
 		ColorType EnemyColor {ColorType::Red};
 
+		/// 相机开启失败后的初始重试间隔
+		std::chrono::milliseconds CameraRetryInitialInterval {50};
+		/// 相机开启失败后的最大重试间隔
+		std::chrono::milliseconds CameraRetryMaxInterval {1000};
+		/// 处理线程等待相机图片的超时时间
+		std::chrono::milliseconds CaptureTimeout {100};
+		/// 握手时等待串口数据的超时时间，超时后检查启动是否已被取消
+		std::chrono::milliseconds HandshakePollInterval {100};
+
+		/// 启动是否已被取消，取消后后台的相机开启与串口握手将尽快退出
+		std::atomic_bool LaunchCancelled {false};
+		/// 保护启动取消通知的互斥锁
+		std::mutex LaunchMutex;
+		/// 启动取消通知，用于唤醒等待重试的相机开启线程
+		std::condition_variable LaunchCondition;
+
+		/**
+		 * @brief 开启串口并与下位机握手
+		 * @return 敌方颜色
+		 * @details 在启动线程中执行，握手完成后启动异步写入与时钟同步。
+		 * @throw std::runtime_error 当启动在握手完成之前被取消
+		 */
+		ColorType ConnectSerial();
+
+		/// 开启相机，失败后按倍增的间隔重试，在启动线程中执行，启动被取消时直接返回
+		void OpenCamera();
+
+		/// 取消启动，并等待后台的相机开启与串口握手退出
+		void CancelLaunch(std::future<void>& camera_ready, std::future<ColorType>& serial_ready);
+
+		/// 是否因故障超出预算而要求重启
+		bool RestartRequested {false};
+
+		/**
+		 * @brief 处理帧的故障
+		 * @param frame 发生故障的帧，其目标信息将被清除
+		 * @param error 捕获的异常
+		 * @details
+		 *  ~ 故障被归属到抛出异常时正在执行的阶段，流水线之外的故障归属到FaultMonitor::OutsideStage。
+		 *  ~ 故障帧不发送结果；超出故障预算时按监视器的要求重置阶段或请求重启。
+		 */
+		void HandleFrameFault(Core::Frame& frame, const std::exception_ptr& error);
+
 	public:
+		/// 因故障超出预算而退出时的返回值，启动器将据此重新启动程序
+		static constexpr int RestartExitCode = 75;
+
 		/// 构造函数
 		Controller();
 
@@ -68,10 +206,21 @@ namespace RoboPioneers::Prometheus
 
 		/// 安装方法
 		void OnInstall();
+		/// 预分配缓冲区并预热各阶段
+		void OnWarmUp();
+		/// 相机开启后的设置
+		void OnCameraOpened();
+		/// 将流水线阶段与统计直方图及追踪事件名称绑定
+		void OnBindStatistics();
 		/// 卸载方法
 		void OnUninstall();
 
-		/// 执行
-		void Launch();
+		/**
+		 * @brief 执行
+		 * @details 安装或握手失败时，先取消并等待后台的相机开启与串口握手，再抛出异常。
+		 * @retval 0 当正常退出
+		 * @retval RestartExitCode 当故障超出预算而要求重启
+		 */
+		int Launch();
 	};
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "TapPoint.hpp"
+
+#include <Core/Frames/Frame.hpp>
+
+#include <tuple>
+#include <vector>
+
+namespace RoboPioneers::Prometheus
+{
+	/**
+	 * @brief 调试分接点集合
+	 * @author Vincent
+	 * @details
+	 *  ~ 该类汇集处理流水线上所有具名的分接点，并负责从帧上发布数据。
+	 */
+	class DebugTaps
+	{
+	public:
+		/// 原始Bayer图像
+		TapPoint<cv::Mat> Raw {"Raw"};
+		/// 裁剪后的图像
+		TapPoint<cv::Mat> Cut {"Cut"};
+		/// 颜色蒙版图像
+		TapPoint<cv::Mat> Binary {"Binary"};
+		/// 灯条列表，坐标相对于裁剪图像
+		TapPoint<std::vector<cv::RotatedRect>> LightBars {"LightBars"};
+		/// 装甲板列表，坐标相对于裁剪图像
+		TapPoint<std::vector<std::tuple<cv::RotatedRect, cv::RotatedRect>>> Armors {"Armors"};
+
+	public:
+		/**
+		 * @brief 从帧上发布所有被订阅的分接点的数据
+		 * @param frame 已经处理完毕的帧
+		 */
+		inline void Publish(const Core::Frame& frame)
+		{
+			Raw.Publish(frame.RawPicture, frame.Index);
+			Cut.Publish(frame.CuttingPicture, frame.Index);
+			Binary.Publish(frame.BinaryPicture, frame.Index);
+			LightBars.Publish(frame.LightBars, frame.Index);
+			Armors.Publish(frame.Armors, frame.Index);
+		}
+	};
+}
@@ -0,0 +1,104 @@
+#include "DebugViewer.hpp"
+
+namespace RoboPioneers::Prometheus
+{
+	/// 析构并停止界面线程
+	DebugViewer::~DebugViewer()
+	{
+		Stop();
+	}
+
+	/// 启动界面线程
+	void DebugViewer::Start()
+	{
+		if (Running) return;
+
+		Running = true;
+		Thread = std::thread(&DebugViewer::Run, this);
+	}
+
+	/// 停止界面线程
+	void DebugViewer::Stop()
+	{
+		Running = false;
+		if (Thread.joinable())
+		{
+			Thread.join();
+		}
+	}
+
+	/// 界面线程主循环
+	void DebugViewer::Run()
+	{
+		if (ShowRawPicture) Taps.Raw.Subscribe();
+		Taps.Cut.Subscribe();
+		Taps.Binary.Subscribe();
+		Taps.LightBars.Subscribe();
+		Taps.Armors.Subscribe();
+
+		cv::Mat raw_picture, bgr_picture, cutting_picture, binary_picture, canvas;
+		std::vector<cv::RotatedRect> light_bars;
+		std::vector<std::tuple<cv::RotatedRect, cv::RotatedRect>> armors;
+		unsigned long long raw_index {0}, cutting_index {0}, binary_index {0}, light_bars_index {0}, armors_index {0};
+
+		while (Running)
+		{
+			if (Taps.Raw.Fetch(raw_picture, raw_index))
+			{
+				cv::cvtColor(raw_picture, bgr_picture, cv::COLOR_BayerBG2BGR);
+				cv::imshow("Raw", bgr_picture);
+			}
+
+			if (Taps.Binary.Fetch(binary_picture, binary_index))
+			{
+				cv::imshow("Binary", binary_picture);
+			}
+
+			Taps.LightBars.Fetch(light_bars, light_bars_index);
+			Taps.Armors.Fetch(armors, armors_index);
+
+			if (Taps.Cut.Fetch(cutting_picture, cutting_index))
+			{
+				cutting_picture.copyTo(canvas);
+
+				// 仅当灯条与装甲板来自同一帧时才绘制，避免叠加错位的结果
+				if (light_bars_index == cutting_index)
+				{
+					for (const auto& light_bar : light_bars)
+					{
+						cv::Point2f vertices[4];
+						light_bar.points(vertices);
+						for (int index = 0; index < 4; ++index)
+						{
+							cv::line(canvas, vertices[index], vertices[(index + 1) % 4], cv::Scalar(0, 255, 0), 2);
+						}
+					}
+				}
+				if (armors_index == cutting_index)
+				{
+					for (const auto& armor : armors)
+					{
+						cv::line(canvas, std::get<0>(armor).center, std::get<1>(armor).center,
+						   cv::Scalar(0, 0, 255), 2);
+					}
+				}
+
+				cv::imshow("Cutting Result", canvas);
+			}
+
+			// 等待按下ASCII为27的键（ESC键），按下则请求终止程序
+			if (cv::waitKey(RefreshInterval) == 27)
+			{
+				ExitRequested = true;
+			}
+		}
+
+		Taps.Raw.Unsubscribe();
+		Taps.Cut.Unsubscribe();
+		Taps.Binary.Unsubscribe();
+		Taps.LightBars.Unsubscribe();
+		Taps.Armors.Unsubscribe();
+
+		cv::destroyAllWindows();
+	}
+}
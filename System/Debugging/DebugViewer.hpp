@@ -0,0 +1,67 @@
+#pragma once
+
+#include "DebugTaps.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace RoboPioneers::Prometheus
+{
+	/**
+	 * @brief 调试查看器
+	 * @author Vincent
+	 * @details
+	 *  ~ 查看器在独立的界面线程中订阅分接点，并按照自身的节奏显示最新的分接数据，
+	 *    处理线程不再调用任何图形界面方法。
+	 *  ~ 在界面中按下ESC键后，查看器将标记退出请求，由处理线程自行决定何时退出。
+	 */
+	class DebugViewer
+	{
+	protected:
+		/// 分接点集合
+		DebugTaps& Taps;
+
+		/// 界面线程
+		std::thread Thread;
+		/// 界面线程是否应当继续运行
+		std::atomic_bool Running {false};
+		/// 是否请求退出
+		std::atomic_bool ExitRequested {false};
+
+		/// 界面线程主循环
+		void Run();
+
+	public:
+		/// 是否显示原始图像，原始图像为全屏尺寸，拷贝开销较大，默认不显示
+		bool ShowRawPicture {false};
+		/// 界面刷新间隔，单位为毫秒
+		int RefreshInterval {30};
+
+	public:
+		/**
+		 * @brief 构造并绑定分接点集合
+		 * @param taps 分接点集合
+		 */
+		explicit DebugViewer(DebugTaps& taps) : Taps(taps)
+		{}
+
+		/// 析构，若界面线程仍在运行则将停止
+		~DebugViewer();
+
+		/// 启动界面线程
+		void Start();
+
+		/// 停止界面线程
+		void Stop();
+
+		/**
+		 * @brief 是否请求退出
+		 * @retval true 当用户在界面中按下了ESC键
+		 * @retval false 当未请求退出
+		 */
+		[[nodiscard]] inline bool IsExitRequested() const noexcept
+		{
+			return ExitRequested.load(std::memory_order_relaxed);
+		}
+	};
+}
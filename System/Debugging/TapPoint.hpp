@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <opencv4/opencv2/opencv.hpp>
+
+namespace RoboPioneers::Prometheus
+{
+	/**
+	 * @brief 将分接数据拷贝到邮箱中
+	 * @details
+	 *  ~ 图像需要深拷贝，因为帧上的缓冲区会被后续的帧复用。
+	 */
+	inline void CopyTapData(const cv::Mat& source, cv::Mat& target)
+	{
+		source.copyTo(target);
+	}
+
+	/// 将容器形式的分接数据拷贝到邮箱中
+	template<typename SourceContainer, typename TargetContainer>
+	inline void CopyTapData(const SourceContainer& source, TargetContainer& target)
+	{
+		target.assign(source.begin(), source.end());
+	}
+
+	/**
+	 * @brief 分接点
+	 * @tparam DataType 分接数据类型
+	 * @author Vincent
+	 * @details
+	 *  ~ 分接点用于将处理线程中的中间结果交给调试界面等观察者。
+	 *  ~ 只有当观察者订阅后，发布的数据才会被拷贝到单槽邮箱中，新数据将覆盖未被取走的旧数据；
+	 *    无人订阅时，发布操作只有一次指针检查的开销。
+	 *  ~ 发布操作不会阻塞处理线程：若观察者正在读取邮箱，则本次数据将被直接丢弃。
+	 */
+	template<typename DataType>
+	class TapPoint
+	{
+	protected:
+		/// 单槽邮箱
+		struct Mailbox
+		{
+			/// 邮箱互斥量
+			std::mutex Mutex;
+			/// 数据
+			DataType Data;
+			/// 数据所属的帧序号
+			unsigned long long FrameIndex {0};
+			/// 是否有尚未被取走的数据
+			bool Updated {false};
+		};
+
+		/// 邮箱存储，订阅后创建，此后一直存活至分接点析构
+		std::unique_ptr<Mailbox> MailboxStorage;
+		/// 当前订阅的邮箱，为空表示无人订阅
+		std::atomic<Mailbox*> Subscriber {nullptr};
+
+	public:
+		/// 分接点名称
+		const char* const Name;
+
+		/**
+		 * @brief 构造并指定名称
+		 * @param name 分接点名称
+		 */
+		explicit TapPoint(const char* name) : Name(name)
+		{}
+
+		//==============================
+		// 处理线程部分
+		//==============================
+
+		/**
+		 * @brief 是否有观察者订阅
+		 * @retval true 当有观察者订阅
+		 * @retval false 当无人订阅
+		 */
+		[[nodiscard]] inline bool IsWatched() const noexcept
+		{
+			return Subscriber.load(std::memory_order_relaxed) != nullptr;
+		}
+
+		/**
+		 * @brief 发布数据
+		 * @param data 数据
+		 * @param frame_index 数据所属的帧序号
+		 */
+		template<typename SourceType>
+		inline void Publish(const SourceType& data, unsigned long long frame_index)
+		{
+			auto* mailbox = Subscriber.load(std::memory_order_acquire);
+			if (!mailbox) return;
+
+			std::unique_lock lock(mailbox->Mutex, std::try_to_lock);
+			if (!lock.owns_lock()) return;
+
+			CopyTapData(data, mailbox->Data);
+			mailbox->FrameIndex = frame_index;
+			mailbox->Updated = true;
+		}
+
+		//==============================
+		// 观察者部分
+		//==============================
+
+		/**
+		 * @brief 订阅
+		 * @details
+		 *  ~ 该方法与Unsubscribe应当只由同一个观察者线程调用。
+		 */
+		void Subscribe()
+		{
+			if (!MailboxStorage)
+			{
+				MailboxStorage = std::make_unique<Mailbox>();
+			}
+			Subscriber.store(MailboxStorage.get(), std::memory_order_release);
+		}
+
+		/// 取消订阅，邮箱不会被释放，故处理线程中正在进行的发布操作依然安全
+		void Unsubscribe()
+		{
+			Subscriber.store(nullptr, std::memory_order_release);
+		}
+
+		/**
+		 * @brief 取出最新的数据
+		 * @param data 用于接收数据的对象，将与邮箱中的数据交换
+		 * @param frame_index 用于接收数据所属的帧序号
+		 * @retval true 当取到了新数据
+		 * @retval false 当没有新数据或尚未订阅
+		 */
+		bool Fetch(DataType& data, unsigned long long& frame_index)
+		{
+			if (!MailboxStorage) return false;
+
+			std::unique_lock lock(MailboxStorage->Mutex);
+			if (!MailboxStorage->Updated) return false;
+
+			std::swap(data, MailboxStorage->Data);
+			frame_index = MailboxStorage->FrameIndex;
+			MailboxStorage->Updated = false;
+			return true;
+		}
+	};
+}
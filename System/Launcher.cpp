@@ -1,12 +1,26 @@
 #include "Controller.hpp"
 #include <cstdlib>
+#include <iostream>
+#include <unistd.h>
 
 int main(int argc, char** argv)
 {
 	using namespace RoboPioneers::Prometheus;
 
-	Controller controller;
-	controller.Launch();
+	int exit_code;
+	{
+		// 控制器析构后相机与串口才被释放，须在重新启动之前完成
+		Controller controller;
+		exit_code = controller.Launch();
+	}
 
-	return 0;
-}
\ No newline at end of file
+	if (exit_code == Controller::RestartExitCode)
+	{
+		std::clog << "[Warning] Restarting due to Exceeded Fault Budget." << std::endl;
+		execv("/proc/self/exe", argv);
+		std::clog << "[Warning] Failed to Restart." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return exit_code;
+}
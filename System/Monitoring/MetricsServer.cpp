@@ -0,0 +1,181 @@
+#include "MetricsServer.hpp"
+
+#include <cerrno>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace RoboPioneers::Prometheus
+{
+	namespace
+	{
+		/**
+		 * @brief 删除遗留的套接字文件
+		 * @param path 套接字路径
+		 * @retval true 路径不存在或已删除
+		 * @retval false 路径存在但不是套接字，未删除
+		 * @details
+		 *  ~ 路径来自配置文件，只删除套接字，以免配置错误时删除其他文件。
+		 */
+		bool RemoveStaleSocket(const std::string& path)
+		{
+			struct stat status {};
+			if (::lstat(path.c_str(), &status) != 0) return errno == ENOENT;
+			if (!S_ISSOCK(status.st_mode)) return false;
+			return ::unlink(path.c_str()) == 0 || errno == ENOENT;
+		}
+	}
+
+	/// 构造并绑定数据源
+	MetricsServer::MetricsServer(const RuntimeCounters &counters, FPSCounter &report_source,
+	                             const Core::FaultMonitor &faults) :
+		Counters(counters), ReportSource(report_source), Faults(faults)
+	{}
+
+	/// 析构并停止服务
+	MetricsServer::~MetricsServer()
+	{
+		Stop();
+	}
+
+	/// 启动服务
+	void MetricsServer::Start(const std::string &socket_path)
+	{
+		if (ServiceThread.joinable()) return;
+
+		StartTime = std::chrono::steady_clock::now();
+
+		// 上一次运行遗留的套接字文件会导致绑定失败
+		if (!RemoveStaleSocket(socket_path))
+		{
+			throw std::runtime_error("[MetricsServer::Start] " + socket_path + " Exists and is not a Socket.");
+		}
+		SocketPath = socket_path;
+
+		boost::asio::local::stream_protocol::endpoint endpoint(SocketPath);
+		Acceptor.open(endpoint.protocol());
+		Acceptor.bind(endpoint);
+		Acceptor.listen();
+
+		AcceptNext();
+
+		Context.restart();
+		ServiceThread = std::thread([this]{
+			Context.run();
+		});
+	}
+
+	/// 停止服务
+	void MetricsServer::Stop()
+	{
+		if (!ServiceThread.joinable()) return;
+
+		Context.stop();
+		ServiceThread.join();
+
+		boost::system::error_code error;
+		Acceptor.close(error);
+		RemoveStaleSocket(SocketPath);
+	}
+
+	/// 接收下一个连接
+	void MetricsServer::AcceptNext()
+	{
+		Acceptor.async_accept([this](const boost::system::error_code& error,
+							   boost::asio::local::stream_protocol::socket socket){
+			if (error) return;
+
+			auto snapshot = MakeSnapshot();
+			boost::system::error_code write_error;
+			boost::asio::write(socket, boost::asio::buffer(snapshot), write_error);
+
+			AcceptNext();
+		});
+	}
+
+	/// 生成指标快照
+	std::string MetricsServer::MakeSnapshot()
+	{
+		ReportSource.PublishedReport.Update();
+		const auto& report = ReportSource.PublishedReport.GetReadBuffer();
+
+		auto uptime = std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+
+		std::ostringstream json;
+		json << std::fixed << std::setprecision(3)
+			<< "{\"uptime\":" << uptime
+			<< ",\"fps\":" << report.FPS
+			<< ",\"lock_ratio\":" << report.FoundRatio / 100.0
+			<< ",\"frames\":{\"processed\":" << Counters.ProcessedFrames.load(std::memory_order_relaxed)
+			<< ",\"found\":" << Counters.FoundFrames.load(std::memory_order_relaxed)
+			<< ",\"dropped\":" << Counters.DroppedFrames.load(std::memory_order_relaxed) << "}"
+			<< ",\"light_bars\":" << Counters.LightBars.load(std::memory_order_relaxed)
+			<< ",\"armors\":" << Counters.Armors.load(std::memory_order_relaxed)
+			<< ",\"serial_writes\":" << Counters.SerialWrites.load(std::memory_order_relaxed)
+			<< ",\"camera\":{\"timeouts\":" << Counters.CaptureTimeouts.load(std::memory_order_relaxed)
+			<< ",\"reconnects\":" << Counters.CameraReconnects.load(std::memory_order_relaxed)
+			<< ",\"last_reconnect_ms\":" << Counters.LastCameraReconnectTime.load(std::memory_order_relaxed)
+			<< ",\"max_reconnect_ms\":" << Counters.MaxCameraReconnectTime.load(std::memory_order_relaxed) << "}"
+			<< ",\"faults\":{\"frames\":" << Faults.GetFrameCount()
+			<< ",\"failed\":" << Faults.GetFailedFrameCount()
+			<< ",\"stages\":{";
+
+		// 仅列出发生过故障的阶段
+		bool first_fault_stage = true;
+		for (std::size_t index = 0; index <= Core::FaultMonitor::OutsideStage; ++index)
+		{
+			const auto* name = Faults.GetStageName(index);
+			if (!name) continue;
+
+			std::uint64_t total = 0;
+			for (std::size_t type = 0; type < Core::FaultMonitor::TypeCount; ++type)
+			{
+				total += Faults.GetCount(index, static_cast<Core::FaultType>(type));
+			}
+			if (total == 0) continue;
+
+			json << (first_fault_stage ? "" : ",") << "\"" << name << "\":{";
+			for (std::size_t type = 0; type < Core::FaultMonitor::TypeCount; ++type)
+			{
+				json << "\"" << Core::FaultMonitor::GetTypeName(static_cast<Core::FaultType>(type)) << "\":"
+					<< Faults.GetCount(index, static_cast<Core::FaultType>(type)) << ",";
+			}
+			json << "\"resets\":" << Faults.GetResetCount(index) << "}";
+			first_fault_stage = false;
+		}
+		json << "}}"
+			<< ",\"stages_us\":{";
+
+		// 阶段延迟以微秒为单位，为最近一个报告周期内的统计
+		bool first_stage = true;
+		for (std::size_t index = 0; index < Core::StageStatistics::StageCount; ++index)
+		{
+			const auto& stage = report.Stages[index];
+			if (stage.Count == 0) continue;
+
+			json << (first_stage ? "" : ",")
+				<< "\"" << Core::StageStatistics::GetName(static_cast<Core::StageIdentifier>(index)) << "\":{"
+				<< "\"count\":" << stage.Count
+				<< ",\"mean\":" << stage.Mean / 1000.0
+				<< ",\"p50\":" << stage.P50 / 1000.0
+				<< ",\"p90\":" << stage.P90 / 1000.0
+				<< ",\"p99\":" << stage.P99 / 1000.0
+				<< ",\"max\":" << stage.Max / 1000.0;
+
+			const auto& hardware = report.Hardware[index];
+			if (hardware.Samples != 0)
+			{
+				json << ",\"ipc\":" << hardware.GetIPC()
+					<< ",\"cache_misses\":" << hardware.GetAverage(Core::HardwareEvent::CacheMisses)
+					<< ",\"branch_misses\":" << hardware.GetAverage(Core::HardwareEvent::BranchMisses);
+			}
+			json << "}";
+			first_stage = false;
+		}
+		json << "}}\n";
+
+		return json.str();
+	}
+}
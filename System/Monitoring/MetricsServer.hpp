@@ -0,0 +1,73 @@
+#pragma once
+
+#include "RuntimeCounters.hpp"
+#include "../Stages/FPSCounter.hpp"
+
+#include <Core/Diagnostics/FaultMonitor.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <boost/asio.hpp>
+
+namespace RoboPioneers::Prometheus
+{
+	/**
+	 * @brief 指标服务
+	 * @author Vincent
+	 * @details
+	 *  ~ 服务在后台线程中监听本地UNIX域套接字，每个连接将收到一份JSON格式的指标快照，随后连接被关闭，
+	 *    例如：socat - UNIX-CONNECT:/tmp/prometheus.sock
+	 *  ~ 快照由运行计数器、故障计数与帧率计数器最近发布的报告组成，读取均不加锁，不会阻塞处理线程。
+	 */
+	class MetricsServer
+	{
+	protected:
+		/// 运行计数器
+		const RuntimeCounters& Counters;
+		/// 帧率计数器，仅读取其发布的报告
+		FPSCounter& ReportSource;
+		/// 故障监视器，仅读取其计数
+		const Core::FaultMonitor& Faults;
+
+		/// 套接字路径
+		std::string SocketPath;
+		/// 服务启动时间
+		std::chrono::steady_clock::time_point StartTime;
+
+		/// 异步IO上下文
+		boost::asio::io_context Context;
+		/// 连接接收器
+		boost::asio::local::stream_protocol::acceptor Acceptor {Context};
+		/// 服务线程
+		std::thread ServiceThread;
+
+		/// 接收下一个连接
+		void AcceptNext();
+
+		/// 生成指标快照，只能由服务线程调用
+		std::string MakeSnapshot();
+
+	public:
+		/**
+		 * @brief 构造并绑定数据源
+		 * @param counters 运行计数器
+		 * @param report_source 帧率计数器
+		 * @param faults 故障监视器
+		 */
+		MetricsServer(const RuntimeCounters& counters, FPSCounter& report_source, const Core::FaultMonitor& faults);
+
+		/// 析构，若服务正在运行则将停止
+		~MetricsServer();
+
+		/**
+		 * @brief 启动服务
+		 * @param socket_path 套接字路径，遗留的同名套接字将被删除
+		 * @throw std::runtime_error 当路径已存在且不是套接字，此时不会删除该文件
+		 */
+		void Start(const std::string& socket_path);
+
+		/// 停止服务并删除套接字文件
+		void Stop();
+	};
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <Core/Frames/Frame.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace RoboPioneers::Prometheus
+{
+	/**
+	 * @brief 运行计数器
+	 * @author Vincent
+	 * @details
+	 *  ~ 由处理线程更新，由监控线程读取；计数器均为宽松原子变量，更新不加锁。
+	 */
+	struct RuntimeCounters
+	{
+		/// 已处理的帧数
+		std::atomic<std::uint64_t> ProcessedFrames {0};
+		/// 找到目标的帧数
+		std::atomic<std::uint64_t> FoundFrames {0};
+		/// 根据相机帧号的间断推算出的丢帧数
+		std::atomic<std::uint64_t> DroppedFrames {0};
+		/// 最近一帧的灯条数量
+		std::atomic<std::uint64_t> LightBars {0};
+		/// 最近一帧的装甲板数量
+		std::atomic<std::uint64_t> Armors {0};
+		/// 串口写入次数
+		std::atomic<std::uint64_t> SerialWrites {0};
+		/// 等待相机图片超时的次数
+		std::atomic<std::uint64_t> CaptureTimeouts {0};
+		/// 相机重连次数
+		std::atomic<std::uint64_t> CameraReconnects {0};
+		/// 最近一次相机重连的耗时，单位为毫秒
+		std::atomic<std::int64_t> LastCameraReconnectTime {0};
+		/// 最长的相机重连耗时，单位为毫秒
+		std::atomic<std::int64_t> MaxCameraReconnectTime {0};
+
+		/// 上一帧的相机帧号，仅由处理线程访问
+		unsigned long long LastSensorFrameID {0};
+
+		/// 记录一帧的处理结果，只能由处理线程调用
+		inline void OnFrameProcessed(const Core::Frame& frame) noexcept
+		{
+			ProcessedFrames.fetch_add(1, std::memory_order_relaxed);
+			if (frame.Target.Found)
+			{
+				FoundFrames.fetch_add(1, std::memory_order_relaxed);
+			}
+			LightBars.store(frame.LightBars.size(), std::memory_order_relaxed);
+			Armors.store(frame.Armors.size(), std::memory_order_relaxed);
+
+			// 相机帧号不连续说明处理线程没有取到中间的帧
+			if (LastSensorFrameID != 0 && frame.SensorFrameID > LastSensorFrameID + 1)
+			{
+				DroppedFrames.fetch_add(frame.SensorFrameID - LastSensorFrameID - 1, std::memory_order_relaxed);
+			}
+			LastSensorFrameID = frame.SensorFrameID;
+		}
+
+		/// 记录一次串口写入
+		inline void OnSerialWritten() noexcept
+		{
+			SerialWrites.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		/// 记录一次等待相机图片超时
+		inline void OnCaptureTimeout() noexcept
+		{
+			CaptureTimeouts.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		/// 记录一次相机重连，由相机重连器的线程调用
+		inline void OnCameraReconnected(std::int64_t reconnect_time) noexcept
+		{
+			CameraReconnects.fetch_add(1, std::memory_order_relaxed);
+			LastCameraReconnectTime.store(reconnect_time, std::memory_order_relaxed);
+			if (reconnect_time > MaxCameraReconnectTime.load(std::memory_order_relaxed))
+			{
+				MaxCameraReconnectTime.store(reconnect_time, std::memory_order_relaxed);
+			}
+		}
+	};
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <Core/PrometheusCore.hpp>
+
+#include "./CPUPipeline.hpp"
+#include "./Stages/FPSCounter.hpp"
+
+namespace RoboPioneers::Prometheus
+{
+	/**
+	 * @brief 标准处理流水线
+	 * @tparam Hook 阶段钩子类型
+	 * @details
+	 *  ~ 使用CUDA进行颜色过滤，为实机运行时所使用的流水线。
+	 *  ~ 选择之后的目标预测器默认关闭，开启后将目标外推至预期执行时刻。
+	 */
+	template<typename Hook = Core::NullHook>
+	using StandardPipeline = Core::Pipeline<CameraSourceSlots, Hook,
+		Core::BayerConverter,
+		CuttingChooser,
+		Core::PictureUploader,
+		Core::ColorFilter,
+		Core::LightBarDetector,
+		Core::ArmorMatcher,
+		Core::ArmorSelector,
+		Core::TargetPredictor,
+		FPSCounter>;
+}
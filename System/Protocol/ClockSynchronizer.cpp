@@ -0,0 +1,162 @@
+#include "ClockSynchronizer.hpp"
+#include "TimeSyncPacketSchema.hpp"
+
+#include <algorithm>
+
+namespace RoboPioneers::Prometheus
+{
+	/// 获取主机单调时钟时间，单位为纳秒
+	static std::int64_t GetHostTime(std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now())
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+	}
+
+	/// 构造并绑定串口
+	ClockSynchronizer::ClockSynchronizer(SerialPort::Port &device) : Device(device),
+		Receiver(nullptr, {0xFD, PongPacketSchema::Size, SerialPort::FrameCheckSum::CRC8})
+	{
+		Receiver.SetCallback([this](const unsigned char* data, std::size_t size){
+			HandlePong(data, size);
+		});
+	}
+
+	/// 析构
+	ClockSynchronizer::~ClockSynchronizer()
+	{
+		Stop();
+	}
+
+	/// 设置请求间隔
+	void ClockSynchronizer::SetInterval(std::chrono::milliseconds interval)
+	{
+		Interval = interval;
+	}
+
+	/// 启动后台同步
+	void ClockSynchronizer::Start(bool read_port)
+	{
+		if (Worker.joinable()) return;
+		ExtraPongTransmissionTime = static_cast<std::int64_t>(PongPacketSchema::Size - PingPacketSchema::Size) *
+			Device.GetCharacterTime().count();
+		if (read_port)
+		{
+			// 应答由串口的输入输出线程读取，与异步写入共用同一个上下文，不会有两个线程同时操作串口
+			Device.StartAsyncReader([this](const unsigned char* data, std::size_t size){
+				Receiver.Feed(data, size);
+			});
+		}
+		ReadingPort = read_port;
+		Running = true;
+		Worker = std::thread([this]{ Run(); });
+	}
+
+	/// 停止后台同步
+	void ClockSynchronizer::Stop()
+	{
+		Running = false;
+		if (Worker.joinable())
+		{
+			Worker.join();
+		}
+		if (ReadingPort)
+		{
+			Device.StopAsyncReader();
+			ReadingPort = false;
+		}
+	}
+
+	/// 提供从串口读取的数据
+	void ClockSynchronizer::Feed(const unsigned char *data, std::size_t size)
+	{
+		Receiver.Feed(data, size);
+	}
+
+	/// 发送一次请求
+	void ClockSynchronizer::SendPing()
+	{
+		auto sequence = NextSequence++;
+		auto slot = sequence % PendingCapacity;
+
+		PingPacketSchema::Buffer packet;
+		PingPacketSchema::Serialize(packet, sequence);
+
+		// 先写序号再写时间，接收线程以时间非零作为槽位有效的标志
+		PendingSendTimes[slot].store(0, std::memory_order_relaxed);
+		PendingSequences[slot].store(sequence, std::memory_order_relaxed);
+		PendingSendTimes[slot].store(GetHostTime(), std::memory_order_release);
+		Device.WriteAsyncQueued(packet.data(), packet.size());
+	}
+
+	/// 处理一个应答
+	void ClockSynchronizer::HandlePong(const unsigned char *data, std::size_t size)
+	{
+		auto receive_time = GetHostTime();
+
+		PongPacketSchema::Buffer packet;
+		std::copy(data, data + size, packet.begin());
+		auto sequence = PongPacketSchema::Get<1>(packet);
+		auto mcu_time = PongPacketSchema::Get<2>(packet);
+
+		auto slot = sequence % PendingCapacity;
+		auto send_time = PendingSendTimes[slot].load(std::memory_order_acquire);
+		if (send_time == 0 || PendingSequences[slot].load(std::memory_order_relaxed) != sequence) return;
+		// 序号匹配后才清除槽位，过时的应答不会清除占用同一槽位的新请求
+		if (!PendingSendTimes[slot].compare_exchange_strong(send_time, 0, std::memory_order_acq_rel)) return;
+
+		// 展开32位下位机时间的回绕，两次应答的间隔远小于回绕周期
+		if (SampleCount == 0)
+		{
+			LastMCUTime = mcu_time;
+		}
+		else
+		{
+			LastMCUTime += static_cast<std::uint32_t>(mcu_time - static_cast<std::uint32_t>(LastMCUTime));
+		}
+
+		Sample sample;
+		sample.RoundTripTime = receive_time - send_time;
+		// 下位机时间采样于请求到达时，此后应答的传输比请求多出若干字节，扣除后两个方向的传输时间才相等
+		sample.Offset = LastMCUTime * 1000 - (send_time + receive_time - ExtraPongTransmissionTime) / 2;
+		Samples[SampleCount % WindowSize] = sample;
+		++SampleCount;
+
+		auto end = Samples.begin() + static_cast<long>(std::min(SampleCount, WindowSize));
+		auto best = std::min_element(Samples.begin(), end, [](const Sample& left, const Sample& right){
+			return left.RoundTripTime < right.RoundTripTime;
+		});
+		Offset.store(best->Offset, std::memory_order_relaxed);
+		RoundTripTime.store(best->RoundTripTime, std::memory_order_relaxed);
+		Synchronized.store(true, std::memory_order_release);
+	}
+
+	/// 工作线程主循环
+	void ClockSynchronizer::Run()
+	{
+		auto next_ping_time = std::chrono::steady_clock::now();
+
+		while (Running)
+		{
+			auto now = std::chrono::steady_clock::now();
+			if (now >= next_ping_time)
+			{
+				SendPing();
+				next_ping_time = now + Interval;
+			}
+
+			// 等待设有上限，以便及时检查退出条件
+			std::this_thread::sleep_for(std::min(
+					std::chrono::duration_cast<std::chrono::milliseconds>(next_ping_time - now),
+					std::chrono::milliseconds(50)));
+		}
+	}
+
+	/// 将主机时间转换为下位机时间
+	std::uint32_t ClockSynchronizer::ToMCUTime(std::chrono::steady_clock::time_point time) const noexcept
+	{
+		if (!IsSynchronized()) return 0;
+
+		auto mcu_time = static_cast<std::uint32_t>((GetHostTime(time) + Offset.load(std::memory_order_relaxed)) / 1000);
+		// 0保留为无效值
+		return mcu_time == 0 ? 1 : mcu_time;
+	}
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <SerialPort/SerialPort.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace RoboPioneers::Prometheus
+{
+	/**
+	 * @brief 时钟同步器
+	 * @author Vincent
+	 * @details
+	 *  ~ 在后台定期向下位机发送时间同步请求，根据应答中的下位机时间与往返时间估计主机时钟到下位机时钟的偏移。
+	 *  ~ 应答比请求长，其多出的字节的传输时间按串口的设定计算并从往返时间中扣除；
+	 *    此外每个样本假设请求与应答的传输时间相等，误差不超过往返时间的一半，
+	 *    因此在最近的若干样本中选取往返时间最短的一个作为估计，排除被排队或调度延迟的样本。
+	 *  ~ 请求通过串口的不可合并写入通道发送，需要串口已启动异步写入。
+	 *  ~ 偏移估计以原子变量发布，任意线程均可读取。
+	 */
+	class ClockSynchronizer
+	{
+	public:
+		/// 参与估计的样本数
+		static constexpr std::size_t WindowSize = 16;
+		/// 同时等待应答的请求数上限
+		static constexpr std::size_t PendingCapacity = 16;
+
+	protected:
+		/// 单个同步样本
+		struct Sample
+		{
+			/// 往返时间，单位为纳秒
+			std::int64_t RoundTripTime {0};
+			/// 下位机时间减去主机时间，单位为纳秒
+			std::int64_t Offset {0};
+		};
+
+		/// 串口
+		SerialPort::Port& Device;
+		/// 应答接收器
+		SerialPort::FrameReceiver Receiver;
+
+		/// 请求间隔
+		std::chrono::milliseconds Interval {200};
+		/// 工作线程，定时发送请求
+		std::thread Worker;
+		/// 是否运行
+		std::atomic_bool Running {false};
+		/// 是否启动了串口的异步读取
+		bool ReadingPort {false};
+		/// 应答比请求多出的字节的传输时间，单位为纳秒，启动时按串口的设定计算
+		std::int64_t ExtraPongTransmissionTime {0};
+
+		/// 下一个请求序号，仅由工作线程访问
+		unsigned short NextSequence {0};
+		/// 等待应答的请求序号
+		std::array<std::atomic<unsigned short>, PendingCapacity> PendingSequences {};
+		/// 等待应答的请求的发送时间，单位为纳秒，为零表示空闲
+		std::array<std::atomic<std::int64_t>, PendingCapacity> PendingSendTimes {};
+
+		/// 最近的样本，仅由接收线程访问，即串口的输入输出线程或调用Feed的线程
+		std::array<Sample, WindowSize> Samples {};
+		/// 已收集的样本数，仅由接收线程访问
+		std::size_t SampleCount {0};
+		/// 展开回绕后的上一次下位机时间，单位为微秒，仅由接收线程访问
+		std::int64_t LastMCUTime {0};
+
+		/// 偏移估计，单位为纳秒
+		std::atomic<std::int64_t> Offset {0};
+		/// 偏移估计所用样本的往返时间，单位为纳秒
+		std::atomic<std::int64_t> RoundTripTime {0};
+		/// 是否已有偏移估计
+		std::atomic_bool Synchronized {false};
+
+		/// 发送一次请求
+		void SendPing();
+
+		/// 处理一个应答
+		void HandlePong(const unsigned char* data, std::size_t size);
+
+		/// 工作线程主循环
+		void Run();
+
+	public:
+		/**
+		 * @brief 构造并绑定串口
+		 * @param device 串口，需在调用Start之前开启并启动异步写入
+		 */
+		explicit ClockSynchronizer(SerialPort::Port& device);
+
+		/// 析构，若工作线程仍在运行则停止
+		~ClockSynchronizer();
+
+		/**
+		 * @brief 设置请求间隔
+		 * @param interval 请求间隔
+		 */
+		void SetInterval(std::chrono::milliseconds interval);
+
+		/**
+		 * @brief 启动后台同步
+		 * @param read_port 是否启动串口的异步读取接收应答，应答在串口的输入输出线程中处理；
+		 *                  若串口由其他途径读取，则设为false，并将读取到的数据传给Feed
+		 */
+		void Start(bool read_port = true);
+
+		/// 停止后台同步
+		void Stop();
+
+		/**
+		 * @brief 提供从串口读取的数据
+		 * @param data 数据指针
+		 * @param size 数据大小
+		 * @details 只允许一个线程调用，且不得与串口的异步读取同时使用。
+		 */
+		void Feed(const unsigned char* data, std::size_t size);
+
+		/// 是否已有偏移估计
+		[[nodiscard]] inline bool IsSynchronized() const noexcept
+		{
+			return Synchronized.load(std::memory_order_acquire);
+		}
+
+		/// 获取偏移估计，即下位机时间减去主机时间
+		[[nodiscard]] inline std::chrono::nanoseconds GetOffset() const noexcept
+		{
+			return std::chrono::nanoseconds(Offset.load(std::memory_order_relaxed));
+		}
+
+		/// 获取偏移估计所用样本的往返时间
+		[[nodiscard]] inline std::chrono::nanoseconds GetRoundTripTime() const noexcept
+		{
+			return std::chrono::nanoseconds(RoundTripTime.load(std::memory_order_relaxed));
+		}
+
+		/**
+		 * @brief 将主机时间转换为下位机时间
+		 * @param time 主机单调时钟时间
+		 * @return 以微秒为单位的32位下位机时间；尚未同步时返回0，下位机应将0视为无效
+		 */
+		[[nodiscard]] std::uint32_t ToMCUTime(std::chrono::steady_clock::time_point time) const noexcept;
+	};
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <Core/Frames/Frame.hpp>
+#include "./ResultPacketSchema.hpp"
+
+namespace RoboPioneers::Prometheus
+{
+	/**
+	 * @brief 结果数据包
+	 * @author Vincent
+	 * @details
+	 *  ~ 将帧的处理结果按照ResultPacketSchema写入帧持有的字节包。
+	 *  ~ 发送的是目标预测器给出的目标，预测器未开启时其与选择器的输出相同。
+	 *  ~ 时间戳为目标所描述的时刻，即帧的PredictedTime，而不是采集时间，见ResultPacketSchema。
+	 *  ~ 新增字段只需修改ResultPacketSchema，偏移量与大小由编译期计算。
+	 */
+	struct ResultPacket
+	{
+		/// 数据包结构
+		using Schema = ResultPacketSchema;
+
+		static_assert(Schema::Size == Core::Frame::PacketSize, "Frame packet size does not match the result packet schema.");
+
+		/**
+		 * @brief 将帧的处理结果序列化到帧持有的字节包中
+		 * @param frame 帧
+		 * @param target_time 以下位机时钟表示的frame.PredictedTime，单位为微秒，尚未同步时为0
+		 */
+		static inline void Serialize(Core::Frame& frame, unsigned int target_time) noexcept
+		{
+			Schema::Serialize(frame.Packet,
+			                  static_cast<unsigned char>(frame.PredictedTarget.Found ? 1 : 0),
+			                  static_cast<unsigned short>(frame.PredictedTarget.X),
+			                  static_cast<unsigned short>(frame.PredictedTarget.Y),
+			                  static_cast<unsigned short>(frame.PredictedTarget.Distance),
+			                  static_cast<unsigned short>(frame.SensorFrameID),
+			                  target_time);
+		}
+	};
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <SerialPortUtilities/PacketSchema.hpp>
+
+namespace RoboPioneers::Prometheus
+{
+	/**
+	 * @brief 结果数据包结构
+	 * @details
+	 *  ~ 各字段均为小端序：帧头0xFF，是否找到目标，目标X坐标，目标Y坐标，目标距离，相机帧号的低16位，
+	 *    以下位机时钟表示的目标时刻，8位CRC校验码。
+	 *  ~ 目标时刻是坐标与距离所描述的时刻，以微秒为单位，由时钟同步器换算，尚未同步时为0。
+	 *    预测关闭时它等于采集时间；预测开启时坐标已外推至预期执行时刻，它即为该时刻。
+	 *  ~ 下位机只应补偿当前时间与目标时刻之差；差值为负表示坐标描述的是将来的时刻，不应再额外外推。
+	 *  ~ 该头文件不依赖Core，可供下位机模拟器等工具直接使用。
+	 */
+	using ResultPacketSchema = SerialPort::Utilities::PacketSchema<
+			SerialPort::Utilities::ConstantField<unsigned char, 0xFF>,
+			SerialPort::Utilities::Field<unsigned char>,
+			SerialPort::Utilities::Field<unsigned short>,
+			SerialPort::Utilities::Field<unsigned short>,
+			SerialPort::Utilities::Field<unsigned short>,
+			SerialPort::Utilities::Field<unsigned short>,
+			SerialPort::Utilities::Field<unsigned int>,
+			SerialPort::Utilities::CRC8Field>;
+}
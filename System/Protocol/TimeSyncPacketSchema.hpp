@@ -0,0 +1,27 @@
+#pragma once
+
+#include <SerialPortUtilities/PacketSchema.hpp>
+
+namespace RoboPioneers::Prometheus
+{
+	/**
+	 * @brief 时间同步请求数据包结构
+	 * @details 由上位机发往下位机，各字段均为小端序：帧头0xFE，请求序号，8位CRC校验码。
+	 */
+	using PingPacketSchema = SerialPort::Utilities::PacketSchema<
+			SerialPort::Utilities::ConstantField<unsigned char, 0xFE>,
+			SerialPort::Utilities::Field<unsigned short>,
+			SerialPort::Utilities::CRC8Field>;
+
+	/**
+	 * @brief 时间同步应答数据包结构
+	 * @details
+	 *  ~ 由下位机收到请求后立即回复，各字段均为小端序：帧头0xFD，请求序号，下位机时间，8位CRC校验码。
+	 *  ~ 下位机时间以微秒为单位，32位无符号整数，允许回绕。
+	 */
+	using PongPacketSchema = SerialPort::Utilities::PacketSchema<
+			SerialPort::Utilities::ConstantField<unsigned char, 0xFD>,
+			SerialPort::Utilities::Field<unsigned short>,
+			SerialPort::Utilities::Field<unsigned int>,
+			SerialPort::Utilities::CRC8Field>;
+}
@@ -3,12 +3,17 @@
 namespace RoboPioneers::Prometheus
 {
 	/// 执行
-	void CuttingChooser::Execute()
+	void CuttingChooser::Execute(Core::Frame& frame)
 	{
+		// 上一帧的目标信息，第一帧没有上一帧时视为未找到
+		static const Core::TargetInformation empty_target;
+		const auto& previous_target = frame.Previous ? frame.Previous->Target : empty_target;
+		const auto& interested_area = previous_target.InterestedArea;
+
 		// 准许裁剪旗标，为true则将在函数的末尾发生裁剪
 		bool approval_cutting {false};
 
-		if (*Found)
+		if (previous_target.Found)
 		{
 			// 如果找到目标
 
@@ -23,8 +28,8 @@ namespace RoboPioneers::Prometheus
 			{
 				// 未处于追踪态，则进行判断
 
-				auto intersection_area = static_cast<float>((*InterestedArea & LastInterestedArea).area());
-				if (intersection_area / InterestedArea->area() > MinIntersectionAreaRatio)
+				auto intersection_area = static_cast<float>((interested_area & LastInterestedArea).area());
+				if (intersection_area / interested_area.area() > MinIntersectionAreaRatio)
 				{
 					// 认定为同一区域，准许计数减一
 					--ApprovalRequiredTimes;
@@ -45,7 +50,7 @@ namespace RoboPioneers::Prometheus
 			}
 
 			// 记录该次兴趣区
-			LastInterestedArea = *InterestedArea;
+			LastInterestedArea = interested_area;
 		}
 		else
 		{
@@ -68,17 +73,17 @@ namespace RoboPioneers::Prometheus
 
 		if (approval_cutting)
 		{
-			// 进行裁剪
-			(*OriginalPicture)(*InterestedArea).copyTo(CuttingPicture);
-			PositionOffset.x = InterestedArea->x;
-			PositionOffset.y = InterestedArea->y;
+			// 进行裁剪，裁剪结果为源图像上的视图，不进行拷贝
+			frame.CuttingPicture = frame.OriginalPicture(interested_area);
+			frame.PositionOffset.x = interested_area.x;
+			frame.PositionOffset.y = interested_area.y;
 		}
 		else
 		{
 			// 不进行裁剪
-			CuttingPicture = (*OriginalPicture);
-			PositionOffset.x = 0;
-			PositionOffset.y = 0;
+			frame.CuttingPicture = frame.OriginalPicture;
+			frame.PositionOffset.x = 0;
+			frame.PositionOffset.y = 0;
 		}
 	}
 }
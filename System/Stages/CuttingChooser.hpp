@@ -1,5 +1,8 @@
 #pragma once
 
+#include <Core/Frames/Frame.hpp>
+#include <Core/Pipelines/Slots.hpp>
+
 #include <opencv4/opencv2/opencv.hpp>
 
 namespace RoboPioneers::Prometheus
@@ -14,21 +17,13 @@ namespace RoboPioneers::Prometheus
 	{
 	public:
 		//==============================
-		// 输入部分
+		// 输入输出部分
 		//==============================
 
-		/// 输入的源图像
-		cv::Mat* OriginalPicture;
-
-		/// 输入的上一帧兴趣区
-		cv::Rect* InterestedArea;
-		/// 输入的是否找到目标
-		bool* Found;
-
-		/// 输出的裁剪图像
-		cv::Mat CuttingPicture;
-		/// 输出的当前图片偏移坐标
-		cv::Point PositionOffset;
+		/// 输入槽，读取源图像与上一帧的兴趣区及是否找到目标
+		using InputSlots = Core::SlotList<Core::Slots::OriginalPicture, Core::Slots::PreviousTarget>;
+		/// 输出槽，输出的裁剪图像为源图像上的视图，在源图像被复用前有效
+		using OutputSlots = Core::SlotList<Core::Slots::CuttingPicture, Core::Slots::PositionOffset>;
 
 	public:
 		//==============================
@@ -81,6 +76,14 @@ namespace RoboPioneers::Prometheus
 
 	public:
 		/// 执行方法
-		void Execute();
+		void Execute(Core::Frame& frame);
+
+		/// 退出锁定状态，下一帧进行全局检索
+		inline void Reset() noexcept
+		{
+			LockingRemainTimes = 0;
+			ApprovalRequiredTimes = LockingApprovalThreshold;
+			LastInterestedArea = cv::Rect();
+		}
 	};
 }
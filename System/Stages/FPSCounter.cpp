@@ -1,28 +1,80 @@
 #include "FPSCounter.hpp"
 
 #include <iostream>
+#include <iomanip>
 
 namespace RoboPioneers::Prometheus
 {
 	// 执行方法
-	void FPSCounter::Execute()
+	void FPSCounter::Execute(Core::Frame& frame)
 	{
 		auto current_time = std::chrono::steady_clock::now();
 		++Frames;
 
-		if (*Found)
+		if (frame.Target.Found)
 		{
 			++FoundCount;
 		}
 
-		if (std::chrono::duration_cast<std::chrono::milliseconds>(current_time - LastOutputTime).count() > 1000)
+		auto elapsed_time = current_time - LastOutputTime;
+		if (elapsed_time > ReportInterval)
 		{
-			std::cout << "FPS: " << Frames << std::endl;
+			auto elapsed_seconds = std::chrono::duration<double>(elapsed_time).count();
+
+			LastReport.FPS = static_cast<double>(Frames) / elapsed_seconds;
+			LastReport.FoundRatio = static_cast<double>(FoundCount) / static_cast<double>(Frames) * 100.0f;
+			if (Statistics)
+			{
+				// 获取快照的同时清空直方图，使每份报告只包含本周期内的样本
+				LastReport.Stages = Statistics->TakeSnapshot(true);
+			}
+			if (Hardware)
+			{
+				LastReport.Hardware = Hardware->TakeSnapshot(true);
+			}
+
+			PublishedReport.Write(LastReport);
+
+			if (PrintReport)
+			{
+				Print(LastReport);
+			}
+
 			LastOutputTime = current_time;
-			std::cout << "Ratio: " << static_cast<double>(FoundCount) / static_cast<double>(Frames) * 100.0f << "%" << std::endl;
 			FoundCount = 0;
-
 			Frames = 0;
 		}
 	}
+
+	/// 输出报告
+	void FPSCounter::Print(const Report& report)
+	{
+		std::clog << std::fixed << std::setprecision(1)
+			<< "[Performance] FPS: " << report.FPS << " Ratio: " << report.FoundRatio << "%" << std::endl;
+
+		for (std::size_t index = 0; index < Core::StageStatistics::StageCount; ++index)
+		{
+			const auto& stage = report.Stages[index];
+			if (stage.Count == 0) continue;
+
+			// 以微秒为单位输出
+			std::clog << "  " << std::left << std::setw(12)
+				<< Core::StageStatistics::GetName(static_cast<Core::StageIdentifier>(index)) << std::right
+				<< " p50:" << std::setw(8) << stage.P50 / 1000.0
+				<< " p90:" << std::setw(8) << stage.P90 / 1000.0
+				<< " p99:" << std::setw(8) << stage.P99 / 1000.0
+				<< " max:" << std::setw(8) << stage.Max / 1000.0 << " us";
+
+			// 硬件计数以每次执行的平均值输出
+			const auto& hardware = report.Hardware[index];
+			if (hardware.Samples != 0)
+			{
+				std::clog << std::setprecision(2) << " ipc:" << hardware.GetIPC() << std::setprecision(0)
+					<< " cache-miss:" << hardware.GetAverage(Core::HardwareEvent::CacheMisses)
+					<< " branch-miss:" << hardware.GetAverage(Core::HardwareEvent::BranchMisses)
+					<< std::setprecision(1);
+			}
+			std::clog << std::endl;
+		}
+	}
 }
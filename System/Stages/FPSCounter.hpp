@@ -1,5 +1,11 @@
 #pragma once
 
+#include <Core/Frames/Frame.hpp>
+#include <Core/Pipelines/Slots.hpp>
+#include <Core/Diagnostics/StageStatistics.hpp>
+#include <Core/Diagnostics/TripleBuffer.hpp>
+#include <Core/Diagnostics/HardwareStatistics.hpp>
+
 #include <chrono>
 
 namespace RoboPioneers::Prometheus
@@ -8,20 +14,57 @@ namespace RoboPioneers::Prometheus
 	 * @brief FPS计数器
 	 * @author Vincent
 	 * @details
-	 *  ~ 该计数器用于统计帧数。
+	 *  ~ 该计数器用于统计帧数与锁定比例，并周期性地获取各阶段延迟的统计快照，生成性能报告。
 	 */
 	class FPSCounter
 	{
 	public:
+		/// 输入槽
+		using InputSlots = Core::SlotList<Core::Slots::Target>;
+		/// 输出槽
+		using OutputSlots = Core::SlotList<>;
+
+		/// 性能报告
+		struct Report
+		{
+			/// 帧率
+			double FPS {0.0};
+			/// 找到目标的帧的比例，单位为1%
+			double FoundRatio {0.0};
+			/// 报告周期内各阶段的延迟统计
+			Core::StageStatistics::Snapshot Stages {};
+			/// 报告周期内各阶段的硬件计数统计
+			Core::HardwareStatistics::Snapshot Hardware {};
+		};
+
+		/// 阶段统计，为空则报告中不含延迟统计
+		Core::StageStatistics* Statistics {nullptr};
+		/// 硬件计数统计，为空则报告中不含硬件计数
+		Core::HardwareStatistics* Hardware {nullptr};
+
+		/// 报告周期
+		std::chrono::milliseconds ReportInterval {1000};
+		/// 是否将报告输出到日志
+		bool PrintReport {true};
+
+		/// 最近一次生成的报告
+		Report LastReport;
+		/// 已发布的报告，供监控线程无锁读取
+		Core::TripleBuffer<Report> PublishedReport;
+
 		/// 上一次的输出时间
 		std::chrono::steady_clock::time_point LastOutputTime {std::chrono::steady_clock::now()};
 		/// 距上一次输出已经经过的帧数
 		unsigned int Frames {0};
-		bool* Found;
+		/// 距上一次输出已经找到目标的帧数
 		unsigned int FoundCount {0};
 
+	protected:
+		/// 将报告输出到日志
+		static void Print(const Report& report);
+
 	public:
-		/// 执行，满1s时将输出帧率
-		void Execute();
+		/// 执行，满一个报告周期时将生成报告
+		void Execute(Core::Frame& frame);
 	};
 }
@@ -0,0 +1,161 @@
+#include <System/CPUPipeline.hpp>
+#include <Simulation/PrometheusSimulation.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace RoboPioneers::Prometheus::Tests
+{
+	/// 被测流水线，堆分配钩子将各阶段的分配归属到阶段标识符
+	using TestPipeline = CPUPipeline<Core::AllocationHook<>>;
+
+	/// 合成场景的帧数，预热与测量均在这些帧上循环
+	constexpr std::size_t SceneFrameCount = 8;
+	/// 预热的轮数，使各缓冲区的容量达到这组场景所需的最大值
+	constexpr std::size_t WarmUpRounds = 4;
+	/// 测量的帧数
+	constexpr std::size_t MeasuredFrameCount = 240;
+
+	/**
+	 * @brief 各统计槽每帧允许的平均堆分配次数
+	 * @details
+	 *  ~ 灯条检测阶段中，OpenCV的findContours每次为带边框的工作图像与轮廓存储分配内存，
+	 *    minAreaRect为每个通过面积筛选的轮廓的凸包分配内存；这组场景每帧至多有56个轮廓，
+	 *    故预算取固定开销16次与每个轮廓2次之和。
+	 *  ~ 其余阶段的缓冲区均在帧间复用，流水线之外（包括未继承阶段的工作线程）也不应分配，预算均为零。
+	 */
+	constexpr auto MakeAllocationBudgets()
+	{
+		std::array<std::uint64_t, Core::AllocationAccounting::SlotCount> budgets {};
+		budgets[static_cast<std::size_t>(Core::StageIdentifier::Detect)] = 16 + 2 * 56;
+		return budgets;
+	}
+	constexpr auto AllocationBudgets = MakeAllocationBudgets();
+
+	/// 生成合成场景的原始图像，均为独立的拷贝，测量期间不再生成
+	std::vector<cv::Mat> MakeScenes(const cv::Size& picture_size)
+	{
+		Simulation::SceneStream stream(Simulation::SceneGenerator::MakeRandomDescription(
+				picture_size, 4, 0.25, 16, 32, 0));
+
+		std::vector<cv::Mat> scenes;
+		for (std::size_t index = 0; index < SceneFrameCount; ++index)
+		{
+			auto picture = stream.Next();
+			scenes.push_back(cv::Mat(cv::Size(picture.Width, picture.Height), CV_8UC1, picture.Data).clone());
+		}
+		return scenes;
+	}
+
+	/// 设置与合成场景颜色相匹配的阈值，与回放工具的默认值一致
+	void Configure(TestPipeline& pipeline, const cv::Size& picture_size)
+	{
+		auto& color_stage = pipeline.Get<Core::CPUColorFilter>();
+		color_stage.MinHue = 90;
+		color_stage.MaxHue = 130;
+		color_stage.MinSaturation = 80;
+		color_stage.MaxSaturation = 255;
+		color_stage.MinValue = 120;
+		color_stage.MaxValue = 255;
+		color_stage.Reserve(picture_size);
+
+		auto& light_bar_stage = pipeline.Get<Core::LightBarDetector>();
+		light_bar_stage.MinArea = 20;
+		light_bar_stage.MinFillingRatio = 50;
+
+		pipeline.Get<Core::ArmorSelector>().ScreenWidth = picture_size.width;
+		pipeline.Get<Core::ArmorSelector>().ScreenHeight = picture_size.height;
+
+		using Core::StageIdentifier;
+		auto& allocation_hook = pipeline.Hooks;
+		allocation_hook.Bind(TestPipeline::IndexOf<Core::BayerConverter>(), StageIdentifier::Debayer);
+		allocation_hook.Bind(TestPipeline::IndexOf<CuttingChooser>(), StageIdentifier::Cut);
+		allocation_hook.Bind(TestPipeline::IndexOf<Core::CPUColorFilter>(), StageIdentifier::Color);
+		allocation_hook.Bind(TestPipeline::IndexOf<Core::LightBarDetector>(), StageIdentifier::Detect);
+		allocation_hook.Bind(TestPipeline::IndexOf<Core::ArmorMatcher>(), StageIdentifier::Match);
+		allocation_hook.Bind(TestPipeline::IndexOf<Core::ArmorSelector>(), StageIdentifier::Select);
+	}
+}
+
+/**
+ * @brief 稳态堆分配测试
+ * @details
+ *  ~ 在合成场景上运行CPU流水线，预热后统计各统计槽在若干帧内的堆分配次数，
+ *    任一统计槽每帧的平均分配次数超出其预算即失败；除灯条检测外，预算均为零。
+ *  ~ 场景在测量前生成，测量期间测试本身不分配内存，故不属于任何阶段的统计槽同样参与判断。
+ *  ~ 须以PROMETHEUS_ALLOCATION_ACCOUNTING选项构建，否则无法统计。
+ */
+int main()
+{
+	using namespace RoboPioneers::Prometheus;
+	using namespace RoboPioneers::Prometheus::Tests;
+
+	if constexpr (!Core::AllocationAccounting::IsAvailable())
+	{
+		std::cerr << "[Error] Heap allocation accounting is disabled, "
+			"configure with -DPROMETHEUS_ALLOCATION_ACCOUNTING=ON to run this test." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const cv::Size picture_size(1280, 1024);
+	const auto scenes = MakeScenes(picture_size);
+
+	TestPipeline pipeline;
+	Configure(pipeline, picture_size);
+
+	Core::FramePool<3> frames;
+	frames.Reserve(picture_size, false);
+
+	auto execute = [&](std::size_t index){
+		auto& frame = frames.Acquire();
+		frame.RawPicture = scenes[index % scenes.size()];
+		frame.SensorFrameID = index + 1;
+		pipeline.Execute(frame);
+	};
+
+	for (std::size_t index = 0; index < WarmUpRounds * scenes.size(); ++index)
+	{
+		execute(index);
+	}
+
+	const auto before = Core::AllocationAccounting::TakeSnapshot();
+	for (std::size_t index = 0; index < MeasuredFrameCount; ++index)
+	{
+		execute(index);
+	}
+	const auto allocations = Core::AllocationAccounting::GetDifference(
+			Core::AllocationAccounting::TakeSnapshot(), before);
+
+	bool passed = true;
+	for (std::size_t slot = 0; slot < Core::AllocationAccounting::SlotCount; ++slot)
+	{
+		const auto& stage = allocations[slot];
+		const auto* name = slot == Core::AllocationAccounting::UnattributedSlot ? "Unattributed" :
+			Core::StageStatistics::GetName(static_cast<Core::StageIdentifier>(slot));
+
+		if (stage.Count > AllocationBudgets[slot] * MeasuredFrameCount)
+		{
+			passed = false;
+			std::cerr << "[Error] Stage " << name << " allocated " << stage.Count << " times (" << stage.Bytes
+				<< " Bytes) in " << MeasuredFrameCount << " steady state frames, the budget is "
+				<< AllocationBudgets[slot] << " times per frame." << std::endl;
+		}
+		else if (stage.Count > 0)
+		{
+			std::clog << "[Message] Stage " << name << " allocated " << stage.Count << " times in "
+				<< MeasuredFrameCount << " steady state frames, within the budget of "
+				<< AllocationBudgets[slot] << " times per frame." << std::endl;
+		}
+	}
+
+	if (passed)
+	{
+		std::clog << "[Message] All stages stayed within their allocation budgets in "
+			<< MeasuredFrameCount << " steady state frames." << std::endl;
+	}
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
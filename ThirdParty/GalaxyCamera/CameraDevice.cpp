@@ -2,6 +2,7 @@
 #include "AbstractAcquisitor.hpp"
 
 #include <sstream>
+#include <cstdint>
 #include <GxIAPI.h>
 
 namespace RoboPioneers::Cameras::Galaxy
@@ -21,11 +22,11 @@ namespace RoboPioneers::Cameras::Galaxy
 	{
 		using namespace RoboPioneers::Cameras::Galaxy;
 
-        throw std::runtime_error("CameraDevice Offline");
-
+		// 该函数由SDK的线程调用，异常无法被用户捕获，故只标记设备离线并通知采集器，由用户在其他线程中重新开启
 		auto* target = static_cast<CameraDevice*>(parameter);
 		if (target)
 		{
+			target->Online = false;
 			target->InvokeAcquisitorsOfflineEvent();
 		}
 	}
@@ -35,6 +36,9 @@ namespace RoboPioneers::Cameras::Galaxy
 	{
 		using namespace RoboPioneers::Cameras::Galaxy;
 
+		// 尽早记录回调时间，以免后续操作计入采集延迟
+		auto receive_time = std::chrono::steady_clock::now();
+
 		auto* parameters =  static_cast<GX_FRAME_CALLBACK_PARAM*>(parameters_package);
 		auto* target = static_cast<CameraDevice*>(parameters->pUserParam);
 
@@ -45,10 +49,13 @@ namespace RoboPioneers::Cameras::Galaxy
 			picture.Size = parameters->nImgSize;
 			picture.Width = parameters->nWidth;
 			picture.Height = parameters->nHeight;
+			picture.FrameID = parameters->nFrameID;
+			picture.TimeStamp = parameters->nTimestamp;
+			picture.ReceiveTime = receive_time;
 			target->InvokeAcquisitorsCaptureEvent(picture);
-		}
 
-        target->LastPictureTimeStamp = std::chrono::system_clock::now();
+			target->LastPictureTimeStamp = receive_time;
+		}
 	}
 
 	/// 构造并绑定设备索引
@@ -67,6 +74,8 @@ namespace RoboPioneers::Cameras::Galaxy
 				GXUnregisterCaptureCallback(DeviceHandle);
 				GXUnregisterDeviceOfflineCallback(DeviceHandle, DeviceOfflineHandle);
 
+				// 析构时不应再有其他线程使用该设备，不等待归还，只作废当前图片
+				RetireCurrentPicture(false);
 				GXCloseDevice(DeviceHandle);
 				DeviceHandle = nullptr;
 			}
@@ -137,8 +146,9 @@ namespace RoboPioneers::Cameras::Galaxy
 			throw std::runtime_error("CameraDevice::Open Failed to Start Acquisition.");
 		}
 
+		LastPictureTimeStamp = std::chrono::steady_clock::now();
 		Opened = true;
-		LastPictureTimeStamp = std::chrono::system_clock::now();
+		Online = true;
 	}
 
 	/// 停止采集并关闭设备
@@ -153,9 +163,42 @@ namespace RoboPioneers::Cameras::Galaxy
 			GXUnregisterCaptureCallback(DeviceHandle);
 			GXUnregisterDeviceOfflineCallback(DeviceHandle, DeviceOfflineHandle);
 
+			// 采集回调已注销，等待处理线程归还仍指向SDK缓冲区的图片后才能回收缓冲区
+			RetireCurrentPicture(true);
 			GXCloseDevice(DeviceHandle);
 			DeviceHandle = nullptr;
 		}
+		Opened = false;
+		Online = false;
+	}
+
+	/// 作废当前图片
+	void CameraDevice::RetireCurrentPicture(bool wait_release)
+	{
+		std::unique_lock lock(PictureMutex);
+		if (wait_release)
+		{
+			// 持有图片的线程自身关闭设备时无需等待，否则将永远阻塞
+			PictureCondition.wait(lock, [this]{
+				return !PictureInUse || PictureHolder == std::this_thread::get_id();
+			});
+		}
+		PictureInUse = false;
+		CurrentPicture = RawPicture();
+		RetiredPictureIndex = CurrentPictureIndex;
+	}
+
+	/// 获取时间戳频率
+	unsigned long long CameraDevice::GetTimeStampTickFrequency()
+	{
+		std::int64_t frequency = 0;
+		if (DeviceHandle &&
+		    GXGetInt(DeviceHandle, GX_INT_TIMESTAMP_TICK_FREQUENCY, &frequency) == GX_STATUS_LIST::GX_STATUS_SUCCESS &&
+		    frequency > 0)
+		{
+			return static_cast<unsigned long long>(frequency);
+		}
+		return 0;
 	}
 
 	/// 设置曝光时间
@@ -264,8 +307,13 @@ namespace RoboPioneers::Cameras::Galaxy
 	/// 调用所有采集器的采集事件
 	void CameraDevice::InvokeAcquisitorsCaptureEvent(RawPicture picture)
 	{
-		++CurrentPictureIndex;
-		CurrentPicture = picture;
+		{
+			std::lock_guard lock(PictureMutex);
+			++CurrentPictureIndex;
+			CurrentPicture = picture;
+		}
+		PictureCondition.notify_all();
+
 		if (!Acquisitors.empty())
 		{
 			for (auto acquisitor : Acquisitors)
@@ -275,6 +323,41 @@ namespace RoboPioneers::Cameras::Galaxy
 		}
 	}
 
+	/// 等待下一张图片
+	bool CameraDevice::WaitForNextPicture(RawPicture &picture, unsigned long long &picture_index,
+	                                      std::chrono::milliseconds timeout)
+	{
+		std::unique_lock lock(PictureMutex);
+		// 再次等待即表示上一张图片已处理完毕，归还后等待中的Close可以回收其缓冲区
+		if (PictureInUse)
+		{
+			PictureInUse = false;
+			PictureCondition.notify_all();
+		}
+		if (!PictureCondition.wait_for(lock, timeout, [this, picture_index]{
+			return CurrentPictureIndex > picture_index && CurrentPictureIndex > RetiredPictureIndex;
+		}))
+		{
+			return false;
+		}
+
+		picture = CurrentPicture;
+		picture_index = CurrentPictureIndex;
+		PictureInUse = true;
+		PictureHolder = std::this_thread::get_id();
+		return true;
+	}
+
+	/// 归还图片
+	void CameraDevice::ReleasePicture()
+	{
+		{
+			std::lock_guard lock(PictureMutex);
+			PictureInUse = false;
+		}
+		PictureCondition.notify_all();
+	}
+
 	/// 注册采集器
 	void CameraDevice::RegisterAcquisitor(AbstractAcquisitor *acquisitor)
 	{
@@ -5,7 +5,9 @@
 #include <functional>
 #include <atomic>
 #include <mutex>
+#include <condition_variable>
 #include <chrono>
+#include <thread>
 #include "RawPicture.hpp"
 
 namespace RoboPioneers::Cameras::Galaxy
@@ -30,7 +32,8 @@ namespace RoboPioneers::Cameras::Galaxy
 		/// 相机设备索引
 		unsigned int CameraIndex;
 
-        std::chrono::system_clock::time_point LastPictureTimeStamp;
+		/// 最近一次采集回调的时间，使用单调时钟以免受系统时间调整的影响，由采集回调线程写入
+		std::atomic<std::chrono::steady_clock::time_point> LastPictureTimeStamp {};
 
 		/**
 		 * @brief 触发采集器的离线事件
@@ -49,6 +52,25 @@ namespace RoboPioneers::Cameras::Galaxy
 		/// 当前图片
 		RawPicture CurrentPicture;
 
+		/// 当前图片互斥量
+		std::mutex PictureMutex;
+		/// 新图片到达或在用图片被归还的条件变量
+		std::condition_variable PictureCondition;
+		/// 调用者是否仍在使用WaitForNextPicture交付的图片，其数据直接指向SDK的缓冲区
+		bool PictureInUse {false};
+		/// 正在使用该图片的线程
+		std::thread::id PictureHolder;
+		/// 已作废的图片索引，关闭设备后该索引及之前的图片缓冲区已被SDK回收，不再交付
+		unsigned long long RetiredPictureIndex {0};
+
+		/**
+		 * @brief 作废当前图片
+		 * @param wait_release 是否等待其他线程归还正在使用的图片
+		 * @details
+		 *  ~ 须在注销采集回调之后、关闭设备句柄之前调用，此后不会再有图片指向即将被回收的缓冲区。
+		 */
+		void RetireCurrentPicture(bool wait_release);
+
 	protected:
 		/// 设备句柄
 		void* DeviceHandle {nullptr};
@@ -57,6 +79,8 @@ namespace RoboPioneers::Cameras::Galaxy
 
 		/// 设备是否已经被打开
 		std::atomic_bool Opened {false};
+		/// 设备是否在线，开启后为真，离线事件发生或关闭后为假
+		std::atomic_bool Online {false};
 		/// 相机控制互斥量
 		std::mutex ControlMutex;
 
@@ -103,6 +127,9 @@ namespace RoboPioneers::Cameras::Galaxy
 		 * @brief 关闭相机
 		 * @details
 		 *  ~ 不会触发相机离线事件。
+		 *  ~ 设备离线后，应先调用该方法释放原有的设备句柄，再重新开启相机。
+		 *  ~ 关闭句柄前将阻塞至其他线程归还由WaitForNextPicture交付的图片，
+		 *    故持有图片的线程在退出处理循环时须调用ReleasePicture。
 		 */
 		virtual void Close();
 
@@ -125,6 +152,22 @@ namespace RoboPioneers::Cameras::Galaxy
 			return Opened;
 		}
 
+		/**
+		 * @brief 判断相机是否在线
+		 * @retval true 当相机已开启且没有发生离线事件
+		 * @retval false 当相机未开启或已经离线
+		 */
+		[[nodiscard]] bool IsOnline() const noexcept
+		{
+			return Online;
+		}
+
+		/// 获取最近一次采集回调的时间
+		[[nodiscard]] std::chrono::steady_clock::time_point GetLastPictureTime() const noexcept
+		{
+			return LastPictureTimeStamp.load(std::memory_order_relaxed);
+		}
+
 		//==============================
 		// 原始图片控制部分
 		//==============================
@@ -148,9 +191,9 @@ namespace RoboPioneers::Cameras::Galaxy
 		 */
 		[[nodiscard]] inline auto GetCurrentPicture() const -> RawPicture
 		{
-		    auto current_time_stamp = std::chrono::system_clock::now();
+		    auto current_time_stamp = std::chrono::steady_clock::now();
 
-		    if (std::chrono::duration_cast<std::chrono::seconds>(current_time_stamp - LastPictureTimeStamp).count()
+		    if (std::chrono::duration_cast<std::chrono::seconds>(current_time_stamp - GetLastPictureTime()).count()
 		        > 1)
             {
 		        throw std::runtime_error("Long time no picture income.");
@@ -159,6 +202,29 @@ namespace RoboPioneers::Cameras::Galaxy
 			return CurrentPicture;
 		}
 
+		/**
+		 * @brief 等待下一张图片
+		 * @param picture 用于存放图片信息
+		 * @param picture_index 调用者已取得的图片索引，取得新图片后被更新；初始为0时等待第一张图片
+		 * @param timeout 最长等待时间
+		 * @retval true 当取得了索引大于picture_index的图片
+		 * @retval false 当等待超时
+		 * @details
+		 *  ~ 该方法阻塞至采集回调交付新的图片，不会重复返回同一张图片；
+		 *    处理较慢时将直接取得最新的图片，中间的图片被跳过。
+		 *  ~ 图片数据直接指向SDK的缓冲区，在调用者再次调用该方法或调用ReleasePicture之前保持有效，
+		 *    其间Close将等待而不会回收该缓冲区。
+		 */
+		bool WaitForNextPicture(RawPicture& picture, unsigned long long& picture_index,
+		                        std::chrono::milliseconds timeout);
+
+		/**
+		 * @brief 归还由WaitForNextPicture交付的图片
+		 * @details
+		 *  ~ 此后该图片的数据不可再被访问，等待中的Close将继续关闭设备。
+		 */
+		void ReleasePicture();
+
 		//==============================
 		// 采集器控制部分
 		//==============================
@@ -173,6 +239,13 @@ namespace RoboPioneers::Cameras::Galaxy
 		// 相机参数设置部分
 		//==============================
 
+		/**
+		 * @brief 获取时间戳频率
+		 * @pre 设备已经打开
+		 * @return 相机时间戳每秒的计数值，当相机未开启或查询失败时返回0
+		 */
+		virtual unsigned long long GetTimeStampTickFrequency();
+
 		/**
 		 * @brief 设置曝光时间
 		 * @param value 曝光时间，单位为微秒(us)
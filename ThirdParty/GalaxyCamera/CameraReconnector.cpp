@@ -0,0 +1,155 @@
+#include "CameraReconnector.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+namespace RoboPioneers::Cameras::Galaxy
+{
+	/// 构造并注册到相机设备
+	CameraReconnector::CameraReconnector(CameraDevice &device) : Device(device)
+	{
+		Device.RegisterAcquisitor(this);
+	}
+
+	/// 析构
+	CameraReconnector::~CameraReconnector()
+	{
+		Stop();
+		Device.UnregisterAcquisitor(this);
+	}
+
+	/// 设置判定为停止出图的无图片时长
+	void CameraReconnector::SetStallTimeout(std::chrono::milliseconds timeout)
+	{
+		StallTimeout = timeout;
+	}
+
+	/// 设置开启失败后的重试间隔
+	void CameraReconnector::SetRetryInterval(std::chrono::milliseconds initial_interval,
+	                                         std::chrono::milliseconds max_interval)
+	{
+		InitialRetryInterval = initial_interval;
+		MaxRetryInterval = max_interval;
+	}
+
+	/// 设置重连完成回调
+	void CameraReconnector::SetCallback(ReconnectCallback callback)
+	{
+		Callback = std::move(callback);
+	}
+
+	/// 启动监视
+	void CameraReconnector::Start()
+	{
+		if (Worker.joinable()) return;
+		Running = true;
+		Worker = std::thread([this]{ Run(); });
+	}
+
+	/// 停止监视
+	void CameraReconnector::Stop()
+	{
+		{
+			std::lock_guard lock(WakeMutex);
+			Running = false;
+		}
+		WakeCondition.notify_all();
+		if (Worker.joinable())
+		{
+			Worker.join();
+		}
+	}
+
+	/// 设备离线事件
+	void CameraReconnector::OnDeviceOffline()
+	{
+		{
+			std::lock_guard lock(WakeMutex);
+			OfflineReported = true;
+		}
+		WakeCondition.notify_all();
+	}
+
+	/// 在后台线程中等待
+	bool CameraReconnector::WaitFor(std::chrono::milliseconds duration)
+	{
+		std::unique_lock lock(WakeMutex);
+		WakeCondition.wait_for(lock, duration, [this]{ return !Running || OfflineReported; });
+		return Running;
+	}
+
+	/// 关闭并重新开启相机
+	void CameraReconnector::Reconnect()
+	{
+		const auto begin_time = std::chrono::steady_clock::now();
+		auto retry_interval = InitialRetryInterval;
+
+		while (Running)
+		{
+			OfflineReported = false;
+			// 释放原有的设备句柄及其回调，将阻塞至处理线程归还仍指向旧缓冲区的图片
+			Device.Close();
+
+			try
+			{
+				Device.Open();
+
+				// 以重新开启后第一张图片的到达作为重连完成的标志
+				const auto opened_time = Device.GetLastPictureTime();
+				const auto deadline = std::chrono::steady_clock::now() + StallTimeout;
+				while (Running && !OfflineReported && Device.GetLastPictureTime() <= opened_time &&
+				       std::chrono::steady_clock::now() < deadline)
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+				if (Device.GetLastPictureTime() > opened_time) break;
+
+				std::clog << "[Warning] Camera Reopened but No Picture Arrived." << std::endl;
+			}
+			catch (std::exception& error)
+			{
+				std::clog << "[Warning] Failed to Reconnect Camera: '" << error.what() << "', will Attempt in "
+				          << retry_interval.count() << " Milliseconds." << std::endl;
+			}
+
+			// 等待重试间隔，期间只响应停止请求
+			{
+				std::unique_lock lock(WakeMutex);
+				WakeCondition.wait_for(lock, retry_interval, [this]{ return !Running; });
+			}
+			retry_interval = std::min(retry_interval * 2, MaxRetryInterval);
+		}
+		if (!Running) return;
+
+		auto reconnect_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+				std::chrono::steady_clock::now() - begin_time);
+		ReconnectCount.fetch_add(1, std::memory_order_relaxed);
+		LastReconnectTime.store(reconnect_time.count(), std::memory_order_relaxed);
+		if (reconnect_time.count() > MaxReconnectTime.load(std::memory_order_relaxed))
+		{
+			MaxReconnectTime.store(reconnect_time.count(), std::memory_order_relaxed);
+		}
+		std::clog << "[Message] Camera Reconnected in " << reconnect_time.count() << " Milliseconds." << std::endl;
+
+		if (Callback)
+		{
+			Callback(reconnect_time);
+		}
+	}
+
+	/// 后台线程主循环
+	void CameraReconnector::Run()
+	{
+		while (WaitFor(std::chrono::milliseconds(50)))
+		{
+			auto stalled = Device.IsOpened() &&
+			               std::chrono::steady_clock::now() - Device.GetLastPictureTime() > StallTimeout;
+			if (!OfflineReported && !stalled) continue;
+
+			std::clog << "[Warning] Camera " << (OfflineReported ? "Offline" : "Stalled")
+			          << ", Reconnecting." << std::endl;
+			Reconnect();
+		}
+	}
+}
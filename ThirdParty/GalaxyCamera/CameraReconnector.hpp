@@ -0,0 +1,139 @@
+#pragma once
+
+#include "CameraDevice.hpp"
+#include "AbstractAcquisitor.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace RoboPioneers::Cameras::Galaxy
+{
+	/**
+	 * @brief 相机重连器
+	 * @author Vincent
+	 * @details
+	 *  ~ 重连器作为采集器注册在相机设备中，接收设备离线事件；
+	 *    同时在后台线程中检查图片是否长时间未到达，以覆盖设备仍在线但停止出图的情形。
+	 *  ~ 发现设备离线后，后台线程关闭原有的设备句柄并重新开启相机，开启失败时的重试间隔倍增至上限。
+	 *  ~ 重连耗时从发现离线开始计算，至重新开启后第一张图片到达为止，单位为毫秒。
+	 *  ~ 重连期间相机对象本身保持不变，等待图片的用户线程只会等待超时，无需重建任何状态。
+	 */
+	class CameraReconnector : public AbstractAcquisitor
+	{
+	public:
+		/// 重连完成回调，参数为重连耗时
+		using ReconnectCallback = std::function<void(std::chrono::milliseconds)>;
+
+	protected:
+		/// 相机设备
+		CameraDevice& Device;
+
+		/// 判定为停止出图的无图片时长
+		std::chrono::milliseconds StallTimeout {500};
+		/// 开启失败后的初始重试间隔
+		std::chrono::milliseconds InitialRetryInterval {50};
+		/// 开启失败后的最大重试间隔
+		std::chrono::milliseconds MaxRetryInterval {1000};
+
+		/// 重连完成回调，在后台线程中调用
+		ReconnectCallback Callback;
+
+		/// 后台线程
+		std::thread Worker;
+		/// 是否运行
+		std::atomic_bool Running {false};
+		/// 唤醒后台线程的互斥量
+		std::mutex WakeMutex;
+		/// 唤醒后台线程的条件变量
+		std::condition_variable WakeCondition;
+		/// 是否收到了离线事件
+		std::atomic_bool OfflineReported {false};
+
+		/// 重连次数
+		std::atomic<std::uint64_t> ReconnectCount {0};
+		/// 最近一次重连的耗时，单位为毫秒
+		std::atomic<std::int64_t> LastReconnectTime {0};
+		/// 最长的重连耗时，单位为毫秒
+		std::atomic<std::int64_t> MaxReconnectTime {0};
+
+		/// 设备离线事件，由SDK的线程调用，仅唤醒后台线程
+		void OnDeviceOffline() override;
+
+		/// 接收到图片事件，重连器不处理图片
+		void OnReceivePicture(RawPicture) override
+		{}
+
+		/**
+		 * @brief 在后台线程中等待
+		 * @param duration 等待时长
+		 * @retval true 当等待结束且仍在运行
+		 * @retval false 当重连器被停止
+		 */
+		bool WaitFor(std::chrono::milliseconds duration);
+
+		/// 关闭并重新开启相机，直至第一张图片到达或重连器被停止
+		void Reconnect();
+
+		/// 后台线程主循环
+		void Run();
+
+	public:
+		/**
+		 * @brief 构造并注册到相机设备
+		 * @param device 相机设备
+		 * @details 应在相机开启之前构造，以免注册与采集回调并发。
+		 */
+		explicit CameraReconnector(CameraDevice& device);
+
+		/// 析构，停止后台线程并注销
+		~CameraReconnector();
+
+		/**
+		 * @brief 设置判定为停止出图的无图片时长
+		 * @param timeout 无图片时长
+		 */
+		void SetStallTimeout(std::chrono::milliseconds timeout);
+
+		/**
+		 * @brief 设置开启失败后的重试间隔
+		 * @param initial_interval 初始重试间隔
+		 * @param max_interval 最大重试间隔
+		 */
+		void SetRetryInterval(std::chrono::milliseconds initial_interval, std::chrono::milliseconds max_interval);
+
+		/**
+		 * @brief 设置重连完成回调
+		 * @param callback 回调函数，在后台线程中调用
+		 */
+		void SetCallback(ReconnectCallback callback);
+
+		/// 启动监视，应在相机首次开启之后调用
+		void Start();
+
+		/// 停止监视，正在进行的重连将被中止
+		void Stop();
+
+		/// 获取重连次数
+		[[nodiscard]] inline std::uint64_t GetReconnectCount() const noexcept
+		{
+			return ReconnectCount.load(std::memory_order_relaxed);
+		}
+
+		/// 获取最近一次重连的耗时
+		[[nodiscard]] inline std::chrono::milliseconds GetLastReconnectTime() const noexcept
+		{
+			return std::chrono::milliseconds(LastReconnectTime.load(std::memory_order_relaxed));
+		}
+
+		/// 获取最长的重连耗时
+		[[nodiscard]] inline std::chrono::milliseconds GetMaxReconnectTime() const noexcept
+		{
+			return std::chrono::milliseconds(MaxReconnectTime.load(std::memory_order_relaxed));
+		}
+	};
+}
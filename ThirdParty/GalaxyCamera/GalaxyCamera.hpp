@@ -4,6 +4,7 @@
 #include "CameraDevice.hpp"
 #include "AbstractAcquisitor.hpp"
 #include "LambdaAcquisitor.hpp"
+#include "CameraReconnector.hpp"
 
 namespace RoboPioneers::Cameras::Galaxy
 {}
\ No newline at end of file
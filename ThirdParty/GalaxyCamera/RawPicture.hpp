@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 namespace RoboPioneers::Cameras::Galaxy
 {
 	/**
@@ -31,5 +33,16 @@ namespace RoboPioneers::Cameras::Galaxy
 		int Width {0};
 		/// 图像高度
 		int Height {0};
+
+		/// 相机给出的帧号
+		unsigned long long FrameID {0};
+		/**
+		 * @brief 相机给出的时间戳
+		 * @details
+		 *  ~ 单位为相机时钟的计数值，其频率可由CameraDevice::GetTimeStampTickFrequency获取。
+		 */
+		unsigned long long TimeStamp {0};
+		/// 采集回调被触发的时间
+		std::chrono::steady_clock::time_point ReceiveTime;
 	};
 }
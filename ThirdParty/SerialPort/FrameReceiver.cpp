@@ -0,0 +1,196 @@
+#include "FrameReceiver.hpp"
+
+#include <SerialPortUtilities/CRCTool.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace RoboPioneers::SerialPort
+{
+	static_assert((FrameReceiver::RingCapacity & (FrameReceiver::RingCapacity - 1)) == 0,
+			"FrameReceiver ring capacity must be a power of 2.");
+
+	/// 构造函数
+	FrameReceiver::FrameReceiver(Port *device, FrameFormat format) : Device(device), Format(format)
+	{
+		if (Format.Length <= GetCheckSumSize() || Format.Length > MaxFrameSize)
+		{
+			throw std::invalid_argument("[FrameReceiver::FrameReceiver] Frame Length is Out of Range.");
+		}
+	}
+
+	/// 设置帧回调函数
+	void FrameReceiver::SetCallback(FrameCallback callback)
+	{
+		Callback = std::move(callback);
+	}
+
+	/// 校验码长度
+	std::size_t FrameReceiver::GetCheckSumSize() const noexcept
+	{
+		switch (Format.CheckSum)
+		{
+			case FrameCheckSum::CRC8:
+				return 1;
+			case FrameCheckSum::CRC16:
+				return 2;
+			default:
+				return 0;
+		}
+	}
+
+	/// 校验码初始值，与CRCTool的默认初始值一致
+	std::uint16_t FrameReceiver::GetInitialCheckSum() const noexcept
+	{
+		return Format.CheckSum == FrameCheckSum::CRC8 ? 0xff : 0xffff;
+	}
+
+	/// 将一个字节累计进校验码
+	std::uint16_t FrameReceiver::UpdateCheckSum(std::uint16_t check_sum, unsigned char byte) const noexcept
+	{
+		switch (Format.CheckSum)
+		{
+			case FrameCheckSum::CRC8:
+				return Utilities::CRCTool::GetCRC8CheckSum(&byte, 1, static_cast<unsigned char>(check_sum));
+			case FrameCheckSum::CRC16:
+				return Utilities::CRCTool::GetCRC16CheckSum(&byte, 1, check_sum);
+			default:
+				return 0;
+		}
+	}
+
+	/// 读取候选帧末尾的校验码
+	std::uint16_t FrameReceiver::LoadCheckSum() const noexcept
+	{
+		auto end = CandidateIndex + Format.Length;
+		switch (Format.CheckSum)
+		{
+			case FrameCheckSum::CRC8:
+				return Ring[(end - 1) & (RingCapacity - 1)];
+			case FrameCheckSum::CRC16:
+				return static_cast<std::uint16_t>(Ring[(end - 2) & (RingCapacity - 1)] |
+				                                  (Ring[(end - 1) & (RingCapacity - 1)] << 8));
+			default:
+				return 0;
+		}
+	}
+
+	/// 交出当前候选帧
+	void FrameReceiver::Deliver()
+	{
+		ReceivedFrame frame;
+		frame.Size = Format.Length;
+		for (std::size_t offset = 0; offset < Format.Length; ++offset)
+		{
+			frame.Bytes[offset] = Ring[(CandidateIndex + offset) & (RingCapacity - 1)];
+		}
+
+		FrameCount.fetch_add(1, std::memory_order_relaxed);
+		if (Callback)
+		{
+			Callback(frame.Bytes.data(), frame.Size);
+		}
+		else if (!Frames.TryPush(frame))
+		{
+			DroppedFrameCount.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	/// 运行状态机
+	void FrameReceiver::Process()
+	{
+		auto payload_size = Format.Length - GetCheckSumSize();
+
+		while (ScanIndex < WriteIndex)
+		{
+			auto byte = Ring[ScanIndex & (RingCapacity - 1)];
+
+			if (State == ReceiveState::SeekingHeader)
+			{
+				if (byte == Format.Header)
+				{
+					State = ReceiveState::Collecting;
+					CandidateIndex = ScanIndex;
+					RunningCheckSum = UpdateCheckSum(GetInitialCheckSum(), byte);
+				}
+				else
+				{
+					DiscardedByteCount.fetch_add(1, std::memory_order_relaxed);
+					ReadIndex = ScanIndex + 1;
+				}
+				++ScanIndex;
+				continue;
+			}
+
+			auto offset = ScanIndex - CandidateIndex;
+			if (offset < payload_size)
+			{
+				RunningCheckSum = UpdateCheckSum(RunningCheckSum, byte);
+			}
+			++ScanIndex;
+
+			if (offset + 1 < Format.Length) continue;
+
+			State = ReceiveState::SeekingHeader;
+			if (Format.CheckSum == FrameCheckSum::None || LoadCheckSum() == RunningCheckSum)
+			{
+				Deliver();
+				ReadIndex = ScanIndex;
+			}
+			else
+			{
+				// 候选帧的帧头可能是数据中的伪帧头，从其后一个字节重新寻找帧头
+				CheckSumErrorCount.fetch_add(1, std::memory_order_relaxed);
+				DiscardedByteCount.fetch_add(1, std::memory_order_relaxed);
+				ReadIndex = CandidateIndex + 1;
+				ScanIndex = ReadIndex;
+			}
+		}
+	}
+
+	/// 从串口读取一次数据并处理
+	std::size_t FrameReceiver::Receive()
+	{
+		if (Device == nullptr)
+		{
+			throw std::runtime_error("[FrameReceiver::Receive] Port is Not Bound.");
+		}
+
+		// 未消费的字节不超过一帧，空闲部分总是足够，直接读入环形缓冲区中连续的空闲部分
+		auto position = WriteIndex & (RingCapacity - 1);
+		auto free_size = RingCapacity - (WriteIndex - ReadIndex);
+		auto size = std::min(free_size, RingCapacity - position);
+
+		auto received = Device->ReadTo(Ring.data() + position, size);
+		WriteIndex += received;
+		Process();
+		return received;
+	}
+
+	/// 提供数据并处理
+	void FrameReceiver::Feed(const unsigned char *data, std::size_t size)
+	{
+		while (size > 0)
+		{
+			auto free_size = RingCapacity - (WriteIndex - ReadIndex);
+			auto count = std::min(free_size, size);
+			for (std::size_t index = 0; index < count; ++index)
+			{
+				Ring[(WriteIndex + index) & (RingCapacity - 1)] = data[index];
+			}
+			WriteIndex += count;
+			data += count;
+			size -= count;
+			Process();
+		}
+	}
+
+	/// 重置接收器
+	void FrameReceiver::Reset() noexcept
+	{
+		ReadIndex = WriteIndex;
+		ScanIndex = WriteIndex;
+		State = ReceiveState::SeekingHeader;
+	}
+}
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "Port.hpp"
+#include "SPSCQueue.hpp"
+
+namespace RoboPioneers::SerialPort
+{
+	/// 帧校验方式
+	enum class FrameCheckSum
+	{
+		/// 无校验
+		None,
+		/// 帧末尾1字节的8位CRC校验码
+		CRC8,
+		/// 帧末尾2字节的16位CRC校验码，小端序
+		CRC16
+	};
+
+	/**
+	 * @brief 帧格式
+	 * @details 帧以帧头字节开始，长度固定，校验码位于帧末尾，覆盖其之前的全部字节。
+	 */
+	struct FrameFormat
+	{
+		/// 帧头字节
+		unsigned char Header {0xFF};
+		/// 帧总长度，包含帧头与校验码
+		std::size_t Length {0};
+		/// 校验方式
+		FrameCheckSum CheckSum {FrameCheckSum::CRC8};
+	};
+
+	/**
+	 * @brief 帧接收器
+	 * @author Vincent
+	 * @details
+	 *  ~ 从串口读取的字节存入固定大小的环形缓冲区，由状态机寻找帧头并逐字节累计CRC校验码，接收过程中不分配内存。
+	 *  ~ 校验失败时，从失败帧的帧头之后重新寻找帧头，因此数据中出现的伪帧头不会导致失步。
+	 *  ~ 完整的帧通过回调函数交出；未设置回调函数时，帧进入无锁队列，可由另一个线程取出。
+	 */
+	class FrameReceiver
+	{
+	public:
+		/// 环形缓冲区容量
+		static constexpr std::size_t RingCapacity = 4096;
+		/// 单帧最大长度
+		static constexpr std::size_t MaxFrameSize = 64;
+		/// 帧队列容量
+		static constexpr std::size_t QueueCapacity = 64;
+
+		/// 接收到的帧
+		struct ReceivedFrame
+		{
+			/// 帧字节内容，包含帧头与校验码
+			std::array<unsigned char, MaxFrameSize> Bytes {};
+			/// 帧长度
+			std::size_t Size {0};
+		};
+
+		/// 帧回调函数类型，参数为帧字节内容与长度
+		using FrameCallback = std::function<void(const unsigned char*, std::size_t)>;
+
+	protected:
+		/// 接收状态
+		enum class ReceiveState
+		{
+			/// 寻找帧头
+			SeekingHeader,
+			/// 收集帧内容
+			Collecting
+		};
+
+		/// 读取数据的串口
+		Port* Device;
+		/// 帧格式
+		FrameFormat Format;
+		/// 帧回调函数
+		FrameCallback Callback;
+
+		/// 环形缓冲区
+		std::array<unsigned char, RingCapacity> Ring {};
+		/// 已写入的字节总数
+		std::size_t WriteIndex {0};
+		/// 尚未被消费的第一个字节的位置
+		std::size_t ReadIndex {0};
+		/// 状态机下一个要检查的字节的位置
+		std::size_t ScanIndex {0};
+
+		/// 当前状态
+		ReceiveState State {ReceiveState::SeekingHeader};
+		/// 当前候选帧的帧头位置
+		std::size_t CandidateIndex {0};
+		/// 当前候选帧的累计校验码
+		std::uint16_t RunningCheckSum {0};
+
+		/// 帧队列
+		SPSCQueue<ReceivedFrame, QueueCapacity> Frames;
+
+		/// 校验通过的帧数
+		std::atomic<std::uint64_t> FrameCount {0};
+		/// 校验失败的帧数
+		std::atomic<std::uint64_t> CheckSumErrorCount {0};
+		/// 寻找帧头时丢弃的字节数
+		std::atomic<std::uint64_t> DiscardedByteCount {0};
+		/// 因队列已满而丢弃的帧数
+		std::atomic<std::uint64_t> DroppedFrameCount {0};
+
+		/// 校验码长度
+		[[nodiscard]] std::size_t GetCheckSumSize() const noexcept;
+
+		/// 校验码初始值
+		[[nodiscard]] std::uint16_t GetInitialCheckSum() const noexcept;
+
+		/// 将一个字节累计进校验码
+		[[nodiscard]] std::uint16_t UpdateCheckSum(std::uint16_t check_sum, unsigned char byte) const noexcept;
+
+		/// 读取候选帧末尾的校验码
+		[[nodiscard]] std::uint16_t LoadCheckSum() const noexcept;
+
+		/// 交出当前候选帧
+		void Deliver();
+
+		/// 运行状态机，处理环形缓冲区中尚未检查的字节
+		void Process();
+
+	public:
+		/**
+		 * @brief 构造函数
+		 * @param device 读取数据的串口，可为空指针，此时只能通过Feed提供数据
+		 * @param format 帧格式
+		 */
+		FrameReceiver(Port* device, FrameFormat format);
+
+		/**
+		 * @brief 设置帧回调函数
+		 * @param callback 回调函数，在调用Receive或Feed的线程中执行；为空时帧进入队列
+		 */
+		void SetCallback(FrameCallback callback);
+
+		/**
+		 * @brief 从串口读取一次数据并处理
+		 * @return 读取的字节数
+		 * @details 将阻塞至串口有数据可读，数据直接读入环形缓冲区的空闲部分。
+		 */
+		std::size_t Receive();
+
+		/**
+		 * @brief 提供数据并处理
+		 * @param data 数据指针
+		 * @param size 数据大小
+		 */
+		void Feed(const unsigned char* data, std::size_t size);
+
+		/**
+		 * @brief 从队列中取出一帧，可由另一个线程调用
+		 * @param frame 帧将被写入其中
+		 * @retval true 当取得了一帧
+		 * @retval false 当队列为空
+		 */
+		bool TryPop(ReceivedFrame& frame) noexcept
+		{
+			return Frames.TryPop(frame);
+		}
+
+		/// 清空缓冲区并回到寻找帧头的状态
+		void Reset() noexcept;
+
+		/// 获取校验通过的帧数
+		[[nodiscard]] inline std::uint64_t GetFrameCount() const
+		{
+			return FrameCount.load(std::memory_order_relaxed);
+		}
+
+		/// 获取校验失败的帧数
+		[[nodiscard]] inline std::uint64_t GetCheckSumErrorCount() const
+		{
+			return CheckSumErrorCount.load(std::memory_order_relaxed);
+		}
+
+		/// 获取寻找帧头时丢弃的字节数
+		[[nodiscard]] inline std::uint64_t GetDiscardedByteCount() const
+		{
+			return DiscardedByteCount.load(std::memory_order_relaxed);
+		}
+
+		/// 获取因队列已满而丢弃的帧数
+		[[nodiscard]] inline std::uint64_t GetDroppedFrameCount() const
+		{
+			return DroppedFrameCount.load(std::memory_order_relaxed);
+		}
+	};
+}
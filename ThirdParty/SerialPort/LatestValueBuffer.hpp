@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace RoboPioneers::SerialPort
+{
+	/**
+	 * @brief 最新值缓冲区
+	 * @tparam Value 值类型
+	 * @author Vincent
+	 * @details
+	 *  ~ 以三重缓冲的方式在一个写入线程与一个读取线程之间传递最新值，双方均只有一次原子交换。
+	 *  ~ 读取方取走之前写入的新值会覆盖尚未被取走的旧值。
+	 */
+	template<typename Value>
+	class LatestValueBuffer
+	{
+	protected:
+		/// 缓冲区索引掩码
+		static constexpr std::uint8_t IndexMask = 0x3;
+		/// 中间缓冲区含有新值的标志
+		static constexpr std::uint8_t DirtyFlag = 0x4;
+
+		/// 缓冲区
+		std::array<Value, 3> Buffers {};
+		/// 中间缓冲区的索引与新值标志
+		std::atomic<std::uint8_t> Middle {1};
+		/// 写入方持有的缓冲区索引
+		std::uint8_t Back {0};
+		/// 读取方持有的缓冲区索引
+		std::uint8_t Front {2};
+
+	public:
+		/**
+		 * @brief 写入新值，只能由写入线程调用
+		 * @param value 新值
+		 * @retval true 当覆盖了尚未被取走的旧值
+		 * @retval false 当没有覆盖旧值
+		 */
+		bool Write(const Value& value) noexcept
+		{
+			Buffers[Back] = value;
+			auto previous = Middle.exchange(static_cast<std::uint8_t>(Back | DirtyFlag), std::memory_order_acq_rel);
+			Back = previous & IndexMask;
+			return (previous & DirtyFlag) != 0;
+		}
+
+		/**
+		 * @brief 取走最新值，只能由读取线程调用
+		 * @param value 最新值将被写入其中
+		 * @retval true 当取得了新值
+		 * @retval false 当没有新值
+		 */
+		bool TryTake(Value& value) noexcept
+		{
+			if (!(Middle.load(std::memory_order_relaxed) & DirtyFlag)) return false;
+
+			auto previous = Middle.exchange(Front, std::memory_order_acq_rel);
+			Front = previous & IndexMask;
+			value = Buffers[Front];
+			return true;
+		}
+	};
+}
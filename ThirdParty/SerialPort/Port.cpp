@@ -2,6 +2,10 @@
 
 #include <utility>
 #include <stdexcept>
+#include <cstring>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
 
 namespace RoboPioneers::SerialPort
 {
@@ -13,12 +17,14 @@ namespace RoboPioneers::SerialPort
 			DeviceFileName(std::move(file_name)),
 			BaudRateSetting(baud_rate), CharacterSizeSetting(character_size),
 			FlowControlSetting(flow_control), ParitySetting(parity), StopBitsSetting(stop_bits),
-			Context(), Device(Context)
+			Context(), Device(Context), WakeupEvent(Context), ReadDescriptor(Context)
 	{}
 
 	/// 析构，若设备未关闭则关闭设备
 	Port::~Port()
 	{
+		StopAsyncWriter();
+
 		if (Device.is_open())
 		{
 			Device.close();
@@ -106,6 +112,29 @@ namespace RoboPioneers::SerialPort
 		}
 	}
 
+	/// 获取单个字符的传输时间
+	std::chrono::nanoseconds Port::GetCharacterTime() const noexcept
+	{
+		if (BaudRateSetting == 0) return std::chrono::nanoseconds(0);
+
+		// 以半个比特为单位计数，以便表示1.5个停止位
+		unsigned long long half_bits = 2 * (1 + CharacterSizeSetting);
+		if (ParitySetting != ParityEnum::none) half_bits += 2;
+		switch (StopBitsSetting)
+		{
+			case StopBitsEnum::onepointfive:
+				half_bits += 3;
+				break;
+			case StopBitsEnum::two:
+				half_bits += 4;
+				break;
+			default:
+				half_bits += 2;
+				break;
+		}
+		return std::chrono::nanoseconds(half_bits * 1'000'000'000ULL / (2ULL * BaudRateSetting));
+	}
+
 	/// 写入原始内存
 	void Port::Write(void *pointer, std::size_t size)
 	{
@@ -143,11 +172,34 @@ namespace RoboPioneers::SerialPort
 		}
 	}
 
+	/// 等待串口有数据可读
+	bool Port::WaitForData(std::chrono::milliseconds timeout)
+	{
+		if (!Device.is_open()) return false;
+
+		pollfd descriptor {Device.native_handle(), POLLIN, 0};
+		return ::poll(&descriptor, 1, static_cast<int>(timeout.count())) > 0 && (descriptor.revents & POLLIN);
+	}
+
 	/// 读取文本
 	std::string Port::ReadText(long target_size)
 	{
 		std::string text;
+		ReadText(text, target_size);
+		return text;
+	}
 
+	/// 读取字节
+	std::vector<unsigned char> Port::ReadBytes(long target_size)
+	{
+		std::vector<unsigned char> buffer;
+		ReadBytes(buffer, target_size);
+		return buffer;
+	}
+
+	/// 读取文本到已有的字符串中
+	unsigned long Port::ReadText(std::string &text, long target_size)
+	{
 		unsigned long buffer_size = DefaultBufferSize;
 		if (target_size > 0)
 		{
@@ -155,16 +207,14 @@ namespace RoboPioneers::SerialPort
 		}
 		text.resize(buffer_size);
 
-		text.resize(ReadTo(text.data(), buffer_size, target_size));
-
-		return text;
+		auto size = ReadTo(text.data(), buffer_size, target_size);
+		text.resize(size);
+		return size;
 	}
 
-	/// 读取字节
-	std::vector<unsigned char> Port::ReadBytes(long target_size)
+	/// 读取字节到已有的字节向量中
+	unsigned long Port::ReadBytes(std::vector<unsigned char> &buffer, long target_size)
 	{
-		std::vector<unsigned char> buffer;
-
 		unsigned long buffer_size = DefaultBufferSize;
 		if (target_size > 0)
 		{
@@ -172,8 +222,262 @@ namespace RoboPioneers::SerialPort
 		}
 		buffer.resize(buffer_size);
 
-		buffer.resize(ReadTo(buffer.data(), buffer_size, target_size));
+		auto size = ReadTo(buffer.data(), buffer_size, target_size);
+		buffer.resize(size);
+		return size;
+	}
 
-		return buffer;
+	/// 启动异步写入
+	void Port::StartAsyncWriter(AsyncWriteMode mode)
+	{
+		if (!Device.is_open())
+		{
+			throw std::runtime_error("[Port::StartAsyncWriter] Device is Not Opened.");
+		}
+		if (IOThread.joinable()) return;
+
+		auto event_descriptor = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (event_descriptor < 0)
+		{
+			throw std::runtime_error("[Port::StartAsyncWriter] Failed to Create Wakeup Event.");
+		}
+		WakeupEvent.assign(event_descriptor);
+
+		WriteMode = mode;
+		WriteInProgress = false;
+		WriteAborted = false;
+		WakeupPending.store(false, std::memory_order_relaxed);
+
+		Context.restart();
+		WorkGuard.emplace(boost::asio::make_work_guard(Context));
+		WaitForWakeup();
+
+		std::promise<void> exit_promise;
+		IOThreadExit = exit_promise.get_future();
+		IOThread = std::thread([this, exit_promise = std::move(exit_promise)]() mutable {
+			Context.run();
+			exit_promise.set_value();
+		});
+	}
+
+	/// 停止异步写入
+	void Port::StopAsyncWriter(std::chrono::milliseconds drain_timeout)
+	{
+		if (!IOThread.joinable()) return;
+
+		// 关闭唤醒事件并发送剩余的数据包，释放工作守卫后，上下文将在剩余的写入任务完成后返回
+		boost::asio::post(Context, [this]{
+			boost::system::error_code ignored_error;
+			WakeupEvent.close(ignored_error);
+			CloseReader();
+			if (!WriteInProgress)
+			{
+				StartNextWrite();
+			}
+		});
+		WorkGuard.reset();
+
+		if (IOThreadExit.wait_for(drain_timeout) != std::future_status::ready)
+		{
+			// 写入无法完成，停止上下文后在当前线程中取消未完成的操作，并执行被取消的回调
+			Context.stop();
+			IOThread.join();
+
+			WriteAborted = true;
+			boost::system::error_code ignored_error;
+			WakeupEvent.close(ignored_error);
+			CloseReader();
+			Device.cancel(ignored_error);
+			Context.restart();
+			Context.poll();
+
+			// 丢弃未发送的数据包，避免再次启动时发送过时的数据
+			while (PendingPackets.TryPop(WritingPacket) || LatestPacket.TryTake(WritingPacket))
+			{
+				DroppedPacketCount.fetch_add(1, std::memory_order_relaxed);
+			}
+			return;
+		}
+		IOThread.join();
+	}
+
+	/// 检查异步写入的前置条件并复制数据
+	Port::OutgoingPacket Port::MakeOutgoingPacket(const void *pointer, std::size_t size) const
+	{
+		if (!IOThread.joinable())
+		{
+			throw std::runtime_error("[Port::WriteAsync] Async Writer is Not Started.");
+		}
+		if (size > MaxAsyncPacketSize)
+		{
+			throw std::invalid_argument("[Port::WriteAsync] Packet Size Exceeds MaxAsyncPacketSize.");
+		}
+
+		OutgoingPacket packet;
+		std::memcpy(packet.Bytes.data(), pointer, size);
+		packet.Size = size;
+		return packet;
+	}
+
+	/// 唤醒输入输出线程
+	void Port::Wakeup()
+	{
+		// 仅在没有待处理的唤醒信号时写入eventfd，避免每个数据包都进行一次系统调用
+		if (!WakeupPending.exchange(true, std::memory_order_acq_rel))
+		{
+			::eventfd_write(WakeupEvent.native_handle(), 1);
+		}
+	}
+
+	/// 等待唤醒事件
+	void Port::WaitForWakeup()
+	{
+		// 回调在输入输出线程中完成后才再次等待，asio会复用该线程缓存的回调内存
+		WakeupEvent.async_wait(boost::asio::posix::stream_descriptor::wait_read,
+		                       [this](const boost::system::error_code& error){
+			if (error) return;
+
+			eventfd_t count;
+			::eventfd_read(WakeupEvent.native_handle(), &count);
+			HandleWakeup();
+			WaitForWakeup();
+		});
+	}
+
+	/// 异步写入原始内存
+	bool Port::WriteAsync(const void *pointer, std::size_t size)
+	{
+		if (WriteMode != AsyncWriteMode::Coalescing)
+		{
+			return WriteAsyncQueued(pointer, size);
+		}
+
+		if (LatestPacket.Write(MakeOutgoingPacket(pointer, size)))
+		{
+			CoalescedPacketCount.fetch_add(1, std::memory_order_relaxed);
+		}
+		Wakeup();
+		return true;
+	}
+
+	/// 异步写入不可合并的数据
+	bool Port::WriteAsyncQueued(const void *pointer, std::size_t size)
+	{
+		if (!PendingPackets.TryPush(MakeOutgoingPacket(pointer, size)))
+		{
+			DroppedPacketCount.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		Wakeup();
+		return true;
+	}
+
+	/// 处理唤醒事件
+	void Port::HandleWakeup()
+	{
+		// 先清除标志再取数据包，此后提交的数据包必然会发出新的唤醒信号
+		WakeupPending.store(false, std::memory_order_release);
+		if (!WriteInProgress)
+		{
+			StartNextWrite();
+		}
+	}
+
+	/// 取出下一个数据包并开始发送
+	void Port::StartNextWrite()
+	{
+		if (WriteAborted)
+		{
+			WriteInProgress = false;
+			return;
+		}
+
+		// 队列中的数据包优先，合并模式下再取最新数据包
+		bool has_packet = PendingPackets.TryPop(WritingPacket) ||
+				(WriteMode == AsyncWriteMode::Coalescing && LatestPacket.TryTake(WritingPacket));
+		if (!has_packet)
+		{
+			WriteInProgress = false;
+			return;
+		}
+
+		WriteInProgress = true;
+		boost::asio::async_write(Device, boost::asio::buffer(WritingPacket.Bytes.data(), WritingPacket.Size),
+		                         [this](const boost::system::error_code& error, std::size_t){
+			if (error)
+			{
+				FailedPacketCount.fetch_add(1, std::memory_order_relaxed);
+			}
+			else
+			{
+				WrittenPacketCount.fetch_add(1, std::memory_order_relaxed);
+			}
+			StartNextWrite();
+		});
+	}
+
+	/// 启动异步读取
+	void Port::StartAsyncReader(DataCallback callback)
+	{
+		if (!IOThread.joinable())
+		{
+			throw std::runtime_error("[Port::StartAsyncReader] Async Writer is Not Started.");
+		}
+		if (ReadDescriptor.is_open()) return;
+
+		auto read_descriptor = ::dup(Device.native_handle());
+		if (read_descriptor < 0)
+		{
+			throw std::runtime_error("[Port::StartAsyncReader] Failed to Duplicate Device Descriptor.");
+		}
+		ReadDescriptor.assign(read_descriptor);
+
+		// 回调函数的设置与首次读取均在输入输出线程中进行
+		boost::asio::post(Context, [this, callback = std::move(callback)]() mutable {
+			ReadCallback = std::move(callback);
+			ReadActive = true;
+			StartNextRead();
+		});
+	}
+
+	/// 停止异步读取
+	void Port::StopAsyncReader()
+	{
+		if (!ReadDescriptor.is_open()) return;
+		if (!IOThread.joinable())
+		{
+			CloseReader();
+			return;
+		}
+
+		// 在输入输出线程中关闭，返回时已不在回调之中，此后也不会再有回调
+		std::promise<void> closed_promise;
+		auto closed = closed_promise.get_future();
+		boost::asio::post(Context, [this, &closed_promise]{
+			CloseReader();
+			closed_promise.set_value();
+		});
+		closed.wait();
+	}
+
+	/// 开始下一次读取
+	void Port::StartNextRead()
+	{
+		ReadDescriptor.async_read_some(boost::asio::buffer(ReadBuffer),
+		                               [this](const boost::system::error_code& error, std::size_t size){
+			// 读取可能在关闭之前已经完成并排队，此时同样不再回调
+			if (error || !ReadActive) return;
+
+			ReadCallback(ReadBuffer.data(), size);
+			StartNextRead();
+		});
+	}
+
+	/// 关闭读取描述符并停止回调
+	void Port::CloseReader()
+	{
+		ReadActive = false;
+		boost::system::error_code ignored_error;
+		ReadDescriptor.close(ignored_error);
 	}
-}
\ No newline at end of file
+}
@@ -3,6 +3,17 @@
 #include <string>
 #include <boost/asio.hpp>
 #include <vector>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <optional>
+#include <thread>
+#include <type_traits>
+
+#include "SPSCQueue.hpp"
+#include "LatestValueBuffer.hpp"
 
 namespace RoboPioneers::SerialPort
 {
@@ -22,6 +33,23 @@ namespace RoboPioneers::SerialPort
 		/// 停止位类型
 		using StopBitsEnum = boost::asio::serial_port::stop_bits;
 
+		/// 异步写入模式
+		enum class AsyncWriteMode
+		{
+			/// 按顺序发送所有数据包，队列满时丢弃新数据包
+			Queued,
+			/// 只发送最新的数据包，尚未发送的旧数据包将被新数据包替换
+			Coalescing
+		};
+
+		/// 异步读取的数据回调函数类型
+		using DataCallback = std::function<void(const unsigned char*, std::size_t)>;
+
+		/// 异步写入的单个数据包的最大字节数
+		static constexpr std::size_t MaxAsyncPacketSize = 64;
+		/// 异步写入队列的容量
+		static constexpr std::size_t AsyncQueueCapacity = 64;
+
 	private:
 		//==============================
 		// 设定部分
@@ -77,6 +105,88 @@ namespace RoboPioneers::SerialPort
 		/// 串口设备对象
 		boost::asio::serial_port Device;
 
+		//==============================
+		// 异步写入部分
+		//==============================
+
+		/// 待发送的数据包
+		struct OutgoingPacket
+		{
+			/// 字节内容
+			std::array<unsigned char, MaxAsyncPacketSize> Bytes {};
+			/// 有效字节数
+			std::size_t Size {0};
+		};
+
+		/// 异步写入模式
+		AsyncWriteMode WriteMode {AsyncWriteMode::Queued};
+		/// 待发送队列，由调用线程写入，由输入输出线程读取，优先于最新数据包发送
+		SPSCQueue<OutgoingPacket, AsyncQueueCapacity> PendingPackets;
+		/// 合并模式下的最新数据包
+		LatestValueBuffer<OutgoingPacket> LatestPacket;
+		/// 正在发送的数据包，仅由输入输出线程访问
+		OutgoingPacket WritingPacket;
+		/// 是否正在发送，仅由输入输出线程访问
+		bool WriteInProgress {false};
+		/// 是否已经发出了唤醒信号且尚未被处理
+		std::atomic_bool WakeupPending {false};
+		/// 唤醒事件，调用线程通过eventfd计数唤醒输入输出线程，不经过上下文的任务队列
+		boost::asio::posix::stream_descriptor WakeupEvent;
+		/// 是否已中止发送，中止后不再开始新的写入，仅由运行上下文的线程访问
+		bool WriteAborted {false};
+		/// 保持上下文运行的工作守卫
+		std::optional<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> WorkGuard;
+		/// 输入输出线程
+		std::thread IOThread;
+		/// 输入输出线程的上下文返回时就绪
+		std::future<void> IOThreadExit;
+
+		//==============================
+		// 异步读取部分
+		//==============================
+
+		/// 异步读取缓冲区大小
+		static constexpr std::size_t AsyncReadBufferSize = 256;
+
+		/// 读取描述符，复制自串口的文件描述符，取消读取时不影响串口上未完成的写入
+		boost::asio::posix::stream_descriptor ReadDescriptor;
+		/// 异步读取缓冲区，仅由输入输出线程访问
+		std::array<unsigned char, AsyncReadBufferSize> ReadBuffer {};
+		/// 异步读取的数据回调函数，仅由输入输出线程访问
+		DataCallback ReadCallback;
+		/// 是否正在异步读取，仅由输入输出线程访问
+		bool ReadActive {false};
+
+		/// 已发送的数据包数
+		std::atomic<std::uint64_t> WrittenPacketCount {0};
+		/// 因队列已满而丢弃的数据包数
+		std::atomic<std::uint64_t> DroppedPacketCount {0};
+		/// 因合并而被替换的数据包数
+		std::atomic<std::uint64_t> CoalescedPacketCount {0};
+		/// 发送失败的数据包数
+		std::atomic<std::uint64_t> FailedPacketCount {0};
+
+		/// 检查异步写入的前置条件并将数据复制为待发送的数据包
+		OutgoingPacket MakeOutgoingPacket(const void* pointer, std::size_t size) const;
+
+		/// 唤醒输入输出线程
+		void Wakeup();
+
+		/// 等待唤醒事件，在输入输出线程中执行
+		void WaitForWakeup();
+
+		/// 处理唤醒事件，在输入输出线程中执行
+		void HandleWakeup();
+
+		/// 取出下一个数据包并开始发送，在输入输出线程中执行
+		void StartNextWrite();
+
+		/// 开始下一次读取，在输入输出线程中执行
+		void StartNextRead();
+
+		/// 关闭读取描述符并停止回调，在运行上下文的线程中执行
+		void CloseReader();
+
 	public:
 		//==============================
 		// 构造与析构部分
@@ -140,6 +250,12 @@ namespace RoboPioneers::SerialPort
 		/// 设置停止位类型
 		virtual void SetStopBitsType(StopBitsEnum::type stop_bits);
 
+		/**
+		 * @brief 获取单个字符在线路上的传输时间
+		 * @return 起始位、数据位、校验位与停止位的总传输时间，由当前的波特率、字符大小、奇偶校验与停止位设定计算
+		 */
+		[[nodiscard]] std::chrono::nanoseconds GetCharacterTime() const noexcept;
+
 		//==============================
 		// 读写部分
 		//==============================
@@ -180,6 +296,119 @@ namespace RoboPioneers::SerialPort
 			Write(static_cast<void*>(&target), sizeof(Type));
 		}
 
+		//==============================
+		// 异步写入部分
+		//==============================
+
+		/**
+		 * @brief 启动异步写入
+		 * @param mode 异步写入模式
+		 * @details
+		 *  ~ 将启动独立的输入输出线程，由该线程使用async_write向串口写入数据，调用线程不再阻塞于串口传输。
+		 *  ~ 启动后不应再混用同步的Write方法，否则两者写入的字节可能交错。
+		 */
+		void StartAsyncWriter(AsyncWriteMode mode = AsyncWriteMode::Queued);
+
+		/**
+		 * @brief 停止异步写入
+		 * @param drain_timeout 等待已提交的数据包发送完毕的时间上限
+		 * @details
+		 *  ~ 先等待已提交的数据包发送完毕；
+		 *    若超时仍未完成，如流控阻塞或串口被拔出，则停止上下文并取消串口上未完成的写入，剩余的数据包不再发送。
+		 *  ~ 无论串口状态如何，该方法都会在约drain_timeout之后返回。
+		 */
+		void StopAsyncWriter(std::chrono::milliseconds drain_timeout = std::chrono::milliseconds(100));
+
+		/**
+		 * @brief 异步写入是否已经启动
+		 * @retval true 异步写入已启动
+		 * @retval false 异步写入未启动
+		 */
+		[[nodiscard]] inline bool IsAsyncWriterRunning() const
+		{
+			return IOThread.joinable();
+		}
+
+		/**
+		 * @brief 异步写入内存中的数据
+		 * @param pointer 指针
+		 * @param size 大小，不得超过MaxAsyncPacketSize
+		 * @retval true 数据包已提交
+		 * @retval false 顺序模式下队列已满，数据包被丢弃
+		 * @details
+		 *  ~ 数据将被复制到预先分配的缓冲区中，并通过eventfd唤醒输入输出线程，
+		 *    不向上下文投递任务，因此该方法不会分配内存，也不会等待串口传输。
+		 *  ~ 只允许一个线程调用该方法。
+		 */
+		bool WriteAsync(const void* pointer, std::size_t size);
+
+		/**
+		 * @brief 异步写入不可合并的数据
+		 * @param pointer 指针
+		 * @param size 大小，不得超过MaxAsyncPacketSize
+		 * @retval true 数据包已提交
+		 * @retval false 队列已满，数据包被丢弃
+		 * @details
+		 *  ~ 无论异步写入模式如何，数据包均进入待发送队列，按顺序发送且不会被替换，适用于时间同步等控制数据包。
+		 *  ~ 只允许一个线程调用该方法；合并模式下，该线程可以与调用WriteAsync的线程不同，
+		 *    顺序模式下两者共用队列，必须为同一线程。
+		 */
+		bool WriteAsyncQueued(const void* pointer, std::size_t size);
+
+		/**
+		 * @brief 异步写入某个对象的数据
+		 * @tparam Type 类型，必须可平凡复制
+		 * @param target 目标对象
+		 * @return 数据包是否已提交
+		 */
+		template<typename Type>
+		bool WriteAsync(const Type& target)
+		{
+			static_assert(std::is_trivially_copyable_v<Type>, "WriteAsync requires a trivially copyable type.");
+			return WriteAsync(static_cast<const void*>(&target), sizeof(Type));
+		}
+
+		/**
+		 * @brief 启动异步读取
+		 * @param callback 数据回调函数，在输入输出线程中执行，不得阻塞
+		 * @details
+		 *  ~ 需要已启动异步写入；读取与写入在同一个输入输出线程中以async_read_some与async_write进行，
+		 *    不会有两个线程同时操作串口。
+		 *  ~ 启动后不应再从其他线程调用同步的读取方法。
+		 *  ~ 回调之后的下一次读取由输入输出线程发起，asio会复用该线程缓存的回调内存，稳态下读取不分配内存。
+		 */
+		void StartAsyncReader(DataCallback callback);
+
+		/**
+		 * @brief 停止异步读取
+		 * @details 返回后回调函数不会再被调用；停止异步写入时也将一并停止异步读取。
+		 */
+		void StopAsyncReader();
+
+		/// 获取已发送的数据包数
+		[[nodiscard]] inline std::uint64_t GetWrittenPacketCount() const
+		{
+			return WrittenPacketCount.load(std::memory_order_relaxed);
+		}
+
+		/// 获取因队列已满而丢弃的数据包数
+		[[nodiscard]] inline std::uint64_t GetDroppedPacketCount() const
+		{
+			return DroppedPacketCount.load(std::memory_order_relaxed);
+		}
+
+		/// 获取因合并而被替换的数据包数
+		[[nodiscard]] inline std::uint64_t GetCoalescedPacketCount() const
+		{
+			return CoalescedPacketCount.load(std::memory_order_relaxed);
+		}
+
+		/// 获取发送失败的数据包数
+		[[nodiscard]] inline std::uint64_t GetFailedPacketCount() const
+		{
+			return FailedPacketCount.load(std::memory_order_relaxed);
+		}
+
 		/**
 		 * @brief 读取字节码
 		 * @param target_size 若为正数，读取到指定字节数后返回；若为负数，则不设定目标字节数，缓存区大小为DefaultBufferSize的值
@@ -194,6 +423,31 @@ namespace RoboPioneers::SerialPort
 		 */
 		std::string ReadText(long target_size = -1);
 
+		/**
+		 * @brief 读取字节码到已有的字节向量中
+		 * @param buffer 字节向量，容量足够时不会重新分配内存，返回时其大小为读取的字节数
+		 * @param target_size 若为正数，读取到指定字节数后返回；若为负数，则不设定目标字节数，缓存区大小为DefaultBufferSize的值
+		 * @return 读取的字节数
+		 */
+		unsigned long ReadBytes(std::vector<unsigned char>& buffer, long target_size = -1);
+
+		/**
+		 * @brief 读取文本到已有的字符串中
+		 * @param text 字符串，容量足够时不会重新分配内存，返回时其大小为读取的字节数
+		 * @param target_size 若为正数，读取到指定字节数后返回；若为负数，则不设定目标字节数，缓存区大小为DefaultBufferSize的值
+		 * @return 读取的字节数
+		 */
+		unsigned long ReadText(std::string& text, long target_size = -1);
+
+		/**
+		 * @brief 等待串口有数据可读
+		 * @param timeout 超时时间
+		 * @retval true 串口有数据可读
+		 * @retval false 超时或串口未开启
+		 * @details 可与读取方法配合使用，使读取线程能够定期检查退出条件，而不是无限期阻塞。
+		 */
+		bool WaitForData(std::chrono::milliseconds timeout);
+
 		/**
 		 * @brief 读取数据到指定的地址
 		 * @param buffer 地址
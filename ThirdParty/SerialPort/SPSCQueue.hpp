@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace RoboPioneers::SerialPort
+{
+	/**
+	 * @brief 单生产者单消费者无锁队列
+	 * @tparam Element 元素类型
+	 * @tparam Capacity 容量，必须为2的幂
+	 * @author Vincent
+	 * @details
+	 *  ~ 元素存储在固定大小的数组中，入队与出队均不分配内存，也不加锁。
+	 *  ~ 只允许一个线程入队、一个线程出队。
+	 */
+	template<typename Element, std::size_t Capacity>
+	class SPSCQueue
+	{
+		static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SPSCQueue capacity must be a power of 2.");
+
+	protected:
+		/// 缓存行大小，用于隔离生产者与消费者的索引
+		static constexpr std::size_t CacheLineSize = 64;
+
+		/// 元素数组
+		std::array<Element, Capacity> Elements {};
+		/// 下一个入队位置，由生产者写入
+		alignas(CacheLineSize) std::atomic<std::size_t> Tail {0};
+		/// 下一个出队位置，由消费者写入
+		alignas(CacheLineSize) std::atomic<std::size_t> Head {0};
+
+	public:
+		/**
+		 * @brief 尝试入队，只能由生产者调用
+		 * @param element 元素
+		 * @retval true 当入队成功
+		 * @retval false 当队列已满
+		 */
+		bool TryPush(const Element& element) noexcept
+		{
+			auto tail = Tail.load(std::memory_order_relaxed);
+			if (tail - Head.load(std::memory_order_acquire) >= Capacity) return false;
+
+			Elements[tail & (Capacity - 1)] = element;
+			Tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief 尝试出队，只能由消费者调用
+		 * @param element 出队的元素将被写入其中
+		 * @retval true 当出队成功
+		 * @retval false 当队列为空
+		 */
+		bool TryPop(Element& element) noexcept
+		{
+			auto head = Head.load(std::memory_order_relaxed);
+			if (head == Tail.load(std::memory_order_acquire)) return false;
+
+			element = Elements[head & (Capacity - 1)];
+			Head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		/// 队列是否为空，结果仅为调用时刻的近似值
+		[[nodiscard]] bool IsEmpty() const noexcept
+		{
+			return Head.load(std::memory_order_acquire) == Tail.load(std::memory_order_acquire);
+		}
+	};
+}
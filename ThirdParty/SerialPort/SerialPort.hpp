@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Port.hpp"
+#include "FrameReceiver.hpp"
 
 namespace RoboPioneers::SerialPort
 {
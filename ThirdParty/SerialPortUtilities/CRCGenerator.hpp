@@ -0,0 +1,242 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace RoboPioneers::SerialPort::Utilities
+{
+	/// CRC模型的编译期工具，在模型类之外定义，以便在类内的常量初始化中使用
+	namespace Detail
+	{
+		/// 右移若干字节，移出位宽时结果为零
+		template<typename Value, std::size_t Width>
+		constexpr Value ShiftRightBytes(Value value, std::size_t bytes)
+		{
+			return bytes * 8 >= Width ? Value(0) : static_cast<Value>(value >> (bytes * 8));
+		}
+
+		/// 反转低Width位的顺序
+		template<typename Value, std::size_t Width>
+		constexpr Value ReflectBits(Value value)
+		{
+			Value result = 0;
+			for (std::size_t bit = 0; bit < Width; ++bit)
+			{
+				if (value & (Value(1) << bit))
+				{
+					result |= Value(1) << (Width - 1 - bit);
+				}
+			}
+			return result;
+		}
+
+		/// 生成切片查找表
+		template<typename Value, std::size_t Width, Value Polynomial, bool Reflected, std::size_t SliceCount>
+		constexpr std::array<std::array<Value, 256>, SliceCount> GenerateCRCTables()
+		{
+			constexpr Value mask = Width == sizeof(Value) * 8 ?
+					static_cast<Value>(~Value(0)) : static_cast<Value>((Value(1) << (Width % (sizeof(Value) * 8))) - 1);
+			std::array<std::array<Value, 256>, SliceCount> tables {};
+
+			for (std::size_t byte = 0; byte < 256; ++byte)
+			{
+				Value remainder = 0;
+				if constexpr (Reflected)
+				{
+					constexpr Value reflected_polynomial = ReflectBits<Value, Width>(Polynomial);
+					remainder = static_cast<Value>(byte);
+					for (int bit = 0; bit < 8; ++bit)
+					{
+						remainder = (remainder & 1) ? static_cast<Value>((remainder >> 1) ^ reflected_polynomial)
+						                            : static_cast<Value>(remainder >> 1);
+					}
+				}
+				else
+				{
+					constexpr Value top_bit = Value(1) << (Width - 1);
+					remainder = static_cast<Value>(static_cast<Value>(byte) << (Width - 8));
+					for (int bit = 0; bit < 8; ++bit)
+					{
+						remainder = (remainder & top_bit) ? static_cast<Value>((remainder << 1) ^ Polynomial)
+						                                  : static_cast<Value>(remainder << 1);
+					}
+				}
+				tables[0][byte] = static_cast<Value>(remainder & mask);
+			}
+
+			// 第k张表为第k-1张表的结果再经过一个零字节
+			for (std::size_t slice = 1; slice < SliceCount; ++slice)
+			{
+				for (std::size_t byte = 0; byte < 256; ++byte)
+				{
+					auto previous = tables[slice - 1][byte];
+					if constexpr (Reflected)
+					{
+						tables[slice][byte] = static_cast<Value>(ShiftRightBytes<Value, Width>(previous, 1) ^
+								tables[0][previous & 0xFF]);
+					}
+					else
+					{
+						tables[slice][byte] = static_cast<Value>(((previous << 8) & mask) ^
+								tables[0][(previous >> (Width - 8)) & 0xFF]);
+					}
+				}
+			}
+			return tables;
+		}
+	}
+
+	/**
+	 * @brief CRC模型
+	 * @tparam Value 校验码的存储类型，位宽不小于Width
+	 * @tparam Width 校验码位宽，须为8的倍数
+	 * @tparam Polynomial 生成多项式，按照常规（非反射）形式给出，不含最高位
+	 * @tparam Initial 寄存器初值
+	 * @tparam Reflected 是否为反射（低位先行）算法
+	 * @tparam FinalXor 输出时异或的值
+	 * @author Vincent
+	 * @details
+	 *  ~ 查找表在编译期生成，共SliceCount张：第0张为逐字节算法所用的表，
+	 *    第k张为一个字节之后再跟随k个零字节时的余数，供按切片并行查表的算法使用。
+	 *  ~ Update系列方法只更新寄存器，不做最终异或，多段数据可以依次更新；Calculate对整段数据给出最终结果。
+	 *  ~ 切片算法仅对反射算法实现，非反射算法回退至逐字节算法。
+	 */
+	template<typename Value, std::size_t Width, Value Polynomial, Value Initial, bool Reflected, Value FinalXor = 0>
+	struct CRCModel
+	{
+		static_assert(std::is_unsigned_v<Value>, "CRC value type must be unsigned.");
+		static_assert(Width % 8 == 0 && Width >= 8 && Width <= sizeof(Value) * 8, "Unsupported CRC width.");
+
+		/// 校验码类型
+		using ValueType = Value;
+		/// 查找表数量，即最大切片字节数
+		static constexpr std::size_t SliceCount = 8;
+		/// 查找表类型
+		using TableType = std::array<std::array<Value, 256>, SliceCount>;
+
+		/// 校验码位宽
+		static constexpr std::size_t BitWidth = Width;
+		/// 寄存器初值
+		static constexpr Value InitialValue = Initial;
+		/// 输出时异或的值
+		static constexpr Value FinalXorValue = FinalXor;
+		/// 是否为反射算法
+		static constexpr bool IsReflected = Reflected;
+
+		/// 位宽掩码
+		static constexpr Value Mask = Width == sizeof(Value) * 8 ?
+				static_cast<Value>(~Value(0)) : static_cast<Value>((Value(1) << (Width % (sizeof(Value) * 8))) - 1);
+
+	private:
+		/// 右移若干字节，移出位宽时结果为零
+		static constexpr Value ShiftRight(Value value, std::size_t bytes = 1)
+		{
+			return Detail::ShiftRightBytes<Value, Width>(value, bytes);
+		}
+
+	public:
+		/// 查找表
+		static constexpr TableType Tables = Detail::GenerateCRCTables<Value, Width, Polynomial, Reflected, SliceCount>();
+
+		/**
+		 * @brief 逐字节更新寄存器
+		 * @param crc 寄存器当前值
+		 * @param data 数据指针
+		 * @param length 数据长度
+		 * @return 寄存器新值
+		 */
+		static constexpr Value UpdateBytewise(Value crc, const unsigned char* data, std::size_t length) noexcept
+		{
+			for (std::size_t index = 0; index < length; ++index)
+			{
+				if constexpr (Reflected)
+				{
+					crc = static_cast<Value>(ShiftRight(crc) ^ Tables[0][(crc ^ data[index]) & 0xFF]);
+				}
+				else
+				{
+					crc = static_cast<Value>(((crc << 8) & Mask) ^
+							Tables[0][((crc >> (Width - 8)) ^ data[index]) & 0xFF]);
+				}
+			}
+			return crc;
+		}
+
+		/**
+		 * @brief 按切片更新寄存器
+		 * @tparam Slices 每次处理的字节数，为4或8
+		 * @param crc 寄存器当前值
+		 * @param data 数据指针
+		 * @param length 数据长度
+		 * @return 寄存器新值
+		 * @details
+		 *  ~ 每次将Slices个字节分别查表后异或，表之间没有数据依赖，可以充分利用处理器的指令并行。
+		 *  ~ 不足Slices的尾部字节逐字节处理。
+		 */
+		template<std::size_t Slices>
+		static constexpr Value UpdateSliced(Value crc, const unsigned char* data, std::size_t length) noexcept
+		{
+			static_assert(Slices >= 1 && Slices <= SliceCount, "Unsupported slice count.");
+
+			if constexpr (!Reflected)
+			{
+				return UpdateBytewise(crc, data, length);
+			}
+			else
+			{
+				constexpr std::size_t register_bytes = Width / 8;
+				while (length >= Slices)
+				{
+					Value next = ShiftRight(crc, Slices);
+					for (std::size_t index = 0; index < Slices; ++index)
+					{
+						auto byte = data[index];
+						if (index < register_bytes)
+						{
+							byte = static_cast<unsigned char>(byte ^ ((crc >> (index * 8)) & 0xFF));
+						}
+						next = static_cast<Value>(next ^ Tables[Slices - 1 - index][byte]);
+					}
+					crc = next;
+					data += Slices;
+					length -= Slices;
+				}
+				return UpdateBytewise(crc, data, length);
+			}
+		}
+
+		/**
+		 * @brief 更新寄存器，自动选择算法
+		 * @param crc 寄存器当前值
+		 * @param data 数据指针
+		 * @param length 数据长度
+		 * @return 寄存器新值
+		 */
+		static constexpr Value Update(Value crc, const unsigned char* data, std::size_t length) noexcept
+		{
+			return length >= 16 ? UpdateSliced<8>(crc, data, length) : UpdateBytewise(crc, data, length);
+		}
+
+		/**
+		 * @brief 计算整段数据的校验码
+		 * @param data 数据指针
+		 * @param length 数据长度
+		 * @return 经过最终异或的校验码
+		 */
+		static constexpr Value Calculate(const unsigned char* data, std::size_t length) noexcept
+		{
+			return static_cast<Value>(Update(Initial, data, length) ^ FinalXor);
+		}
+	};
+
+	/// 8位CRC，多项式0x31，反射，初值0xFF，与CRCTool的8位校验一致
+	using CRC8Model = CRCModel<std::uint8_t, 8, 0x31, 0xFF, true>;
+	/// 16位CRC，多项式0x1021，反射，初值0xFFFF，与CRCTool的16位校验一致
+	using CRC16Model = CRCModel<std::uint16_t, 16, 0x1021, 0xFFFF, true>;
+	/// 32位CRC（IEEE 802.3）
+	using CRC32Model = CRCModel<std::uint32_t, 32, 0x04C11DB7, 0xFFFFFFFF, true, 0xFFFFFFFF>;
+	/// 32位CRC（Castagnoli），部分处理器提供硬件指令
+	using CRC32CModel = CRCModel<std::uint32_t, 32, 0x1EDC6F41, 0xFFFFFFFF, true, 0xFFFFFFFF>;
+}
@@ -1,9 +1,19 @@
 #include "CRCTool.hpp"
+#include "CRCGenerator.hpp"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <nmmintrin.h>
+#elif defined(__aarch64__) && defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
 
 namespace RoboPioneers::SerialPort::Utilities
 {
-	/// 该工具所使用的8位校验表
-	std::array<unsigned char, 256> CRCTool::CRC8Table {
+	/// 原有的手工录入的8位校验表，仅用于核验编译期生成的表
+	static constexpr std::array<unsigned char, 256> ReferenceCRC8Table {
 			0x00, 0x5e, 0xbc, 0xe2, 0x61, 0x3f, 0xdd, 0x83, 0xc2, 0x9c, 0x7e, 0x20, 0xa3, 0xfd, 0x1f, 0x41,
 			0x9d, 0xc3, 0x21, 0x7f, 0xfc, 0xa2, 0x40, 0x1e, 0x5f, 0x01, 0xe3, 0xbd, 0x3e, 0x60, 0x82, 0xdc,
 			0x23, 0x7d, 0x9f, 0xc1, 0x42, 0x1c, 0xfe, 0xa0, 0xe1, 0xbf, 0x5d, 0x03, 0x80, 0xde, 0x3c, 0x62,
@@ -22,8 +32,8 @@ namespace RoboPioneers::SerialPort::Utilities
 			0x74, 0x2a, 0xc8, 0x96, 0x15, 0x4b, 0xa9, 0xf7, 0xb6, 0xe8, 0x0a, 0x54, 0xd7, 0x89, 0x6b, 0x35
 	};
 
-	/// 该工具所使用的16位校验表
-	std::array<unsigned short, 256> CRCTool::CRC16Table {
+	/// 原有的手工录入的16位校验表，仅用于核验编译期生成的表
+	static constexpr std::array<unsigned short, 256> ReferenceCRC16Table {
 			0x0000, 0x1189, 0x2312, 0x329b, 0x4624, 0x57ad, 0x6536, 0x74bf,
 			0x8c48, 0x9dc1, 0xaf5a, 0xbed3, 0xca6c, 0xdbe5, 0xe97e, 0xf8f7,
 			0x1081, 0x0108, 0x3393, 0x221a, 0x56a5, 0x472c, 0x75b7, 0x643e,
@@ -58,28 +68,138 @@ namespace RoboPioneers::SerialPort::Utilities
 			0x7bc7, 0x6a4e, 0x58d5, 0x495c, 0x3de3, 0x2c6a, 0x1ef1, 0x0f78
 	};
 
-	/// 获取8位冗余校验和
-	unsigned char CRCTool::GetCRC8CheckSum(unsigned char *data, unsigned int length, unsigned char initializer)
+	/// 判断两张校验表是否逐项相等
+	template<typename Generated, typename Reference>
+	static constexpr bool IsSameTable(const Generated& generated, const Reference& reference)
 	{
-		unsigned char index;
-		while (length--)
+		for (std::size_t index = 0; index < reference.size(); ++index)
 		{
-			index = initializer ^ (*data++);
-			initializer  = CRC8Table[index];
+			if (generated[index] != reference[index]) return false;
 		}
-		return initializer;
+		return true;
+	}
+
+	static_assert(IsSameTable(CRC8Model::Tables[0], ReferenceCRC8Table),
+			"Generated CRC8 table does not match the reference table.");
+	static_assert(IsSameTable(CRC16Model::Tables[0], ReferenceCRC16Table),
+			"Generated CRC16 table does not match the reference table.");
+
+	/// 该工具所使用的8位校验表
+	std::array<unsigned char, 256> CRCTool::CRC8Table = CRC8Model::Tables[0];
+
+	/// 该工具所使用的16位校验表
+	std::array<unsigned short, 256> CRCTool::CRC16Table = CRC16Model::Tables[0];
+
+	/// 获取8位冗余校验和
+	unsigned char CRCTool::GetCRC8CheckSum(unsigned char *data, unsigned int length, unsigned char initializer)
+	{
+		return CRC8Model::Update(initializer, data, length);
 	}
 
 	/// 获取16位冗余校验和
 	unsigned short CRCTool::GetCRC16CheckSum(unsigned char *data, unsigned int length, unsigned short initializer)
 	{
-		unsigned char index;
-		while (length--)
+		return CRC16Model::Update(initializer, data, length);
+	}
+
+	//==============================
+	// 硬件CRC32C部分
+	//==============================
+
+	#if defined(__x86_64__) || defined(__i386__)
+
+	/// 使用SSE4.2指令计算CRC32C
+	__attribute__((target("sse4.2")))
+	static std::uint32_t UpdateCRC32CHardware(std::uint32_t crc, const unsigned char* data, std::size_t length)
+	{
+		#if defined(__x86_64__)
+		while (length >= 8)
+		{
+			std::uint64_t value;
+			std::memcpy(&value, data, sizeof(value));
+			crc = static_cast<std::uint32_t>(_mm_crc32_u64(crc, value));
+			data += 8;
+			length -= 8;
+		}
+		#endif
+		while (length > 0)
+		{
+			crc = _mm_crc32_u8(crc, *data++);
+			--length;
+		}
+		return crc;
+	}
+
+	/// 检测处理器是否支持SSE4.2
+	static bool DetectCRC32CHardware()
+	{
+		return __builtin_cpu_supports("sse4.2");
+	}
+
+	#elif defined(__aarch64__) && defined(__linux__) && defined(__GNUC__) && !defined(__clang__)
+
+	/// 使用ARMv8 CRC扩展指令计算CRC32C
+	__attribute__((target("+crc")))
+	static std::uint32_t UpdateCRC32CHardware(std::uint32_t crc, const unsigned char* data, std::size_t length)
+	{
+		while (length >= 8)
+		{
+			std::uint64_t value;
+			std::memcpy(&value, data, sizeof(value));
+			crc = __builtin_aarch64_crc32cx(crc, value);
+			data += 8;
+			length -= 8;
+		}
+		while (length > 0)
+		{
+			crc = __builtin_aarch64_crc32cb(crc, *data++);
+			--length;
+		}
+		return crc;
+	}
+
+	/// 检测处理器是否支持CRC扩展
+	static bool DetectCRC32CHardware()
+	{
+		return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+	}
+
+	#else
+
+	/// 不支持硬件CRC32C的平台使用软件实现
+	static std::uint32_t UpdateCRC32CHardware(std::uint32_t crc, const unsigned char* data, std::size_t length)
+	{
+		return CRC32CModel::Update(crc, data, length);
+	}
+
+	/// 不支持硬件CRC32C的平台
+	static bool DetectCRC32CHardware()
+	{
+		return false;
+	}
+
+	#endif
+
+	/// 处理器是否支持CRC32C指令
+	bool CRCTool::IsCRC32CHardwareAvailable()
+	{
+		static const bool available = DetectCRC32CHardware();
+		return available;
+	}
+
+	/// 获取32位CRC32C校验和
+	std::uint32_t CRCTool::GetCRC32CCheckSum(const void *data, std::size_t length, std::uint32_t previous)
+	{
+		auto bytes = static_cast<const unsigned char*>(data);
+		std::uint32_t crc = ~previous;
+		if (IsCRC32CHardwareAvailable())
+		{
+			crc = UpdateCRC32CHardware(crc, bytes, length);
+		}
+		else
 		{
-			index = *data++;
-			initializer = ((unsigned short)(initializer) >> 8) ^
-			              CRC16Table[((unsigned short)(initializer) ^ (unsigned short)(index)) & 0x00ff];
+			crc = CRC32CModel::Update(crc, bytes, length);
 		}
-		return initializer;
+		return ~crc;
 	}
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 
 namespace RoboPioneers::SerialPort::Utilities
 {
@@ -8,7 +10,8 @@ namespace RoboPioneers::SerialPort::Utilities
 	 * @brief 冗余校验工具
 	 * @author Vincent
 	 * @details
-	 *  ~ 该静态工具类提供了8位和16位CRC冗余校验计算方法。
+	 *  ~ 该静态工具类提供了8位和16位CRC冗余校验计算方法，以及用于大块数据的32位CRC32C校验计算方法。
+	 *  ~ 校验表由CRCGenerator在编译期生成，并与原有的手工录入的表逐项核验；长数据按切片查表计算。
 	 */
 	class CRCTool
 	{
@@ -35,5 +38,22 @@ namespace RoboPioneers::SerialPort::Utilities
 		 */
 		static unsigned short GetCRC16CheckSum(unsigned char* data, unsigned int length,
 										 unsigned short initializer = 0xffff);
+
+		/**
+		 * @brief 处理器是否支持CRC32C指令
+		 * @retval true 支持，GetCRC32CCheckSum将使用硬件指令
+		 * @retval false 不支持，GetCRC32CCheckSum将使用切片查表
+		 */
+		static bool IsCRC32CHardwareAvailable();
+
+		/**
+		 * @brief 获取CRC32C校验码
+		 * @param data 数据指针
+		 * @param length 数据长度
+		 * @param previous 之前各段数据的校验码，用于分段计算，首段为0
+		 * @return 32位CRC32C校验码，包含最终异或
+		 * @details 处理器支持时使用SSE4.2或ARMv8 CRC扩展指令，否则使用切片查表。
+		 */
+		static std::uint32_t GetCRC32CCheckSum(const void* data, std::size_t length, std::uint32_t previous = 0);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,318 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "CRCTool.hpp"
+
+namespace RoboPioneers::SerialPort::Utilities
+{
+	/// 字节序
+	enum class Endianness
+	{
+		Little,
+		Big
+	};
+
+	/// 本机字节序
+	constexpr Endianness NativeEndianness =
+			#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+			Endianness::Big;
+			#else
+			Endianness::Little;
+			#endif
+
+	/**
+	 * @brief 数值字段
+	 * @tparam Type 字段类型，必须可平凡复制
+	 * @tparam Order 字段在数据包中的字节序
+	 * @details 数值字段的值在序列化时由调用者提供。
+	 */
+	template<typename Type, Endianness Order = Endianness::Little>
+	struct Field
+	{
+		static_assert(std::is_trivially_copyable_v<Type>, "Packet field type must be trivially copyable.");
+
+		/// 字段值类型
+		using ValueType = Type;
+		/// 字段字节序
+		static constexpr Endianness ByteOrder = Order;
+		/// 字段大小
+		static constexpr std::size_t Size = sizeof(Type);
+		/// 是否需要调用者提供值
+		static constexpr bool IsValue = true;
+		/// 是否为校验字段
+		static constexpr bool IsCheckSum = false;
+	};
+
+	/**
+	 * @brief 常量字段
+	 * @tparam Type 字段类型
+	 * @tparam Value 字段的固定值，如帧头
+	 * @tparam Order 字段在数据包中的字节序
+	 */
+	template<typename Type, Type Value, Endianness Order = Endianness::Little>
+	struct ConstantField
+	{
+		using ValueType = Type;
+		static constexpr Endianness ByteOrder = Order;
+		static constexpr std::size_t Size = sizeof(Type);
+		static constexpr bool IsValue = false;
+		static constexpr bool IsCheckSum = false;
+		/// 固定值
+		static constexpr Type Constant = Value;
+	};
+
+	/**
+	 * @brief 8位CRC校验字段
+	 * @details 校验范围为该字段之前的全部字节。
+	 */
+	struct CRC8Field
+	{
+		using ValueType = unsigned char;
+		static constexpr Endianness ByteOrder = Endianness::Little;
+		static constexpr std::size_t Size = sizeof(ValueType);
+		static constexpr bool IsValue = false;
+		static constexpr bool IsCheckSum = true;
+
+		/// 计算校验码
+		static ValueType Calculate(const unsigned char* data, std::size_t length)
+		{
+			return CRCTool::GetCRC8CheckSum(const_cast<unsigned char*>(data), static_cast<unsigned int>(length));
+		}
+	};
+
+	/**
+	 * @brief 16位CRC校验字段
+	 * @tparam Order 校验码在数据包中的字节序
+	 * @details 校验范围为该字段之前的全部字节。
+	 */
+	template<Endianness Order = Endianness::Little>
+	struct CRC16Field
+	{
+		using ValueType = unsigned short;
+		static constexpr Endianness ByteOrder = Order;
+		static constexpr std::size_t Size = sizeof(ValueType);
+		static constexpr bool IsValue = false;
+		static constexpr bool IsCheckSum = true;
+
+		/// 计算校验码
+		static ValueType Calculate(const unsigned char* data, std::size_t length)
+		{
+			return CRCTool::GetCRC16CheckSum(const_cast<unsigned char*>(data), static_cast<unsigned int>(length));
+		}
+	};
+
+	/**
+	 * @brief 数据包结构
+	 * @tparam Fields 按顺序排列的字段
+	 * @author Vincent
+	 * @details
+	 *  ~ 字段的偏移量与数据包大小均在编译期计算，数据包不含填充字节。
+	 *  ~ 字段通过memcpy按声明的字节序读写，不依赖对齐，也不分配内存。
+	 *  ~ 校验字段覆盖其之前的全部字节，在序列化的最后一步计算。
+	 */
+	template<typename... Fields>
+	class PacketSchema
+	{
+	public:
+		/// 字段数量
+		static constexpr std::size_t FieldCount = sizeof...(Fields);
+		/// 数据包大小
+		static constexpr std::size_t Size = (Fields::Size + ... + 0);
+		/// 需要调用者提供值的字段数量
+		static constexpr std::size_t ValueCount = ((Fields::IsValue ? 1 : 0) + ... + 0);
+
+		/// 数据包缓冲区类型
+		using Buffer = std::array<unsigned char, Size>;
+
+		/// 指定索引处的字段类型
+		template<std::size_t Index>
+		using FieldAt = std::tuple_element_t<Index, std::tuple<Fields...>>;
+
+	private:
+		/// 计算各字段的偏移量
+		static constexpr std::array<std::size_t, FieldCount + 1> CalculateOffsets()
+		{
+			std::array<std::size_t, FieldCount + 1> offsets {};
+			constexpr std::array<std::size_t, FieldCount + 1> sizes {Fields::Size..., 0};
+			for (std::size_t index = 0; index < FieldCount; ++index)
+			{
+				offsets[index + 1] = offsets[index] + sizes[index];
+			}
+			return offsets;
+		}
+
+		/// 计算各字段在值参数列表中的位置，非数值字段的位置无意义
+		static constexpr std::array<std::size_t, FieldCount + 1> CalculateValueIndices()
+		{
+			std::array<std::size_t, FieldCount + 1> indices {};
+			constexpr std::array<bool, FieldCount + 1> is_value {Fields::IsValue..., false};
+			std::size_t count = 0;
+			for (std::size_t index = 0; index < FieldCount; ++index)
+			{
+				indices[index] = count;
+				if (is_value[index]) ++count;
+			}
+			return indices;
+		}
+
+		/// 各字段的偏移量
+		static constexpr auto Offsets = CalculateOffsets();
+		/// 各字段在值参数列表中的位置
+		static constexpr auto ValueIndices = CalculateValueIndices();
+
+		/// 按字节序写入原始值
+		template<typename Type, Endianness Order>
+		static void Store(unsigned char* destination, const Type& value) noexcept
+		{
+			std::array<unsigned char, sizeof(Type)> bytes {};
+			std::memcpy(bytes.data(), &value, sizeof(Type));
+			if constexpr (Order != NativeEndianness)
+			{
+				for (std::size_t index = 0; index < sizeof(Type) / 2; ++index)
+				{
+					std::swap(bytes[index], bytes[sizeof(Type) - 1 - index]);
+				}
+			}
+			std::memcpy(destination, bytes.data(), sizeof(Type));
+		}
+
+		/// 按字节序读取原始值
+		template<typename Type, Endianness Order>
+		static Type Load(const unsigned char* source) noexcept
+		{
+			std::array<unsigned char, sizeof(Type)> bytes {};
+			std::memcpy(bytes.data(), source, sizeof(Type));
+			if constexpr (Order != NativeEndianness)
+			{
+				for (std::size_t index = 0; index < sizeof(Type) / 2; ++index)
+				{
+					std::swap(bytes[index], bytes[sizeof(Type) - 1 - index]);
+				}
+			}
+			Type value;
+			std::memcpy(&value, bytes.data(), sizeof(Type));
+			return value;
+		}
+
+		/// 写入单个字段，校验字段跳过
+		template<std::size_t Index, typename ValueTuple>
+		static void StoreField(Buffer& buffer, const ValueTuple& values) noexcept
+		{
+			using FieldType = FieldAt<Index>;
+			if constexpr (FieldType::IsValue)
+			{
+				Store<typename FieldType::ValueType, FieldType::ByteOrder>(
+						buffer.data() + Offsets[Index],
+						static_cast<typename FieldType::ValueType>(std::get<ValueIndices[Index]>(values)));
+			}
+			else if constexpr (!FieldType::IsCheckSum)
+			{
+				Store<typename FieldType::ValueType, FieldType::ByteOrder>(
+						buffer.data() + Offsets[Index], FieldType::Constant);
+			}
+		}
+
+		/// 计算单个校验字段
+		template<std::size_t Index>
+		static void SealField(Buffer& buffer) noexcept
+		{
+			using FieldType = FieldAt<Index>;
+			if constexpr (FieldType::IsCheckSum)
+			{
+				Store<typename FieldType::ValueType, FieldType::ByteOrder>(
+						buffer.data() + Offsets[Index], FieldType::Calculate(buffer.data(), Offsets[Index]));
+			}
+		}
+
+		/// 校验单个字段，非校验字段恒为真
+		template<std::size_t Index>
+		static bool VerifyField(const Buffer& buffer) noexcept
+		{
+			using FieldType = FieldAt<Index>;
+			if constexpr (FieldType::IsCheckSum)
+			{
+				return Load<typename FieldType::ValueType, FieldType::ByteOrder>(buffer.data() + Offsets[Index]) ==
+				       FieldType::Calculate(buffer.data(), Offsets[Index]);
+			}
+			else if constexpr (!FieldType::IsValue)
+			{
+				return Load<typename FieldType::ValueType, FieldType::ByteOrder>(buffer.data() + Offsets[Index]) ==
+				       FieldType::Constant;
+			}
+			else
+			{
+				return true;
+			}
+		}
+
+		/// 按顺序写入全部字段后计算校验字段
+		template<typename ValueTuple, std::size_t... Indices>
+		static void SerializeAll(Buffer& buffer, const ValueTuple& values, std::index_sequence<Indices...>) noexcept
+		{
+			(StoreField<Indices>(buffer, values), ...);
+			(SealField<Indices>(buffer), ...);
+		}
+
+		/// 校验全部常量字段与校验字段
+		template<std::size_t... Indices>
+		static bool VerifyAll(const Buffer& buffer, std::index_sequence<Indices...>) noexcept
+		{
+			return (VerifyField<Indices>(buffer) && ...);
+		}
+
+	public:
+		/**
+		 * @brief 获取字段的偏移量
+		 * @tparam Index 字段索引
+		 * @return 字段首字节在数据包中的位置
+		 */
+		template<std::size_t Index>
+		static constexpr std::size_t OffsetOf()
+		{
+			static_assert(Index < FieldCount, "Packet field index out of range.");
+			return Offsets[Index];
+		}
+
+		/**
+		 * @brief 序列化数据包
+		 * @param buffer 数据包缓冲区
+		 * @param values 按顺序排列的数值字段的值，常量字段与校验字段不需要提供
+		 */
+		template<typename... Values>
+		static void Serialize(Buffer& buffer, const Values&... values) noexcept
+		{
+			static_assert(sizeof...(Values) == ValueCount, "Packet value count does not match the schema.");
+			SerializeAll(buffer, std::forward_as_tuple(values...), std::index_sequence_for<Fields...>());
+		}
+
+		/**
+		 * @brief 读取字段的值
+		 * @tparam Index 字段索引
+		 * @param buffer 数据包缓冲区
+		 * @return 字段的值
+		 */
+		template<std::size_t Index>
+		static typename FieldAt<Index>::ValueType Get(const Buffer& buffer) noexcept
+		{
+			using FieldType = FieldAt<Index>;
+			return Load<typename FieldType::ValueType, FieldType::ByteOrder>(buffer.data() + Offsets[Index]);
+		}
+
+		/**
+		 * @brief 校验数据包
+		 * @param buffer 数据包缓冲区
+		 * @retval true 常量字段与校验字段均正确
+		 * @retval false 数据包损坏
+		 */
+		static bool Verify(const Buffer& buffer) noexcept
+		{
+			return VerifyAll(buffer, std::index_sequence_for<Fields...>());
+		}
+	};
+}
@@ -0,0 +1,124 @@
+#include <FrameBus/PrometheusFrameBus.hpp>
+
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace RoboPioneers::Prometheus::FrameBusMonitor
+{
+	/// 监视选项
+	struct Options
+	{
+		/// 共享内存名称
+		std::string Name {FrameBus::DefaultBusName};
+		/// 报告周期
+		std::chrono::milliseconds ReportInterval {1000};
+		/// 轮询间隔
+		std::chrono::microseconds PollInterval {500};
+		/// 报告次数，为零则持续至发布者退出
+		unsigned long ReportCount {0};
+	};
+
+	/// 解析命令行
+	Options ParseOptions(int argc, char** argv)
+	{
+		Options options;
+		for (int index = 1; index < argc; ++index)
+		{
+			std::string argument = argv[index];
+			auto next = [&]() -> std::string {
+				if (index + 1 >= argc) throw std::runtime_error("Missing Value for " + argument);
+				return argv[++index];
+			};
+
+			if (argument == "--name") options.Name = next();
+			else if (argument == "--interval") options.ReportInterval = std::chrono::milliseconds(std::stol(next()));
+			else if (argument == "--poll") options.PollInterval = std::chrono::microseconds(std::stol(next()));
+			else if (argument == "--reports") options.ReportCount = std::stoul(next());
+			else throw std::runtime_error("Unknown Argument: " + argument);
+		}
+		if (options.ReportInterval.count() <= 0) throw std::runtime_error("Report Interval Must be Positive.");
+		return options;
+	}
+
+	/// 获取单调时钟的纳秒数，与发布者使用同一时钟
+	std::int64_t GetMonotonicTime()
+	{
+		timespec time {};
+		clock_gettime(CLOCK_MONOTONIC, &time);
+		return static_cast<std::int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+	}
+
+	/**
+	 * @brief 监视帧总线
+	 * @details
+	 *  ~ 作为帧总线读取端的示例，周期性地输出读取到的帧率、跳过的帧数、锁定比例，
+	 *    以及从采集至发布、从发布至读取完成的平均延迟。
+	 */
+	void Monitor(const Options& options)
+	{
+		FrameBus::FrameBusReader reader;
+		reader.Open(options.Name);
+		std::cout << "Attached to " << options.Name << ", Raw Capacity: "
+		          << reader.GetPlaneCapacity(FrameBus::RawPlane) << " Bytes, Mask Capacity: "
+		          << reader.GetPlaneCapacity(FrameBus::MaskPlane) << " Bytes." << std::endl;
+
+		FrameBus::FrameSample sample;
+		unsigned long reports = 0;
+		while (options.ReportCount == 0 || reports < options.ReportCount)
+		{
+			const auto report_begin = std::chrono::steady_clock::now();
+			const auto missed_begin = reader.GetMissedCount();
+			unsigned long frames = 0, found_frames = 0;
+			double pipeline_latency = 0.0, bus_latency = 0.0;
+
+			while (std::chrono::steady_clock::now() - report_begin < options.ReportInterval)
+			{
+				if (!reader.ReadLatest(sample))
+				{
+					std::this_thread::sleep_for(options.PollInterval);
+					continue;
+				}
+				++frames;
+				if (sample.Result.Target.Found) ++found_frames;
+				pipeline_latency += static_cast<double>(sample.Result.PublishTime - sample.Result.ReceiveTime);
+				bus_latency += static_cast<double>(GetMonotonicTime() - sample.Result.PublishTime);
+			}
+
+			const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - report_begin).count();
+			std::cout << std::fixed << std::setprecision(1)
+			          << "FPS: " << frames / seconds
+			          << " Missed: " << reader.GetMissedCount() - missed_begin
+			          << " Found: " << (frames ? 100.0 * found_frames / frames : 0.0) << "%"
+			          << " Capture-Publish: " << (frames ? pipeline_latency / frames / 1000.0 : 0.0) << "us"
+			          << " Publish-Read: " << (frames ? bus_latency / frames / 1000.0 : 0.0) << "us" << std::endl;
+			++reports;
+
+			if (frames == 0 && !reader.IsWriterAlive())
+			{
+				std::cout << "Publisher Exited." << std::endl;
+				break;
+			}
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	using namespace RoboPioneers::Prometheus::FrameBusMonitor;
+
+	try
+	{
+		Monitor(ParseOptions(argc, argv));
+	}
+	catch (const std::exception& error)
+	{
+		std::cerr << error.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
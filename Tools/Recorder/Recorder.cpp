@@ -0,0 +1,310 @@
+#include <FrameBus/PrometheusFrameBus.hpp>
+#include <Recording/PrometheusRecording.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RoboPioneers::Prometheus::Recorder
+{
+	/// 录制选项
+	struct Options
+	{
+		/// 帧总线的共享内存名称
+		std::string Name {FrameBus::DefaultBusName};
+		/// 数据集文件路径
+		std::string OutputPath;
+		/// 录制的帧数，为零则不限
+		unsigned long long FrameCount {0};
+		/// 录制时长，为零则不限
+		std::chrono::seconds Duration {0};
+		/// 编码使用的线程数
+		int Threads {2};
+		/// 等待编码的帧数上限
+		std::size_t QueueCapacity {16};
+		/// 载荷编码方式
+		Recording::CodecType Codec {Recording::CodecType::Bayer};
+		/// 轮询间隔
+		std::chrono::microseconds PollInterval {500};
+	};
+
+	/// 解析命令行
+	Options ParseOptions(int argc, char** argv)
+	{
+		Options options;
+		for (int index = 1; index < argc; ++index)
+		{
+			std::string argument = argv[index];
+			auto next = [&]() -> std::string {
+				if (index + 1 >= argc) throw std::runtime_error("Missing Value for " + argument);
+				return argv[++index];
+			};
+
+			if (argument == "--bus") options.Name = next();
+			else if (argument == "--output") options.OutputPath = next();
+			else if (argument == "--frames") options.FrameCount = std::stoull(next());
+			else if (argument == "--duration") options.Duration = std::chrono::seconds(std::stol(next()));
+			else if (argument == "--threads") options.Threads = std::stoi(next());
+			else if (argument == "--queue") options.QueueCapacity = std::stoul(next());
+			else if (argument == "--poll") options.PollInterval = std::chrono::microseconds(std::stol(next()));
+			else if (argument == "--raw") options.Codec = Recording::CodecType::Raw;
+			else throw std::runtime_error("Unknown Argument: " + argument);
+		}
+		if (options.OutputPath.empty()) throw std::runtime_error("Output Path is Required.");
+		if (options.Threads <= 0) throw std::runtime_error("Thread Count Must be Positive.");
+		if (options.QueueCapacity == 0) throw std::runtime_error("Queue Capacity Must be Positive.");
+		return options;
+	}
+
+	/// 是否收到中断信号
+	std::atomic_bool Interrupted {false};
+
+	/// 中断信号处理，只设置标志，由录制循环写入索引后退出
+	void OnInterrupt(int)
+	{
+		Interrupted = true;
+	}
+
+	/**
+	 * @brief 有界的帧队列
+	 * @author Vincent
+	 * @details
+	 *  ~ 持有固定数量的帧，读取线程取出空闲的帧填充后提交，编码线程按提交顺序取出，写入后归还。
+	 *  ~ 帧的缓冲区在首次填充后保持不变，稳态下不分配内存。
+	 */
+	class SampleQueue
+	{
+	protected:
+		/// 帧
+		std::vector<FrameBus::FrameSample> Samples;
+		/// 空闲的帧
+		std::vector<FrameBus::FrameSample*> FreeSamples;
+		/// 已提交的帧，为环形队列
+		std::vector<FrameBus::FrameSample*> ReadySamples;
+		/// 环形队列的起始位置
+		std::size_t ReadyBegin {0};
+		/// 环形队列中的帧数
+		std::size_t ReadyCount {0};
+		/// 是否已关闭
+		bool Closed {false};
+
+		/// 互斥锁
+		std::mutex Mutex;
+		/// 提交与关闭通知
+		std::condition_variable Condition;
+
+	public:
+		/// 构造并分配指定数量的帧
+		explicit SampleQueue(std::size_t capacity) : Samples(capacity), ReadySamples(capacity)
+		{
+			for (auto& sample : Samples)
+			{
+				FreeSamples.push_back(&sample);
+			}
+		}
+
+		/// 取出空闲的帧，没有空闲的帧时返回空指针，不等待
+		FrameBus::FrameSample* TryAcquire()
+		{
+			std::lock_guard lock(Mutex);
+			if (FreeSamples.empty()) return nullptr;
+			auto* sample = FreeSamples.back();
+			FreeSamples.pop_back();
+			return sample;
+		}
+
+		/// 归还帧
+		void Release(FrameBus::FrameSample* sample)
+		{
+			std::lock_guard lock(Mutex);
+			FreeSamples.push_back(sample);
+		}
+
+		/// 提交已填充的帧
+		void Submit(FrameBus::FrameSample* sample)
+		{
+			{
+				std::lock_guard lock(Mutex);
+				ReadySamples[(ReadyBegin + ReadyCount) % ReadySamples.size()] = sample;
+				++ReadyCount;
+			}
+			Condition.notify_one();
+		}
+
+		/// 关闭队列，已提交的帧仍可取出
+		void Close()
+		{
+			{
+				std::lock_guard lock(Mutex);
+				Closed = true;
+			}
+			Condition.notify_one();
+		}
+
+		/// 按提交顺序取出下一帧，队列为空时等待；队列已关闭且为空时返回空指针
+		FrameBus::FrameSample* WaitNext()
+		{
+			std::unique_lock lock(Mutex);
+			Condition.wait(lock, [this]{ return ReadyCount != 0 || Closed; });
+			if (ReadyCount == 0) return nullptr;
+
+			auto* sample = ReadySamples[ReadyBegin];
+			ReadyBegin = (ReadyBegin + 1) % ReadySamples.size();
+			--ReadyCount;
+			return sample;
+		}
+	};
+
+	/**
+	 * @brief 读取线程的主循环
+	 * @details
+	 *  ~ 以ReadNext按发布顺序读取，填充后提交到队列；队列已满时不读取，
+	 *    落后于发布者超过总线的槽数量的帧被覆盖后跳过，计入读取端的跳过帧数。
+	 *  ~ 达到帧数或时长、收到中断信号、发布者退出或stop被设置时关闭队列并返回。
+	 */
+	void ReadFrames(const Options& options, FrameBus::FrameBusReader& reader, SampleQueue& queue,
+	                const std::atomic_bool& stop)
+	{
+		const auto begin_time = std::chrono::steady_clock::now();
+		unsigned long long submitted_count = 0;
+		FrameBus::FrameSample* sample = nullptr;
+
+		while (!Interrupted && !stop)
+		{
+			if (options.FrameCount != 0 && submitted_count >= options.FrameCount) break;
+			if (options.Duration.count() != 0 && std::chrono::steady_clock::now() - begin_time >= options.Duration) break;
+
+			if (!sample)
+			{
+				sample = queue.TryAcquire();
+			}
+			if (!sample || !reader.ReadNext(*sample))
+			{
+				if (!reader.IsWriterAlive())
+				{
+					std::clog << "[Warning] Publisher Exited." << std::endl;
+					break;
+				}
+				std::this_thread::sleep_for(options.PollInterval);
+				continue;
+			}
+			if (sample->Planes[FrameBus::RawPlane].Size == 0) continue;
+
+			queue.Submit(sample);
+			sample = nullptr;
+			++submitted_count;
+		}
+
+		if (sample)
+		{
+			queue.Release(sample);
+		}
+		queue.Close();
+	}
+
+	/**
+	 * @brief 录制帧总线上的帧
+	 * @details
+	 *  ~ 作为帧总线的读取端运行，不影响控制器；原始图像以BayerCodec无损编码，
+	 *    发布时附带的处理结果（FrameResult）作为元数据一并写入，以便回放时对比。
+	 *  ~ 读取在独立的线程中按发布顺序进行，经有界队列交给当前线程编码与写入，
+	 *    编码期间发布的帧不会丢失；只有队列已满且落后于发布者超过总线的槽数量时才会跳过帧，跳过的帧数在结束时输出。
+	 */
+	void Record(const Options& options)
+	{
+		FrameBus::FrameBusReader reader;
+		reader.Open(options.Name);
+
+		Recording::BayerCodec codec(options.Threads);
+		Recording::DatasetWriter writer;
+		std::vector<unsigned char> payload;
+
+		const auto begin_time = std::chrono::steady_clock::now();
+		const auto missed_begin = reader.GetMissedCount();
+		unsigned long long raw_bytes = 0;
+
+		SampleQueue queue(options.QueueCapacity);
+		std::atomic_bool stop_reading {false};
+		std::thread reader_thread([&]{ ReadFrames(options, reader, queue, stop_reading); });
+
+		try
+		{
+			while (auto* sample = queue.WaitNext())
+			{
+				const auto& plane = sample->Planes[FrameBus::RawPlane];
+				const auto* picture = sample->PlaneData[FrameBus::RawPlane].data();
+
+				if (!writer.IsOpened())
+				{
+					writer.Open(options.OutputPath, plane.Width, plane.Height);
+					std::cout << "Recording " << plane.Width << "x" << plane.Height << " from " << options.Name
+					          << " to " << options.OutputPath << "." << std::endl;
+				}
+
+				Recording::FrameDescription description {};
+				description.FrameIndex = sample->Result.FrameIndex;
+				description.SensorFrameID = sample->Result.SensorFrameID;
+				description.SensorTimeStamp = sample->Result.SensorTimeStamp;
+				description.TimeStamp = sample->Result.ReceiveTime;
+				description.Codec = options.Codec;
+				description.Metadata = Recording::MetadataType::FrameResult;
+
+				if (options.Codec == Recording::CodecType::Bayer)
+				{
+					codec.Encode(picture, plane.Width, plane.Height, plane.Width, payload);
+					writer.Append(description, payload.data(), payload.size(), &sample->Result, sizeof(sample->Result));
+				}
+				else
+				{
+					writer.Append(description, picture, plane.Size, &sample->Result, sizeof(sample->Result));
+				}
+				raw_bytes += plane.Size;
+				queue.Release(sample);
+			}
+		}
+		catch (...)
+		{
+			// 读取线程可能正在等待空闲的帧，先令其退出再抛出
+			stop_reading = true;
+			reader_thread.join();
+			throw;
+		}
+		reader_thread.join();
+
+		const auto frame_count = writer.GetFrameCount();
+		writer.Close();
+
+		const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin_time).count();
+		std::cout << "Recorded " << frame_count << " Frames in " << seconds << "s, Missed "
+		          << reader.GetMissedCount() - missed_begin << " Frames, "
+		          << writer.GetSize() << " Bytes for " << raw_bytes << " Raw Bytes." << std::endl;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	using namespace RoboPioneers::Prometheus::Recorder;
+
+	try
+	{
+		auto options = ParseOptions(argc, argv);
+		std::signal(SIGINT, OnInterrupt);
+		std::signal(SIGTERM, OnInterrupt);
+		Record(options);
+	}
+	catch (const std::exception& error)
+	{
+		std::cerr << error.what() << std::endl
+		          << "Usage: PrometheusRecorder --output FILE [--bus NAME] [--frames N] [--duration SECONDS]"
+		             " [--threads N] [--queue N] [--poll MICROSECONDS] [--raw]" << std::endl;
+		return 1;
+	}
+	return 0;
+}
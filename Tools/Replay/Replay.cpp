@@ -0,0 +1,436 @@
+#include <System/CPUPipeline.hpp>
+#include <Simulation/PrometheusSimulation.hpp>
+#include <Recording/PrometheusRecording.hpp>
+#include <FrameBus/FrameBusLayout.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <chrono>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+namespace RoboPioneers::Prometheus::Replay
+{
+	/// 回放流水线，使用CPU颜色过滤，无需相机、串口与CUDA设备
+	using ReplayPipeline = CPUPipeline<Core::HookGroup<Core::StatisticsHook<>, Core::AllocationHook<>>>;
+
+	/// 未指定帧数时，合成场景与录制图像目录的回放帧数
+	constexpr unsigned long long DefaultFrameCount = 600;
+
+	/// 回放选项
+	struct Options
+	{
+		/// 回放的帧数，未指定时回放数据集中其余的全部帧，合成场景与录制图像目录则回放DefaultFrameCount帧
+		std::optional<unsigned long long> FrameCount;
+		/// 录制图像目录，为空则使用合成场景
+		std::string CorpusPath;
+		/// 录制的数据集文件，优先于录制图像目录
+		std::string DatasetPath;
+		/// 数据集中开始回放的帧号，配合帧数可将数据集分片并行回放
+		unsigned long long StartFrame {0};
+		/// 配置文件路径，格式与控制器使用的Settings.json一致
+		std::string SettingsPath;
+		/// 敌方颜色
+		std::string Color {"Blue"};
+		/// 合成场景的装甲板数量
+		int ArmorCount {4};
+		/// 合成场景的干扰灯条数量
+		int DistractorCount {16};
+		/// 是否逐帧输出堆分配统计
+		bool PrintAllocations {true};
+	};
+
+	/// 解析命令行
+	Options ParseOptions(int argc, char** argv)
+	{
+		Options options;
+		for (int index = 1; index < argc; ++index)
+		{
+			std::string argument = argv[index];
+			auto next = [&]() -> std::string {
+				if (index + 1 >= argc) throw std::runtime_error("Missing Value for " + argument);
+				return argv[++index];
+			};
+
+			if (argument == "--frames") options.FrameCount = std::stoull(next());
+			else if (argument == "--corpus") options.CorpusPath = next();
+			else if (argument == "--dataset") options.DatasetPath = next();
+			else if (argument == "--start") options.StartFrame = std::stoull(next());
+			else if (argument == "--settings") options.SettingsPath = next();
+			else if (argument == "--color") options.Color = next();
+			else if (argument == "--armors") options.ArmorCount = std::stoi(next());
+			else if (argument == "--distractors") options.DistractorCount = std::stoi(next());
+			else if (argument == "--quiet") options.PrintAllocations = false;
+			else throw std::runtime_error("Unknown Argument: " + argument);
+		}
+		return options;
+	}
+
+	/// 按照控制器的格式加载配置，未指定配置文件时使用与合成场景相匹配的默认值
+	void LoadSettings(ReplayPipeline& pipeline, const Options& options)
+	{
+		auto& color_stage = pipeline.Get<Core::CPUColorFilter>();
+		auto& light_bar_stage = pipeline.Get<Core::LightBarDetector>();
+
+		if (options.SettingsPath.empty())
+		{
+			color_stage.MinHue = 90;
+			color_stage.MaxHue = 130;
+			color_stage.MinSaturation = 80;
+			color_stage.MaxSaturation = 255;
+			color_stage.MinValue = 120;
+			color_stage.MaxValue = 255;
+			light_bar_stage.MinArea = 20;
+			light_bar_stage.MinFillingRatio = 50;
+			return;
+		}
+
+		boost::property_tree::ptree json_node;
+		boost::property_tree::read_json(options.SettingsPath, json_node);
+
+		const auto mask = "Mask." + options.Color;
+		color_stage.MinHue = json_node.get<int>(mask + ".Hue.Min");
+		color_stage.MaxHue = json_node.get<int>(mask + ".Hue.Max");
+		color_stage.MinSaturation = json_node.get<int>(mask + ".Saturation.Min");
+		color_stage.MaxSaturation = json_node.get<int>(mask + ".Saturation.Max");
+		color_stage.MinValue = json_node.get<int>(mask + ".Value.Min");
+		color_stage.MaxValue = json_node.get<int>(mask + ".Value.Max");
+
+		light_bar_stage.MinArea = json_node.get<int>("LightBar.MinArea");
+		light_bar_stage.MinFillingRatio = json_node.get<int>("LightBar.MinFillingRatio");
+
+		auto& armor_stage = pipeline.Get<Core::ArmorMatcher>();
+		armor_stage.MaxAngleDifference = json_node.get<int>("LightBar.MaxAngleDifference");
+		armor_stage.MaxDeltaYHeightRatio = json_node.get<int>("LightBar.DeltaYHeightRatio.Max");
+		armor_stage.MinHeightDistanceRatioBigArmor = json_node.get<int>("BigArmor.HeightDistanceRatio.Min");
+		armor_stage.MaxHeightDistanceRatioBigArmor = json_node.get<int>("BigArmor.HeightDistanceRatio.Max");
+		armor_stage.MinWidthDistanceRatioBigArmor = json_node.get<int>("BigArmor.WidthDistanceRatio.Min");
+		armor_stage.MaxWidthDistanceRatioBigArmor = json_node.get<int>("BigArmor.WidthDistanceRatio.Max");
+		armor_stage.MinHeightDistanceRatioSmallArmor = json_node.get<int>("SmallArmor.HeightDistanceRatio.Min");
+		armor_stage.MaxHeightDistanceRatioSmallArmor = json_node.get<int>("SmallArmor.HeightDistanceRatio.Max");
+		armor_stage.MinWidthDistanceRatioSmallArmor = json_node.get<int>("SmallArmor.WidthDistanceRatio.Min");
+		armor_stage.MaxWidthDistanceRatioSmallArmor = json_node.get<int>("SmallArmor.WidthDistanceRatio.Max");
+	}
+
+	/// 加载录制的图像，统一转换为BayerBG原始图像
+	std::vector<cv::Mat> LoadCorpus(const std::string& corpus_path)
+	{
+		std::vector<boost::filesystem::path> paths;
+		for (const auto& entry : boost::filesystem::directory_iterator(corpus_path))
+		{
+			auto extension = entry.path().extension().string();
+			if (extension == ".png" || extension == ".bmp" || extension == ".jpg" || extension == ".tiff")
+			{
+				paths.push_back(entry.path());
+			}
+		}
+		std::sort(paths.begin(), paths.end());
+
+		std::vector<cv::Mat> pictures;
+		for (const auto& path : paths)
+		{
+			auto picture = cv::imread(path.string(), cv::IMREAD_UNCHANGED);
+			if (picture.empty()) continue;
+
+			if (picture.channels() == 3)
+			{
+				cv::Mat bayer_picture;
+				Simulation::SceneGenerator::Mosaic(picture, bayer_picture);
+				picture = bayer_picture;
+			}
+			pictures.push_back(picture);
+		}
+		if (pictures.empty())
+		{
+			throw std::runtime_error("No Picture Found in Corpus: " + corpus_path);
+		}
+		return pictures;
+	}
+
+	/**
+	 * @brief 数据集数据源
+	 * @details
+	 *  ~ 映射数据集文件后按帧号直接定位，BayerCodec编码的帧解码至复用的缓冲区，原始帧直接使用映射区域。
+	 *  ~ 录制时附带处理结果的帧，与回放的结果对比是否找到目标，以便发现参数或代码变更引起的差异。
+	 */
+	class DatasetSource
+	{
+	protected:
+		/// 读取器
+		Recording::DatasetReader Reader;
+		/// 解码器
+		Recording::BayerCodec Codec;
+		/// 解码缓冲区
+		std::vector<unsigned char> Buffer;
+
+	public:
+		/// 录制时的处理结果，当前帧没有时为空
+		const FrameBus::FrameResult* RecordedResult {nullptr};
+
+		/// 打开数据集
+		explicit DatasetSource(const std::string& path)
+		{
+			Reader.Open(path);
+			if (Reader.IsRecovered())
+			{
+				std::clog << "[Warning] Dataset " << path << " was not closed, "
+					<< Reader.GetFrameCount() << " frames are recovered by scanning." << std::endl;
+			}
+		}
+
+		/// 获取帧数
+		[[nodiscard]] std::size_t GetFrameCount() const noexcept
+		{
+			return Reader.GetFrameCount();
+		}
+
+		/// 获取图像尺寸
+		[[nodiscard]] cv::Size GetSize() const noexcept
+		{
+			return {static_cast<int>(Reader.GetWidth()), static_cast<int>(Reader.GetHeight())};
+		}
+
+		/**
+		 * @brief 读取一帧
+		 * @param frame_number 帧号
+		 * @param sensor_frame_id 录制时相机给出的帧号
+		 * @return 原始图像，在读取下一帧前有效
+		 */
+		cv::Mat Read(std::size_t frame_number, unsigned long long& sensor_frame_id)
+		{
+			auto frame = Reader.GetFrame(frame_number);
+			sensor_frame_id = frame.Description->SensorFrameID;
+			RecordedResult = frame.Description->Metadata == Recording::MetadataType::FrameResult &&
+				frame.MetadataSize == sizeof(FrameBus::FrameResult) ?
+				reinterpret_cast<const FrameBus::FrameResult*>(frame.Metadata) : nullptr;
+
+			switch (frame.Description->Codec)
+			{
+				case Recording::CodecType::Raw:
+					if (frame.PayloadSize != static_cast<std::size_t>(GetSize().area()))
+					{
+						throw std::runtime_error("Corrupted Raw Frame in Dataset: " + std::to_string(frame_number));
+					}
+					return cv::Mat(GetSize(), CV_8UC1, const_cast<unsigned char*>(frame.Payload));
+				case Recording::CodecType::Bayer:
+				{
+					std::uint32_t width = 0, height = 0;
+					Codec.Decode(frame.Payload, frame.PayloadSize, Buffer, width, height);
+					// 帧池按文件头的尺寸预分配，尺寸不一致的帧与原始图像一样视为损坏
+					if (width != Reader.GetWidth() || height != Reader.GetHeight())
+					{
+						throw std::runtime_error("Corrupted Bayer Frame in Dataset: " + std::to_string(frame_number));
+					}
+					return cv::Mat(GetSize(), CV_8UC1, Buffer.data());
+				}
+			}
+			throw std::runtime_error("Unknown Codec in Dataset: " + std::to_string(frame_number));
+		}
+	};
+
+	/// 输出一帧中各阶段的堆分配统计
+	void PrintAllocations(unsigned long long frame_index, const Core::AllocationAccounting::Snapshot& allocations)
+	{
+		std::clog << "[Allocation] Frame " << frame_index;
+		for (std::size_t slot = 0; slot < Core::AllocationAccounting::SlotCount; ++slot)
+		{
+			const auto& stage = allocations[slot];
+			if (stage.Count == 0) continue;
+
+			const char* name = slot == Core::AllocationAccounting::UnattributedSlot ? "Other" :
+				Core::StageStatistics::GetName(static_cast<Core::StageIdentifier>(slot));
+			std::clog << " " << name << ":" << stage.Count << "/" << stage.Bytes << "B/peak " << stage.Peak << "B";
+		}
+		std::clog << std::endl;
+	}
+
+	/// 输出各阶段的延迟统计
+	void PrintStatistics(Core::StageStatistics& statistics, double elapsed_seconds, unsigned long long frame_count)
+	{
+		std::clog << std::fixed << std::setprecision(1)
+			<< "[Replay] Frames: " << frame_count << " FPS: " << static_cast<double>(frame_count) / elapsed_seconds
+			<< std::endl;
+
+		auto snapshot = statistics.TakeSnapshot();
+		for (std::size_t index = 0; index < Core::StageStatistics::StageCount; ++index)
+		{
+			const auto& stage = snapshot[index];
+			if (stage.Count == 0) continue;
+
+			std::clog << "  " << std::left << std::setw(12)
+				<< Core::StageStatistics::GetName(static_cast<Core::StageIdentifier>(index)) << std::right
+				<< " p50:" << std::setw(8) << stage.P50 / 1000.0
+				<< " p90:" << std::setw(8) << stage.P90 / 1000.0
+				<< " p99:" << std::setw(8) << stage.P99 / 1000.0
+				<< " max:" << std::setw(8) << stage.Max / 1000.0 << " us" << std::endl;
+		}
+	}
+}
+
+/**
+ * @brief 回放入口
+ * @details
+ *  ~ 在录制的数据集、录制图像或合成场景上运行CPU流水线，无需任何硬件。
+ *  ~ 使用PROMETHEUS_ALLOCATION_ACCOUNTING选项构建时，将逐帧输出各阶段的堆分配次数、字节数与峰值。
+ */
+int main(int argc, char** argv)
+{
+	using namespace RoboPioneers::Prometheus;
+	using namespace RoboPioneers::Prometheus::Replay;
+
+	Options options;
+	try
+	{
+		options = ParseOptions(argc, argv);
+	}
+	catch (std::exception& error)
+	{
+		std::cerr << "[Error] " << error.what() << std::endl
+			<< "Usage: PrometheusReplay [--frames N] [--corpus DIR] [--dataset FILE] [--start N]"
+			   " [--settings Settings.json] [--color Red|Blue] [--armors N] [--distractors N] [--quiet]" << std::endl;
+		return 1;
+	}
+
+	//==============================
+	// 数据源
+	//==============================
+
+	std::vector<cv::Mat> corpus;
+	std::unique_ptr<Simulation::SceneStream> stream;
+	std::unique_ptr<DatasetSource> dataset;
+	cv::Size picture_size;
+
+	if (!options.DatasetPath.empty())
+	{
+		dataset = std::make_unique<DatasetSource>(options.DatasetPath);
+		if (options.StartFrame >= dataset->GetFrameCount())
+		{
+			std::cerr << "[Error] Start Frame " << options.StartFrame << " is beyond "
+				<< dataset->GetFrameCount() << " Frames in Dataset." << std::endl;
+			return 1;
+		}
+		const unsigned long long remaining_frames = dataset->GetFrameCount() - options.StartFrame;
+		options.FrameCount = std::min(options.FrameCount.value_or(remaining_frames), remaining_frames);
+		picture_size = dataset->GetSize();
+	}
+	else if (!options.CorpusPath.empty())
+	{
+		corpus = LoadCorpus(options.CorpusPath);
+		picture_size = corpus.front().size();
+		options.FrameCount = options.FrameCount.value_or(DefaultFrameCount);
+	}
+	else
+	{
+		picture_size = cv::Size(1280, 1024);
+		stream = std::make_unique<Simulation::SceneStream>(Simulation::SceneGenerator::MakeRandomDescription(
+				picture_size, options.ArmorCount, 0.25, options.DistractorCount, 32, 0));
+		options.FrameCount = options.FrameCount.value_or(DefaultFrameCount);
+	}
+	const auto frame_count = *options.FrameCount;
+
+	//==============================
+	// 流水线
+	//==============================
+
+	ReplayPipeline pipeline;
+	LoadSettings(pipeline, options);
+	pipeline.Get<Core::ArmorSelector>().ScreenWidth = picture_size.width;
+	pipeline.Get<Core::ArmorSelector>().ScreenHeight = picture_size.height;
+	pipeline.Get<Core::CPUColorFilter>().Reserve(picture_size);
+
+	Core::StageStatistics statistics;
+	{
+		using Core::StageIdentifier;
+		auto& statistics_hook = pipeline.Hooks.Get<Core::StatisticsHook<>>();
+		auto& allocation_hook = pipeline.Hooks.Get<Core::AllocationHook<>>();
+
+		auto bind = [&](std::size_t stage_index, StageIdentifier stage){
+			statistics_hook.Bind(stage_index, &statistics[stage]);
+			allocation_hook.Bind(stage_index, stage);
+		};
+
+		bind(ReplayPipeline::IndexOf<Core::BayerConverter>(), StageIdentifier::Debayer);
+		bind(ReplayPipeline::IndexOf<CuttingChooser>(), StageIdentifier::Cut);
+		bind(ReplayPipeline::IndexOf<Core::CPUColorFilter>(), StageIdentifier::Color);
+		bind(ReplayPipeline::IndexOf<Core::LightBarDetector>(), StageIdentifier::Detect);
+		bind(ReplayPipeline::IndexOf<Core::ArmorMatcher>(), StageIdentifier::Match);
+		bind(ReplayPipeline::IndexOf<Core::ArmorSelector>(), StageIdentifier::Select);
+	}
+
+	Core::FramePool<3> frames;
+	frames.Reserve(picture_size, false);
+
+	//==============================
+	// 回放
+	//==============================
+
+	unsigned long long recorded_frames = 0, mismatched_frames = 0;
+	auto begin_time = std::chrono::steady_clock::now();
+	for (unsigned long long index = 0; index < frame_count; ++index)
+	{
+		cv::Mat raw_picture;
+		unsigned long long sensor_frame_id = index + 1;
+		if (stream)
+		{
+			auto picture = stream->Next();
+			raw_picture = cv::Mat(cv::Size(picture.Width, picture.Height), CV_8UC1, picture.Data);
+			sensor_frame_id = picture.FrameID;
+		}
+		else if (dataset)
+		{
+			raw_picture = dataset->Read(options.StartFrame + index, sensor_frame_id);
+		}
+		else
+		{
+			raw_picture = corpus[index % corpus.size()];
+		}
+
+		auto& frame = frames.Acquire();
+		frame.RawPicture = raw_picture;
+		frame.SensorFrameID = sensor_frame_id;
+
+		// 数据源的分配不计入任何阶段，只比较流水线执行前后的差值
+		auto allocations_before = Core::AllocationAccounting::TakeSnapshot();
+		Core::AllocationAccounting::ResetPeaks();
+
+		pipeline.Execute(frame);
+
+		if (dataset && dataset->RecordedResult)
+		{
+			++recorded_frames;
+			if (frame.Target.Found != (dataset->RecordedResult->Target.Found != 0)) ++mismatched_frames;
+		}
+
+		if constexpr (Core::AllocationAccounting::IsAvailable())
+		{
+			if (options.PrintAllocations)
+			{
+				PrintAllocations(frame.Index, Core::AllocationAccounting::GetDifference(
+						Core::AllocationAccounting::TakeSnapshot(), allocations_before));
+			}
+		}
+	}
+	auto elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin_time).count();
+
+	PrintStatistics(statistics, elapsed_seconds, frame_count);
+	if (recorded_frames != 0)
+	{
+		std::clog << "[Replay] Target Found differs from recording in " << mismatched_frames << " of "
+			<< recorded_frames << " Frames." << std::endl;
+	}
+	if (!Core::AllocationAccounting::IsAvailable())
+	{
+		std::clog << "[Replay] Heap allocation accounting is disabled, "
+			"configure with -DPROMETHEUS_ALLOCATION_ACCOUNTING=ON to enable it." << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,397 @@
+#include "SimulatedMCU.hpp"
+
+#include <SerialPort/SerialPort.hpp>
+#include <System/Protocol/ResultPacketSchema.hpp>
+#include <System/Protocol/ClockSynchronizer.hpp>
+
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RoboPioneers::Prometheus::SerialSimulator
+{
+	/// 上位机写入方式
+	enum class WriteMode
+	{
+		/// 同步写入，调用线程阻塞至数据写入完成
+		Blocking,
+		/// 异步顺序写入
+		Queued,
+		/// 异步合并写入
+		Coalescing
+	};
+
+	/// 获取写入方式的名称
+	const char* GetName(WriteMode mode)
+	{
+		switch (mode)
+		{
+			case WriteMode::Blocking:
+				return "Blocking";
+			case WriteMode::Queued:
+				return "Queued";
+			case WriteMode::Coalescing:
+				return "Coalescing";
+		}
+		return "Unknown";
+	}
+
+	/// 模拟选项
+	struct Options
+	{
+		/// 每种配置发送的结果数据包数
+		unsigned long PacketCount {2000};
+		/// 发送频率，单位为赫兹
+		double Rate {400.0};
+		/// 测试的波特率
+		std::vector<unsigned int> BaudRates {115200, 460800, 921600};
+		/// 测试的写入方式
+		std::vector<WriteMode> Modes {WriteMode::Blocking, WriteMode::Queued, WriteMode::Coalescing};
+		/// 噪声注入概率
+		double NoiseProbability {0.05};
+		/// 不完整帧注入概率
+		double PartialFrameProbability {0.05};
+		/// 随机数种子
+		unsigned int Seed {1};
+		/// 模拟下位机的时钟偏移，单位为微秒
+		long long ClockOffset {123'456'789};
+	};
+
+	/// 单种配置的结果
+	struct RunResult
+	{
+		WriteMode Mode {WriteMode::Blocking};
+		unsigned int BaudRate {0};
+		bool HandshakeSucceeded {false};
+		/// 上位机提交的数据包数
+		unsigned long SentPackets {0};
+		/// 模拟下位机收到的有效数据包数
+		std::uint64_t ReceivedPackets {0};
+		/// 模拟下位机的校验失败数
+		std::uint64_t MCUCheckSumErrors {0};
+		/// 上位机收到的有效回显数
+		std::uint64_t Echoes {0};
+		/// 上位机的校验失败数
+		std::uint64_t HostCheckSumErrors {0};
+		/// 上位机发送单个数据包的平均耗时，单位为微秒
+		double AverageSendTime {0.0};
+		/// 往返延迟，单位为微秒
+		std::vector<double> RoundTripTimes;
+		/// 模拟下位机收到的吞吐量，单位为字节每秒
+		double Throughput {0.0};
+		/// 是否完成了时钟同步，同步写入方式下不进行时钟同步
+		bool ClockSynchronized {false};
+		/// 时钟偏移估计的误差，单位为微秒
+		double SyncError {0.0};
+		/// 结果到达下位机时的时龄，单位为微秒
+		std::vector<double> ResultAges;
+	};
+
+	/// 解析以逗号分隔的列表
+	template<typename Element, typename Parser>
+	std::vector<Element> ParseList(const std::string& text, Parser parser)
+	{
+		std::vector<Element> elements;
+		std::stringstream stream(text);
+		std::string item;
+		while (std::getline(stream, item, ','))
+		{
+			if (!item.empty()) elements.push_back(parser(item));
+		}
+		return elements;
+	}
+
+	/// 解析命令行
+	Options ParseOptions(int argc, char** argv)
+	{
+		Options options;
+		for (int index = 1; index < argc; ++index)
+		{
+			std::string argument = argv[index];
+			auto next = [&]() -> std::string {
+				if (index + 1 >= argc) throw std::runtime_error("Missing Value for " + argument);
+				return argv[++index];
+			};
+
+			if (argument == "--packets") options.PacketCount = std::stoul(next());
+			else if (argument == "--rate") options.Rate = std::stod(next());
+			else if (argument == "--baud") options.BaudRates = ParseList<unsigned int>(next(), [](const std::string& item){
+				return static_cast<unsigned int>(std::stoul(item));
+			});
+			else if (argument == "--modes") options.Modes = ParseList<WriteMode>(next(), [](const std::string& item){
+				if (item == "Blocking") return WriteMode::Blocking;
+				if (item == "Queued") return WriteMode::Queued;
+				if (item == "Coalescing") return WriteMode::Coalescing;
+				throw std::runtime_error("Unknown Write Mode: " + item);
+			});
+			else if (argument == "--noise") options.NoiseProbability = std::stod(next());
+			else if (argument == "--partial") options.PartialFrameProbability = std::stod(next());
+			else if (argument == "--seed") options.Seed = static_cast<unsigned int>(std::stoul(next()));
+			else if (argument == "--clock-offset") options.ClockOffset = std::stoll(next());
+			else throw std::runtime_error("Unknown Argument: " + argument);
+		}
+		if (options.Rate <= 0.0) throw std::runtime_error("Rate Must be Positive.");
+		return options;
+	}
+
+	/// 执行与Controller::Launch相同的颜色码握手
+	bool Handshake(SerialPort::Port& port)
+	{
+		std::array<unsigned char, 64> team_data {};
+		unsigned long team_data_size = 0;
+		while (team_data_size == 0 || team_data[0] == 0)
+		{
+			team_data_size = port.ReadTo(team_data.data(), team_data.size());
+		}
+
+		std::array<unsigned char, 3> response {0xFF, static_cast<unsigned char>(team_data[0] <= 9 ? 1 : 2), 0xFF};
+		port.Write(response.data(), response.size());
+		return true;
+	}
+
+	/// 在一对伪终端上运行单种配置
+	RunResult RunConfiguration(WriteMode mode, unsigned int baud_rate, const Options& options)
+	{
+		RunResult result;
+		result.Mode = mode;
+		result.BaudRate = baud_rate;
+
+		int master = -1, slave = -1;
+		std::array<char, 256> slave_name {};
+		termios settings {};
+		cfmakeraw(&settings);
+		if (::openpty(&master, &slave, slave_name.data(), &settings, nullptr) != 0)
+		{
+			throw std::runtime_error("[RunConfiguration] Failed to Open Pseudo Terminal.");
+		}
+
+		MCUOptions mcu_options;
+		mcu_options.BaudRate = baud_rate;
+		mcu_options.NoiseProbability = options.NoiseProbability;
+		mcu_options.PartialFrameProbability = options.PartialFrameProbability;
+		mcu_options.Seed = options.Seed;
+		mcu_options.ClockOffset = options.ClockOffset;
+		SimulatedMCU mcu(master, mcu_options);
+		mcu.Start();
+
+		SerialPort::Port port(slave_name.data(), baud_rate);
+		port.Open();
+		Handshake(port);
+
+		// 时间同步请求经由异步写入的不可合并通道发送，同步写入方式下无法与之共存，故不进行时钟同步
+		ClockSynchronizer synchronizer(port);
+		synchronizer.SetInterval(std::chrono::milliseconds(50));
+		if (mode != WriteMode::Blocking)
+		{
+			port.StartAsyncWriter(mode == WriteMode::Queued ?
+					SerialPort::Port::AsyncWriteMode::Queued : SerialPort::Port::AsyncWriteMode::Coalescing);
+			synchronizer.Start(false);
+		}
+
+		// 帧号只有16位，按帧号记录发送时刻
+		std::vector<std::atomic<long long>> send_times(1u << 16u);
+		result.RoundTripTimes.reserve(options.PacketCount);
+
+		SerialPort::FrameReceiver echo_receiver(nullptr, {0xA5, EchoPacketSchema::Size, SerialPort::FrameCheckSum::CRC8});
+		echo_receiver.SetCallback([&](const unsigned char* data, std::size_t size){
+			auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+			EchoPacketSchema::Buffer echo;
+			std::copy(data, data + size, echo.begin());
+			auto sent = send_times[EchoPacketSchema::Get<1>(echo)].load(std::memory_order_acquire);
+			if (sent != 0)
+			{
+				result.RoundTripTimes.push_back(static_cast<double>(now - sent) / 1000.0);
+			}
+		});
+		// 回显与时间同步应答共用线路，读取到的数据同时交给两者
+		auto feed = [&](const unsigned char* data, std::size_t size){
+			echo_receiver.Feed(data, size);
+			synchronizer.Feed(data, size);
+		};
+		// 同步读取线程，主设备关闭后读取将出错，线程随之退出；异步写入期间不得与输入输出线程同时操作串口
+		std::thread receiver_thread;
+		auto start_receiver_thread = [&]{
+			receiver_thread = std::thread([&]{
+				std::array<unsigned char, 256> buffer {};
+				try
+				{
+					while (true)
+					{
+						auto size = port.ReadTo(buffer.data(), buffer.size());
+						feed(buffer.data(), size);
+					}
+				}
+				catch (const std::exception&)
+				{}
+			});
+		};
+		if (mode == WriteMode::Blocking)
+		{
+			start_receiver_thread();
+		}
+		else
+		{
+			port.StartAsyncReader(feed);
+		}
+
+		// 发送结果之前等待首次同步完成
+		auto synchronize_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+		while (mode != WriteMode::Blocking && !synchronizer.IsSynchronized() &&
+		       std::chrono::steady_clock::now() < synchronize_deadline)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+
+		auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+				std::chrono::duration<double>(1.0 / options.Rate));
+		auto begin_time = std::chrono::steady_clock::now();
+		std::chrono::steady_clock::duration send_time {0};
+
+		for (unsigned long index = 0; index < options.PacketCount; ++index)
+		{
+			std::this_thread::sleep_until(begin_time + period * index);
+
+			ResultPacketSchema::Buffer packet;
+			ResultPacketSchema::Serialize(packet, static_cast<unsigned char>(1), static_cast<unsigned short>(640),
+			                              static_cast<unsigned short>(512), static_cast<unsigned short>(300),
+			                              static_cast<unsigned short>(index),
+			                              synchronizer.ToMCUTime(std::chrono::steady_clock::now()));
+
+			auto send_begin = std::chrono::steady_clock::now();
+			send_times[index & 0xFFFFu].store(send_begin.time_since_epoch().count(), std::memory_order_release);
+			if (mode == WriteMode::Blocking)
+			{
+				port.Write(packet.data(), packet.size());
+			}
+			else
+			{
+				port.WriteAsync(packet.data(), packet.size());
+			}
+			send_time += std::chrono::steady_clock::now() - send_begin;
+		}
+
+		synchronizer.Stop();
+		port.StopAsyncWriter();
+		auto end_time = std::chrono::steady_clock::now();
+		// 异步读取随异步写入一同停止，剩余的回显改由同步读取线程接收
+		if (mode != WriteMode::Blocking)
+		{
+			start_receiver_thread();
+		}
+		// 等待下位机消费完缓冲区中的数据并回显
+		std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+		mcu.Stop();
+		::close(master);
+		receiver_thread.join();
+		port.Close();
+		::close(slave);
+
+		result.HandshakeSucceeded = mcu.HandshakeSucceeded;
+		result.ClockSynchronized = synchronizer.IsSynchronized();
+		if (result.ClockSynchronized)
+		{
+			// 下位机时间为32位微秒计数，在回绕意义下比较估计值与真实偏移
+			auto estimate = std::chrono::duration_cast<std::chrono::microseconds>(synchronizer.GetOffset()).count();
+			result.SyncError = static_cast<double>(static_cast<std::int32_t>(
+					static_cast<std::uint32_t>(estimate) - static_cast<std::uint32_t>(options.ClockOffset)));
+		}
+		result.ResultAges = mcu.ResultAges;
+		result.SentPackets = options.PacketCount;
+		result.ReceivedPackets = mcu.ReceivedPackets;
+		result.MCUCheckSumErrors = mcu.GetCheckSumErrorCount();
+		result.Echoes = echo_receiver.GetFrameCount();
+		result.HostCheckSumErrors = echo_receiver.GetCheckSumErrorCount();
+		result.AverageSendTime = std::chrono::duration<double, std::micro>(send_time).count() /
+		                         static_cast<double>(std::max<unsigned long>(options.PacketCount, 1));
+		result.Throughput = static_cast<double>(mcu.ReceivedBytes) /
+		                    std::chrono::duration<double>(end_time - begin_time).count();
+		return result;
+	}
+
+	/// 获取分位数
+	double GetPercentile(std::vector<double> samples, double ratio)
+	{
+		if (samples.empty()) return 0.0;
+		auto index = static_cast<std::size_t>(ratio * static_cast<double>(samples.size() - 1));
+		std::nth_element(samples.begin(), samples.begin() + static_cast<long>(index), samples.end());
+		return samples[index];
+	}
+
+	/// 输出结果表
+	void PrintResults(const std::vector<RunResult>& results)
+	{
+		std::cout << std::left << std::setw(12) << "Mode" << std::right
+		          << std::setw(9) << "Baud" << std::setw(8) << "Sent" << std::setw(8) << "MCU Rx"
+		          << std::setw(8) << "Echoes" << std::setw(9) << "CRC Err" << std::setw(11) << "Send(us)"
+		          << std::setw(11) << "RTT P50" << std::setw(11) << "RTT P99" << std::setw(11) << "RTT Max"
+		          << std::setw(12) << "Bytes/s" << std::setw(11) << "Sync Err" << std::setw(11) << "Age P50"
+		          << std::endl;
+
+		for (const auto& result : results)
+		{
+			if (!result.HandshakeSucceeded)
+			{
+				std::cout << std::left << std::setw(12) << GetName(result.Mode) << std::right
+				          << std::setw(9) << result.BaudRate << "  Handshake Failed" << std::endl;
+				continue;
+			}
+			std::cout << std::left << std::setw(12) << GetName(result.Mode) << std::right << std::fixed
+			          << std::setprecision(1)
+			          << std::setw(9) << result.BaudRate << std::setw(8) << result.SentPackets
+			          << std::setw(8) << result.ReceivedPackets << std::setw(8) << result.Echoes
+			          << std::setw(9) << (result.MCUCheckSumErrors + result.HostCheckSumErrors)
+			          << std::setw(11) << result.AverageSendTime
+			          << std::setw(11) << GetPercentile(result.RoundTripTimes, 0.5)
+			          << std::setw(11) << GetPercentile(result.RoundTripTimes, 0.99)
+			          << std::setw(11) << GetPercentile(result.RoundTripTimes, 1.0)
+			          << std::setw(12) << std::setprecision(0) << result.Throughput << std::setprecision(1);
+			if (result.ClockSynchronized)
+			{
+				std::cout << std::setw(11) << result.SyncError << std::setw(11) << GetPercentile(result.ResultAges, 0.5);
+			}
+			else
+			{
+				std::cout << std::setw(11) << "-" << std::setw(11) << "-";
+			}
+			std::cout << std::endl;
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	using namespace RoboPioneers::Prometheus::SerialSimulator;
+
+	try
+	{
+		auto options = ParseOptions(argc, argv);
+
+		std::vector<RunResult> results;
+		for (auto baud_rate : options.BaudRates)
+		{
+			for (auto mode : options.Modes)
+			{
+				results.push_back(RunConfiguration(mode, baud_rate, options));
+			}
+		}
+		PrintResults(results);
+	}
+	catch (const std::exception& error)
+	{
+		std::cerr << error.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
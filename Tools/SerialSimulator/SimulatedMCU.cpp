@@ -0,0 +1,186 @@
+#include "SimulatedMCU.hpp"
+
+#include <System/Protocol/ResultPacketSchema.hpp>
+#include <System/Protocol/TimeSyncPacketSchema.hpp>
+
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <array>
+#include <stdexcept>
+
+namespace RoboPioneers::Prometheus::SerialSimulator
+{
+	/// 构造函数
+	SimulatedMCU::SimulatedMCU(int device, MCUOptions options) :
+			Device(device), Options(options), Random(options.Seed),
+			Receiver(nullptr, {0xFF, ResultPacketSchema::Size, SerialPort::FrameCheckSum::CRC8}),
+			PingReceiver(nullptr, {0xFE, PingPacketSchema::Size, SerialPort::FrameCheckSum::CRC8})
+	{
+		Receiver.SetCallback([this](const unsigned char* data, std::size_t size){
+			ResultPacketSchema::Buffer packet;
+			std::copy(data, data + size, packet.begin());
+			++ReceivedPackets;
+
+			auto target_time = ResultPacketSchema::Get<6>(packet);
+			if (target_time != 0)
+			{
+				ResultAges.push_back(static_cast<double>(static_cast<std::int32_t>(GetMCUTime() - target_time)));
+			}
+			Echo(ResultPacketSchema::Get<5>(packet));
+		});
+		PingReceiver.SetCallback([this](const unsigned char* data, std::size_t size){
+			PingPacketSchema::Buffer packet;
+			std::copy(data, data + size, packet.begin());
+			Pong(PingPacketSchema::Get<1>(packet));
+		});
+	}
+
+	/// 获取下位机时间
+	std::uint32_t SimulatedMCU::GetMCUTime() const
+	{
+		auto host_time = std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count();
+		return static_cast<std::uint32_t>(host_time + Options.ClockOffset);
+	}
+
+	/// 析构
+	SimulatedMCU::~SimulatedMCU()
+	{
+		Stop();
+	}
+
+	/// 启动工作线程
+	void SimulatedMCU::Start()
+	{
+		if (Worker.joinable()) return;
+		Running = true;
+		Worker = std::thread([this]{ Run(); });
+	}
+
+	/// 停止工作线程
+	void SimulatedMCU::Stop()
+	{
+		Running = false;
+		if (Worker.joinable())
+		{
+			Worker.join();
+		}
+	}
+
+	/// 向主设备写入全部数据
+	void SimulatedMCU::WriteAll(const unsigned char *data, std::size_t size)
+	{
+		while (size > 0)
+		{
+			auto written = ::write(Device, data, size);
+			if (written < 0)
+			{
+				if (errno == EINTR || errno == EAGAIN) continue;
+				throw std::runtime_error("[SimulatedMCU::WriteAll] Failed to Write to Pseudo Terminal.");
+			}
+			data += written;
+			size -= static_cast<std::size_t>(written);
+		}
+	}
+
+	/// 执行颜色码握手
+	void SimulatedMCU::Handshake()
+	{
+		std::array<unsigned char, 3> expected {0xFF, static_cast<unsigned char>(
+				Options.ColorCode <= 9 ? 1 : 2), 0xFF};
+		std::array<unsigned char, 3> response {};
+		std::size_t response_size = 0;
+
+		// 每隔100毫秒发送一次颜色码，直到收到完整的应答
+		while (Running && response_size < response.size())
+		{
+			WriteAll(&Options.ColorCode, 1);
+
+			pollfd descriptor {Device, POLLIN, 0};
+			auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+			while (Running && response_size < response.size() && std::chrono::steady_clock::now() < deadline)
+			{
+				if (::poll(&descriptor, 1, 10) <= 0) continue;
+				auto size = ::read(Device, response.data() + response_size, response.size() - response_size);
+				if (size > 0) response_size += static_cast<std::size_t>(size);
+			}
+		}
+
+		HandshakeSucceeded = response == expected;
+	}
+
+	/// 回显帧号
+	void SimulatedMCU::Echo(unsigned short frame_id)
+	{
+		std::uniform_real_distribution<double> probability(0.0, 1.0);
+
+		if (probability(Random) < Options.NoiseProbability)
+		{
+			// 噪声中混入回显帧头，迫使接收端处理伪帧头
+			std::array<unsigned char, 8> noise {};
+			auto size = 1 + Random() % noise.size();
+			for (std::size_t index = 0; index < size; ++index)
+			{
+				noise[index] = Random() % 4 == 0 ? 0xA5 : static_cast<unsigned char>(Random());
+			}
+			WriteAll(noise.data(), size);
+			InjectedNoiseBytes += size;
+		}
+
+		if (probability(Random) < Options.PartialFrameProbability)
+		{
+			EchoPacketSchema::Buffer partial;
+			EchoPacketSchema::Serialize(partial, static_cast<unsigned short>(Random()));
+			WriteAll(partial.data(), 1 + Random() % (partial.size() - 1));
+			++InjectedPartialFrames;
+		}
+
+		EchoPacketSchema::Buffer echo;
+		EchoPacketSchema::Serialize(echo, frame_id);
+		WriteAll(echo.data(), echo.size());
+		++EchoedPackets;
+	}
+
+	/// 应答时间同步请求
+	void SimulatedMCU::Pong(unsigned short sequence)
+	{
+		PongPacketSchema::Buffer pong;
+		PongPacketSchema::Serialize(pong, sequence, GetMCUTime());
+		// 应答在线路上的传输时间决定了时钟同步的误差，故与接收一样按模拟的波特率延迟写入；
+		// 应答的频率很低，在工作线程中等待对结果数据包的消费几乎没有影响
+		std::this_thread::sleep_for(std::chrono::nanoseconds(
+				static_cast<long long>(pong.size()) * 10 * 1'000'000'000LL / Options.BaudRate));
+		WriteAll(pong.data(), pong.size());
+		++AnsweredPings;
+	}
+
+	/// 工作线程主循环
+	void SimulatedMCU::Run()
+	{
+		Handshake();
+		if (!HandshakeSucceeded) return;
+
+		std::array<unsigned char, 256> buffer {};
+		pollfd descriptor {Device, POLLIN, 0};
+		LineAvailableTime = std::chrono::steady_clock::now();
+
+		while (Running)
+		{
+			if (::poll(&descriptor, 1, 20) <= 0) continue;
+			auto size = ::read(Device, buffer.data(), buffer.size());
+			if (size <= 0) continue;
+
+			// 每个字节在线路上占用10个比特时间，按模拟的波特率延迟消费，以模拟线路传输
+			auto line_time = std::chrono::nanoseconds(
+					static_cast<long long>(size) * 10 * 1'000'000'000LL / Options.BaudRate);
+			LineAvailableTime = std::max(LineAvailableTime, std::chrono::steady_clock::now()) + line_time;
+			std::this_thread::sleep_until(LineAvailableTime);
+
+			ReceivedBytes += static_cast<std::uint64_t>(size);
+			// 结果数据包与时间同步请求共用线路，两个接收器各自从同一字节流中寻找自己的帧
+			Receiver.Feed(buffer.data(), static_cast<std::size_t>(size));
+			PingReceiver.Feed(buffer.data(), static_cast<std::size_t>(size));
+		}
+	}
+}
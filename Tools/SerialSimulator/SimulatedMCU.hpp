@@ -0,0 +1,134 @@
+#pragma once
+
+#include <SerialPort/FrameReceiver.hpp>
+#include <SerialPortUtilities/PacketSchema.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace RoboPioneers::Prometheus::SerialSimulator
+{
+	/**
+	 * @brief 回显数据包结构
+	 * @details 模拟下位机每收到一个结果数据包，便回显其帧号：帧头0xA5，帧号，8位CRC校验码。
+	 */
+	using EchoPacketSchema = SerialPort::Utilities::PacketSchema<
+			SerialPort::Utilities::ConstantField<unsigned char, 0xA5>,
+			SerialPort::Utilities::Field<unsigned short>,
+			SerialPort::Utilities::CRC8Field>;
+
+	/// 模拟下位机选项
+	struct MCUOptions
+	{
+		/// 握手时发送的颜色码，1~9为红方，其余非零值为蓝方
+		unsigned char ColorCode {7};
+		/// 模拟的波特率，下位机按照该速率消费字节，以模拟线路传输时间
+		unsigned int BaudRate {115200};
+		/// 每次回显前注入随机噪声字节的概率
+		double NoiseProbability {0.0};
+		/// 每次回显前注入不完整回显帧的概率
+		double PartialFrameProbability {0.0};
+		/// 随机数种子
+		unsigned int Seed {1};
+		/// 下位机时钟相对于主机单调时钟的偏移，单位为微秒
+		long long ClockOffset {123'456'789};
+	};
+
+	/**
+	 * @brief 模拟下位机
+	 * @author Vincent
+	 * @details
+	 *  ~ 在伪终端的主设备端运行，执行与Controller::Launch相同的颜色码握手，随后消费结果数据包并回显帧号。
+	 *  ~ 回显之间可注入噪声字节与不完整的帧，用于检验上位机接收端的重同步能力。
+	 *  ~ 下位机拥有以微秒为单位、带有固定偏移的32位时钟，立即应答时间同步请求，应答与请求一样经过模拟的线路传输时间，
+	 *    并根据结果数据包中的目标时刻计算结果到达时的时龄。
+	 */
+	class SimulatedMCU
+	{
+	protected:
+		/// 伪终端主设备的文件描述符
+		int Device;
+		/// 选项
+		MCUOptions Options;
+		/// 随机数生成器
+		std::mt19937 Random;
+		/// 结果数据包接收器
+		SerialPort::FrameReceiver Receiver;
+		/// 时间同步请求接收器
+		SerialPort::FrameReceiver PingReceiver;
+
+		/// 工作线程
+		std::thread Worker;
+		/// 是否运行
+		std::atomic_bool Running {false};
+
+		/// 按照模拟的波特率，下一批字节可以被消费的时刻
+		std::chrono::steady_clock::time_point LineAvailableTime;
+
+		/// 向主设备写入全部数据
+		void WriteAll(const unsigned char* data, std::size_t size);
+
+		/// 执行颜色码握手
+		void Handshake();
+
+		/// 回显帧号，按照选项注入噪声与不完整的帧
+		void Echo(unsigned short frame_id);
+
+		/// 应答时间同步请求
+		void Pong(unsigned short sequence);
+
+		/// 工作线程主循环
+		void Run();
+
+	public:
+		//==============================
+		// 统计部分，在Stop之后读取
+		//==============================
+
+		/// 握手是否成功
+		bool HandshakeSucceeded {false};
+		/// 收到的有效结果数据包数
+		std::uint64_t ReceivedPackets {0};
+		/// 收到的字节数
+		std::uint64_t ReceivedBytes {0};
+		/// 已回显的数据包数
+		std::uint64_t EchoedPackets {0};
+		/// 注入的噪声字节数
+		std::uint64_t InjectedNoiseBytes {0};
+		/// 注入的不完整帧数
+		std::uint64_t InjectedPartialFrames {0};
+		/// 已应答的时间同步请求数
+		std::uint64_t AnsweredPings {0};
+		/// 带有目标时刻的结果数据包到达时的时龄，单位为微秒
+		std::vector<double> ResultAges;
+
+		/**
+		 * @brief 构造函数
+		 * @param device 伪终端主设备的文件描述符，需已设置为原始模式
+		 * @param options 选项
+		 */
+		SimulatedMCU(int device, MCUOptions options);
+
+		/// 析构，若工作线程仍在运行则停止
+		~SimulatedMCU();
+
+		/// 启动工作线程
+		void Start();
+
+		/// 停止工作线程
+		void Stop();
+
+		/// 获取下位机时间，单位为微秒
+		[[nodiscard]] std::uint32_t GetMCUTime() const;
+
+		/// 获取结果数据包的校验失败数
+		[[nodiscard]] inline std::uint64_t GetCheckSumErrorCount() const
+		{
+			return Receiver.GetCheckSumErrorCount();
+		}
+	};
+}